@@ -1,224 +1,216 @@
 #include "EquityStats.h"
+#include "../TradeCalculator.h"
+#include "../Backtest/BacktestTrade.h"
 #include <algorithm>
-#include <numeric>
 #include <cmath>
 #include <sstream>
 #include <iomanip>
 
 namespace Analytics {
-    EquityAnalyzer::EquityAnalyzer() {}
+    DrawdownTracker::DrawdownTracker(double initialBalance) {
+        reset(initialBalance);
+    }
     
-    EquityStats EquityAnalyzer::calculateStats(const std::vector<std::shared_ptr<Trade>>& trades, 
-                                             double initialBalance) {
-        EquityStats stats;
-        stats.initialBalance = initialBalance;
-        stats.totalTrades = trades.size();
-        
-        if (trades.empty()) {
-            stats.finalBalance = initialBalance;
-            return stats;
+    void DrawdownTracker::reset(double initialBalance) {
+        m_peakBalance = initialBalance;
+        m_maxDrawdown = 0.0;
+        m_maxDrawdownPercent = 0.0;
+        m_drawdownDuration = 0;
+        m_maxDrawdownDuration = 0;
+    }
+    
+    double DrawdownTracker::update(double balance) {
+        // Update peak if we have a new high
+        if (balance > m_peakBalance) {
+            m_peakBalance = balance;
+            // Reset drawdown duration if we make a new high
+            m_drawdownDuration = 0;
+            return 0.0;
         }
         
-        // Generate equity curve for various calculations
-        std::vector<double> equityCurve = generateEquityCurve(trades, initialBalance);
-        stats.finalBalance = equityCurve.back();
-        stats.totalPnL = stats.finalBalance - initialBalance;
-        stats.percentGain = (initialBalance > 0) ? (stats.totalPnL / initialBalance * 100.0) : 0.0;
-        
-        // Count winning trades and calculate win rate
-        int winningTrades = 0;
-        double totalWins = 0.0;
-        double totalLosses = 0.0;
-        double maxWin = 0.0;
-        double maxLoss = 0.0;
+        // We're in a drawdown
+        m_drawdownDuration++;
+        double currentDrawdown = m_peakBalance - balance;
+        double drawdownPercent = (m_peakBalance > 0) ? (currentDrawdown / m_peakBalance * 100.0) : 0.0;
         
-        for (const auto& trade : trades) {
-            TradeOutcome outcome = trade->getOutcome();
-            
-            if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                winningTrades++;
-                double pnl = trade->getResults().rewardAmount;
-                totalWins += pnl;
-                maxWin = std::max(maxWin, pnl);
-            } else if (outcome == TradeOutcome::LossAtSL) {
-                double pnl = trade->getResults().riskAmount;
-                totalLosses += pnl;
-                maxLoss = std::max(maxLoss, pnl);
-            }
+        // Update max drawdown if current is larger
+        if (currentDrawdown > m_maxDrawdown) {
+            m_maxDrawdown = currentDrawdown;
+            m_maxDrawdownPercent = drawdownPercent;
         }
         
-        stats.winRate = (trades.size() > 0) ? (static_cast<double>(winningTrades) / trades.size() * 100.0) : 0.0;
-        stats.largestWin = maxWin;
-        stats.largestLoss = maxLoss;
-        stats.avgWin = (winningTrades > 0) ? (totalWins / winningTrades) : 0.0;
-        int losingTrades = trades.size() - winningTrades;
-        stats.avgLoss = (losingTrades > 0) ? (totalLosses / losingTrades) : 0.0;
-        
-        // Calculate average R-multiple (expectancy)
-        double totalRMultiple = 0.0;
-        for (const auto& trade : trades) {
-            TradeOutcome outcome = trade->getOutcome();
-            if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                totalRMultiple += trade->getResults().riskRewardRatio;
-            } else if (outcome == TradeOutcome::LossAtSL) {
-                totalRMultiple -= 1.0;  // -1R
-            }
-        }
-        stats.avgRMultiple = (trades.size() > 0) ? (totalRMultiple / trades.size()) : 0.0;
-        stats.expectancy = stats.avgRMultiple;
+        // Update max drawdown duration
+        m_maxDrawdownDuration = std::max(m_maxDrawdownDuration, m_drawdownDuration);
+        return drawdownPercent;
+    }
+    
+    void DrawdownTracker::apply(EquityStats& stats) const {
+        stats.maxDrawdown = m_maxDrawdown;
+        stats.maxDrawdownPercent = m_maxDrawdownPercent;
+        stats.drawdownDuration = m_maxDrawdownDuration;
+    }
+    
+    EquityAccumulator::EquityAccumulator(double initialBalance) {
+        reset(initialBalance);
+    }
+    
+    void EquityAccumulator::reset(double initialBalance) {
+        m_initialBalance = initialBalance;
+        m_balance = initialBalance;
+        m_drawdown.reset(initialBalance);
         
-        // Calculate advanced metrics
-        calculateDrawdownMetrics(stats, equityCurve);
-        calculateStreaks(stats, trades);
-        stats.profitFactor = calculateProfitFactor(trades);
+        m_tradeCount = 0;
+        m_winningTrades = 0;
+        m_losingTrades = 0;
+        m_totalWins = 0.0;
+        m_totalLosses = 0.0;
+        m_largestWin = 0.0;
+        m_largestLoss = 0.0;
+        m_totalRMultiple = 0.0;
         
-        // Calculate returns for Sharpe ratio
-        std::vector<double> returns;
-        for (size_t i = 1; i < equityCurve.size(); ++i) {
-            double ret = (equityCurve[i] - equityCurve[i-1]) / equityCurve[i-1];
-            returns.push_back(ret);
-        }
-        stats.sharpeRatio = calculateSharpeRatio(returns);
+        m_winStreak = 0;
+        m_loseStreak = 0;
+        m_longestWinStreak = 0;
+        m_longestLoseStreak = 0;
         
-        return stats;
+        m_returnMean = 0.0;
+        m_returnM2 = 0.0;
     }
     
-    std::vector<double> EquityAnalyzer::generateEquityCurve(const std::vector<std::shared_ptr<Trade>>& trades,
-                                                         double initialBalance) {
-        std::vector<double> curve;
-        curve.push_back(initialBalance);
+    double EquityAccumulator::push(TradeOutcome outcome, double riskAmount,
+                                   double rewardAmount, double riskRewardRatio) {
+        double previousBalance = m_balance;
+        m_tradeCount++;
         
-        double currentBalance = initialBalance;
-        for (const auto& trade : trades) {
-            TradeOutcome outcome = trade->getOutcome();
+        if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
+            m_winningTrades++;
+            m_balance += rewardAmount;
+            m_totalWins += rewardAmount;
+            m_largestWin = std::max(m_largestWin, rewardAmount);
+            m_totalRMultiple += riskRewardRatio;
             
-            if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                currentBalance += trade->getResults().rewardAmount;
-            } else if (outcome == TradeOutcome::LossAtSL) {
-                currentBalance -= trade->getResults().riskAmount;
-            }
+            m_winStreak++;
+            m_loseStreak = 0;
+            m_longestWinStreak = std::max(m_longestWinStreak, m_winStreak);
+        } else if (outcome == TradeOutcome::LossAtSL) {
+            m_losingTrades++;
+            m_balance -= riskAmount;
+            m_totalLosses += riskAmount;
+            m_largestLoss = std::max(m_largestLoss, riskAmount);
+            m_totalRMultiple -= 1.0;  // -1R
             
-            curve.push_back(currentBalance);
+            m_loseStreak++;
+            m_winStreak = 0;
+            m_longestLoseStreak = std::max(m_longestLoseStreak, m_loseStreak);
+        } else {
+            // Break-even or pending
+            m_winStreak = 0;
+            m_loseStreak = 0;
         }
         
-        return curve;
+        // Welford update with this trade's return
+        double ret = (m_balance - previousBalance) / previousBalance;
+        double delta = ret - m_returnMean;
+        m_returnMean += delta / m_tradeCount;
+        m_returnM2 += delta * (ret - m_returnMean);
+        
+        return m_drawdown.update(m_balance);
     }
     
-    void EquityAnalyzer::calculateDrawdownMetrics(EquityStats& stats, const std::vector<double>& equityCurve) {
-        if (equityCurve.size() < 2) {
-            return;
-        }
-        
-        double peakBalance = equityCurve[0];
-        double maxDrawdown = 0.0;
-        double currentDrawdown = 0.0;
-        int drawdownDuration = 0;
-        int maxDrawdownDuration = 0;
-        
-        for (size_t i = 1; i < equityCurve.size(); ++i) {
-            // Update peak if we have a new high
-            if (equityCurve[i] > peakBalance) {
-                peakBalance = equityCurve[i];
-                // Reset drawdown duration if we make a new high
-                drawdownDuration = 0;
-            } else {
-                // We're in a drawdown
-                drawdownDuration++;
-                currentDrawdown = peakBalance - equityCurve[i];
-                double drawdownPercent = (peakBalance > 0) ? (currentDrawdown / peakBalance * 100.0) : 0.0;
-                
-                // Update max drawdown if current is larger
-                if (currentDrawdown > maxDrawdown) {
-                    maxDrawdown = currentDrawdown;
-                    stats.maxDrawdownPercent = drawdownPercent;
-                }
-                
-                // Update max drawdown duration
-                maxDrawdownDuration = std::max(maxDrawdownDuration, drawdownDuration);
-            }
-        }
-        
-        stats.maxDrawdown = maxDrawdown;
-        stats.drawdownDuration = maxDrawdownDuration;
+    double EquityAccumulator::push(const Trade& trade) {
+        const TradeResults& results = trade.getResultsRef();
+        return push(trade.getOutcome(), results.riskAmount, results.rewardAmount, results.riskRewardRatio);
     }
     
-    void EquityAnalyzer::calculateStreaks(EquityStats& stats, const std::vector<std::shared_ptr<Trade>>& trades) {
-        int currentWinStreak = 0;
-        int currentLoseStreak = 0;
-        int maxWinStreak = 0;
-        int maxLoseStreak = 0;
+    double EquityAccumulator::push(const Backtest::BacktestTrade& trade) {
+        return push(trade.outcome, trade.riskAmount, trade.rewardAmount, trade.riskRewardRatio);
+    }
+    
+    EquityStats EquityAccumulator::snapshot() const {
+        EquityStats stats;
+        stats.initialBalance = m_initialBalance;
+        stats.finalBalance = m_balance;
+        stats.totalTrades = m_tradeCount;
         
-        for (const auto& trade : trades) {
-            TradeOutcome outcome = trade->getOutcome();
-            
-            if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                // Win
-                currentWinStreak++;
-                currentLoseStreak = 0;
-                maxWinStreak = std::max(maxWinStreak, currentWinStreak);
-            } else if (outcome == TradeOutcome::LossAtSL) {
-                // Loss
-                currentLoseStreak++;
-                currentWinStreak = 0;
-                maxLoseStreak = std::max(maxLoseStreak, currentLoseStreak);
-            } else {
-                // Break-even or pending
-                currentWinStreak = 0;
-                currentLoseStreak = 0;
-            }
+        if (m_tradeCount == 0) {
+            return stats;
         }
         
-        stats.longestWinStreak = maxWinStreak;
-        stats.longestLoseStreak = maxLoseStreak;
+        stats.totalPnL = m_balance - m_initialBalance;
+        stats.percentGain = (m_initialBalance > 0) ? (stats.totalPnL / m_initialBalance * 100.0) : 0.0;
+        stats.winRate = static_cast<double>(m_winningTrades) / m_tradeCount * 100.0;
+        
+        stats.largestWin = m_largestWin;
+        stats.largestLoss = m_largestLoss;
+        stats.avgWin = (m_winningTrades > 0) ? (m_totalWins / m_winningTrades) : 0.0;
+        // Break-even and pending trades count towards the loss average, as before
+        int nonWinningTrades = m_tradeCount - m_winningTrades;
+        stats.avgLoss = (nonWinningTrades > 0) ? (m_totalLosses / nonWinningTrades) : 0.0;
+        
+        stats.avgRMultiple = m_totalRMultiple / m_tradeCount;
+        stats.expectancy = stats.avgRMultiple;
+        
+        m_drawdown.apply(stats);
         
+        stats.longestWinStreak = m_longestWinStreak;
+        stats.longestLoseStreak = m_longestLoseStreak;
         // Current streak (positive for wins, negative for losses)
-        if (currentWinStreak > 0) {
-            stats.currentStreak = currentWinStreak;
-        } else if (currentLoseStreak > 0) {
-            stats.currentStreak = -currentLoseStreak;
-        } else {
-            stats.currentStreak = 0;
+        if (m_winStreak > 0) {
+            stats.currentStreak = m_winStreak;
+        } else if (m_loseStreak > 0) {
+            stats.currentStreak = -m_loseStreak;
         }
+        
+        stats.profitFactor = (m_totalLosses > 0) ? (m_totalWins / m_totalLosses) : 0.0;
+        
+        // Annualized Sharpe ratio (approximation), assuming one trade per day
+        // and a risk-free rate of 0
+        double stdDev = std::sqrt(m_returnM2 / m_tradeCount);
+        stats.sharpeRatio = (stdDev > 0) ? (m_returnMean / stdDev) * std::sqrt(252.0) : 0.0;
+        
+        return stats;
     }
     
-    double EquityAnalyzer::calculateSharpeRatio(const std::vector<double>& returns) {
-        if (returns.empty()) {
-            return 0.0;
+    EquityAnalyzer::EquityAnalyzer() {}
+    
+    EquityStats EquityAnalyzer::calculateStats(const std::vector<std::shared_ptr<Trade>>& trades, 
+                                             double initialBalance) {
+        EquityAccumulator accumulator(initialBalance);
+        for (const auto& trade : trades) {
+            accumulator.push(*trade);
         }
-        
-        // Calculate average return
-        double avgReturn = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
-        
-        // Calculate standard deviation of returns
-        double sumSquaredDiff = 0.0;
-        for (double ret : returns) {
-            double diff = ret - avgReturn;
-            sumSquaredDiff += diff * diff;
+        return accumulator.snapshot();
+    }
+    
+    EquityStats EquityAnalyzer::calculateStats(const std::vector<Backtest::BacktestTrade>& trades,
+                                             double initialBalance) {
+        EquityAccumulator accumulator(initialBalance);
+        for (const auto& trade : trades) {
+            accumulator.push(trade);
         }
-        
-        double stdDev = std::sqrt(sumSquaredDiff / returns.size());
-        
-        // Calculate annualized Sharpe ratio (approximation)
-        // Assuming average of one trade per day
-        // Using 0 as risk-free rate for simplicity
-        return (stdDev > 0) ? (avgReturn / stdDev) * std::sqrt(252.0) : 0.0;
+        return accumulator.snapshot();
     }
     
-    double EquityAnalyzer::calculateProfitFactor(const std::vector<std::shared_ptr<Trade>>& trades) {
-        double totalWins = 0.0;
-        double totalLosses = 0.0;
+    std::vector<double> EquityAnalyzer::generateEquityCurve(const std::vector<std::shared_ptr<Trade>>& trades,
+                                                         double initialBalance) {
+        std::vector<double> curve;
+        curve.reserve(trades.size() + 1);
+        curve.push_back(initialBalance);
         
+        double currentBalance = initialBalance;
         for (const auto& trade : trades) {
             TradeOutcome outcome = trade->getOutcome();
             
             if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                totalWins += trade->getResults().rewardAmount;
+                currentBalance += trade->getResultsRef().rewardAmount;
             } else if (outcome == TradeOutcome::LossAtSL) {
-                totalLosses += trade->getResults().riskAmount;
+                currentBalance -= trade->getResultsRef().riskAmount;
             }
+            
+            curve.push_back(currentBalance);
         }
         
-        return (totalLosses > 0) ? (totalWins / totalLosses) : 0.0;
+        return curve;
     }
     
     std::string EquityAnalyzer::getStatsReport(const EquityStats& stats) const {
@@ -6,6 +6,10 @@
 #include <memory>
 #include "../Trade.h"
 
+namespace Backtest {
+    struct BacktestTrade;
+}
+
 namespace Analytics {
     // Extended statistics for equity analysis
     struct EquityStats {
@@ -40,14 +44,91 @@ namespace Analytics {
         double expectancy = 0.0;  // Average R-multiple gain/loss per trade
     };
     
+    // Running high-water mark and drawdown state, updated one balance at a time.
+    // Produces the same values as a full walk over the equity curve.
+    class DrawdownTracker {
+    public:
+        explicit DrawdownTracker(double initialBalance = 0.0);
+        
+        void reset(double initialBalance);
+        
+        // Add the next balance; returns the current drawdown in percent of the peak
+        double update(double balance);
+        
+        double getPeakBalance() const { return m_peakBalance; }
+        double getMaxDrawdown() const { return m_maxDrawdown; }
+        double getMaxDrawdownPercent() const { return m_maxDrawdownPercent; }
+        int getMaxDrawdownDuration() const { return m_maxDrawdownDuration; }
+        
+        // Copy the drawdown fields into stats
+        void apply(EquityStats& stats) const;
+        
+    private:
+        double m_peakBalance = 0.0;
+        double m_maxDrawdown = 0.0;
+        double m_maxDrawdownPercent = 0.0;
+        int m_drawdownDuration = 0;
+        int m_maxDrawdownDuration = 0;
+    };
+    
+    // Streaming statistics: push trades in order, read the stats at any point.
+    // Every EquityStats field is maintained in the same single pass.
+    class EquityAccumulator {
+    public:
+        explicit EquityAccumulator(double initialBalance = 0.0);
+        
+        void reset(double initialBalance);
+        
+        // Add the next trade; returns the current drawdown in percent of the peak
+        double push(TradeOutcome outcome, double riskAmount, double rewardAmount, double riskRewardRatio);
+        double push(const Trade& trade);
+        double push(const Backtest::BacktestTrade& trade);
+        
+        // Statistics over all trades pushed so far
+        EquityStats snapshot() const;
+        
+        double getBalance() const { return m_balance; }
+        int getTradeCount() const { return m_tradeCount; }
+        int getWinningTrades() const { return m_winningTrades; }
+        int getLosingTrades() const { return m_losingTrades; }
+        const DrawdownTracker& getDrawdown() const { return m_drawdown; }
+        
+    private:
+        double m_initialBalance = 0.0;
+        double m_balance = 0.0;
+        DrawdownTracker m_drawdown;
+        
+        int m_tradeCount = 0;
+        int m_winningTrades = 0;
+        int m_losingTrades = 0;
+        double m_totalWins = 0.0;
+        double m_totalLosses = 0.0;
+        double m_largestWin = 0.0;
+        double m_largestLoss = 0.0;
+        double m_totalRMultiple = 0.0;
+        
+        int m_winStreak = 0;
+        int m_loseStreak = 0;
+        int m_longestWinStreak = 0;
+        int m_longestLoseStreak = 0;
+        
+        // Welford's running mean and sum of squared deviations of per-trade returns
+        double m_returnMean = 0.0;
+        double m_returnM2 = 0.0;
+    };
+    
     class EquityAnalyzer {
     public:
         EquityAnalyzer();
         ~EquityAnalyzer() = default;
         
-        // Calculate statistics from trade history
+        // Calculate statistics from trade history in a single pass
         EquityStats calculateStats(const std::vector<std::shared_ptr<Trade>>& trades, 
                                   double initialBalance);
+        
+        // Same statistics for backtest trade records
+        EquityStats calculateStats(const std::vector<Backtest::BacktestTrade>& trades,
+                                  double initialBalance);
                                   
         // Calculate equity curve as vector of balances
         std::vector<double> generateEquityCurve(const std::vector<std::shared_ptr<Trade>>& trades,
@@ -55,18 +136,6 @@ namespace Analytics {
         
         // Get formatted stats report as string
         std::string getStatsReport(const EquityStats& stats) const;
-        
-    private:
-        // Helper methods
-        void calculateDrawdownMetrics(EquityStats& stats, 
-                                     const std::vector<double>& equityCurve);
-                                     
-        void calculateStreaks(EquityStats& stats,
-                             const std::vector<std::shared_ptr<Trade>>& trades);
-                             
-        double calculateSharpeRatio(const std::vector<double>& returns);
-        
-        double calculateProfitFactor(const std::vector<std::shared_ptr<Trade>>& trades);
     };
 }
 
@@ -0,0 +1,243 @@
+#include "TradeResampler.h"
+#include "../Backtest/BacktestTrade.h"
+#include "../Utils/Philox.h"
+#include "../Utils/WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace Analytics {
+    namespace {
+        // Statistics of one replayed sequence
+        struct PathStats {
+            double balance;
+            double peak;
+            double maxDrawdown = 0.0;
+            double maxDrawdownPercent = 0.0;
+            std::size_t count = 0;
+            double returnMean = 0.0;
+            double returnM2 = 0.0;
+
+            explicit PathStats(double initialBalance) : balance(initialBalance), peak(initialBalance) {}
+
+            void push(double ret) {
+                balance += balance * ret;
+
+                // Same rules as DrawdownTracker
+                if (balance > peak) {
+                    peak = balance;
+                } else {
+                    double drawdown = peak - balance;
+                    if (drawdown > maxDrawdown) {
+                        maxDrawdown = drawdown;
+                        maxDrawdownPercent = (peak > 0) ? (drawdown / peak * 100.0) : 0.0;
+                    }
+                }
+
+                // Welford, as in EquityAccumulator
+                ++count;
+                double delta = ret - returnMean;
+                returnMean += delta / static_cast<double>(count);
+                returnM2 += delta * (ret - returnMean);
+            }
+
+            double sharpeRatio() const {
+                if (count == 0) {
+                    return 0.0;
+                }
+                double stdDev = std::sqrt(returnM2 / static_cast<double>(count));
+                return (stdDev > 0) ? (returnMean / stdDev) * std::sqrt(252.0) : 0.0;
+            }
+        };
+
+        // Uniform integer in [0, bound) from 32 random bits (multiply-shift)
+        inline std::size_t below(Utils::PhiloxStream& rng, std::size_t bound) {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(rng.nextUInt32()) * bound) >> 32);
+        }
+
+        double percentileOf(const std::vector<double>& sorted, double percentile) {
+            double clamped = std::min(std::max(percentile, 0.0), 100.0);
+            std::size_t rank = static_cast<std::size_t>(clamped / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[rank];
+        }
+    }
+
+    TradeResampler::TradeResampler(double initialBalance, std::vector<double> returns)
+        : m_initialBalance(initialBalance), m_returns(std::move(returns)) {}
+
+    TradeResampler TradeResampler::fromTrades(const std::vector<Backtest::BacktestTrade>& trades,
+                                              double initialBalance) {
+        std::vector<double> returns;
+        returns.reserve(trades.size());
+        for (const auto& trade : trades) {
+            if (trade.outcome == TradeOutcome::Pending || !(trade.balanceBefore > 0.0)) {
+                continue;
+            }
+            returns.push_back(trade.pnl / trade.balanceBefore);
+        }
+        return TradeResampler(initialBalance, std::move(returns));
+    }
+
+    ResampleResult TradeResampler::run(const ResampleParams& params) const {
+        Utils::WorkStealingPool pool(params.threadCount);
+        return run(params, pool);
+    }
+
+    ResampleResult TradeResampler::run(const ResampleParams& params, Utils::WorkStealingPool& pool) const {
+        ResampleResult result;
+        result.method = params.method;
+        result.numTrades = m_returns.size();
+        if (params.numSamples == 0 || m_returns.empty()) {
+            return result;
+        }
+
+        const std::size_t samples = params.numSamples;
+        const std::size_t trades = m_returns.size();
+        const std::size_t blockLength = std::max<std::size_t>(params.blockLength, 1);
+        const std::uint64_t skipThreshold = static_cast<std::uint64_t>(
+            std::min(std::max(params.skipProbability, 0.0), 1.0) * 4294967296.0);
+
+        std::vector<double> finalBalances(samples);
+        std::vector<double> drawdowns(samples);
+        std::vector<double> sharpeRatios(samples);
+
+        const std::size_t chunkSamples = 64;
+        std::size_t chunks = (samples + chunkSamples - 1) / chunkSamples;
+
+        pool.parallelFor(chunks, [&](std::size_t chunk) {
+            std::vector<std::size_t> order;
+            if (params.method == ResampleMethod::Shuffle) {
+                order.resize(trades);
+            }
+
+            std::size_t first = chunk * chunkSamples;
+            std::size_t last = std::min(first + chunkSamples, samples);
+            for (std::size_t sample = first; sample < last; ++sample) {
+                Utils::PhiloxStream rng(params.seed, sample);
+                PathStats path(m_initialBalance);
+
+                switch (params.method) {
+                    case ResampleMethod::Shuffle: {
+                        // Fisher-Yates
+                        for (std::size_t i = 0; i < trades; ++i) {
+                            order[i] = i;
+                        }
+                        for (std::size_t i = trades - 1; i > 0; --i) {
+                            std::swap(order[i], order[below(rng, i + 1)]);
+                        }
+                        for (std::size_t i : order) {
+                            path.push(m_returns[i]);
+                        }
+                        break;
+                    }
+                    case ResampleMethod::BlockBootstrap: {
+                        std::size_t drawn = 0;
+                        while (drawn < trades) {
+                            std::size_t start = below(rng, trades);
+                            for (std::size_t k = 0; k < blockLength && drawn < trades; ++k, ++drawn) {
+                                path.push(m_returns[(start + k) % trades]);
+                            }
+                        }
+                        break;
+                    }
+                    case ResampleMethod::SkipTrades: {
+                        for (double ret : m_returns) {
+                            if (rng.nextUInt32() >= skipThreshold) {
+                                path.push(ret);
+                            }
+                        }
+                        break;
+                    }
+                }
+
+                finalBalances[sample] = path.balance;
+                drawdowns[sample] = path.maxDrawdownPercent;
+                sharpeRatios[sample] = path.sharpeRatio();
+            }
+        });
+
+        // Means in sample order
+        double finalSum = 0.0;
+        double drawdownSum = 0.0;
+        double sharpeSum = 0.0;
+        for (std::size_t sample = 0; sample < samples; ++sample) {
+            finalSum += finalBalances[sample];
+            drawdownSum += drawdowns[sample];
+            sharpeSum += sharpeRatios[sample];
+        }
+
+        std::sort(finalBalances.begin(), finalBalances.end());
+        std::sort(drawdowns.begin(), drawdowns.end());
+        std::sort(sharpeRatios.begin(), sharpeRatios.end());
+
+        for (double percentile : params.percentiles) {
+            PercentileRow row;
+            row.percentile = percentile;
+            row.finalBalance = percentileOf(finalBalances, percentile);
+            row.maxDrawdownPercent = percentileOf(drawdowns, percentile);
+            row.sharpeRatio = percentileOf(sharpeRatios, percentile);
+            result.percentiles.push_back(row);
+        }
+
+        result.numSamples = samples;
+        result.meanFinalBalance = finalSum / static_cast<double>(samples);
+        result.meanMaxDrawdownPercent = drawdownSum / static_cast<double>(samples);
+        result.meanSharpeRatio = sharpeSum / static_cast<double>(samples);
+        return result;
+    }
+
+    std::string TradeResampler::toMarkdown(const ResampleResult& result) {
+        std::ostringstream oss;
+        const bool withBalance = statisticVaries(result.method, ResampleStatistic::FinalBalance);
+        const bool withSharpe = statisticVaries(result.method, ResampleStatistic::SharpeRatio);
+        oss << std::fixed;
+        oss << "| Percentile |" << (withBalance ? " Final Balance |" : "") << " Max Drawdown (%) |"
+            << (withSharpe ? " Sharpe Ratio |" : "") << "\n";
+        oss << "|-----------:|" << (withBalance ? "--------------:|" : "") << "-----------------:|"
+            << (withSharpe ? "-------------:|" : "") << "\n";
+
+        auto cells = [&](double finalBalance, double maxDrawdownPercent, double sharpeRatio) {
+            oss << std::setprecision(2);
+            if (withBalance) {
+                oss << " " << finalBalance << " |";
+            }
+            oss << " " << maxDrawdownPercent << " |";
+            if (withSharpe) {
+                oss << " " << sharpeRatio << " |";
+            }
+            oss << "\n";
+        };
+        for (const auto& row : result.percentiles) {
+            oss << "| " << std::setprecision(0) << row.percentile << "th |";
+            cells(row.finalBalance, row.maxDrawdownPercent, row.sharpeRatio);
+        }
+        oss << "| Mean |";
+        cells(result.meanFinalBalance, result.meanMaxDrawdownPercent, result.meanSharpeRatio);
+        return oss.str();
+    }
+
+    bool TradeResampler::statisticVaries(ResampleMethod method, ResampleStatistic statistic) {
+        return method != ResampleMethod::Shuffle || statistic == ResampleStatistic::MaxDrawdownPercent;
+    }
+
+    const char* TradeResampler::methodName(ResampleMethod method) {
+        switch (method) {
+            case ResampleMethod::Shuffle: return "shuffle";
+            case ResampleMethod::BlockBootstrap: return "bootstrap";
+            case ResampleMethod::SkipTrades: return "skip";
+        }
+        return "unknown";
+    }
+
+    bool TradeResampler::parseMethod(const std::string& name, ResampleMethod& method) {
+        for (ResampleMethod candidate : {ResampleMethod::Shuffle, ResampleMethod::BlockBootstrap,
+                                         ResampleMethod::SkipTrades}) {
+            if (name == methodName(candidate)) {
+                method = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+}
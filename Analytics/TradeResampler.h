@@ -0,0 +1,105 @@
+#ifndef ANALYTICS_TRADE_RESAMPLER_H
+#define ANALYTICS_TRADE_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Backtest {
+    struct BacktestTrade;
+}
+
+namespace Utils {
+    class WorkStealingPool;
+}
+
+namespace Analytics {
+    // How each resampled trade sequence is drawn from the original one
+    enum class ResampleMethod {
+        Shuffle,         // Same trades in a random order
+        BlockBootstrap,  // Circular blocks of consecutive trades, drawn with replacement
+        SkipTrades       // Original order, each trade dropped with a fixed probability
+    };
+
+    // Statistics reported for each sample
+    enum class ResampleStatistic {
+        FinalBalance,
+        MaxDrawdownPercent,
+        SharpeRatio
+    };
+
+    struct ResampleParams {
+        ResampleMethod method = ResampleMethod::Shuffle;
+        std::size_t numSamples = 5000;
+        std::uint64_t seed = 0x5EED;
+        std::size_t blockLength = 5;        // BlockBootstrap only
+        double skipProbability = 0.1;       // SkipTrades only
+        std::vector<double> percentiles = {5.0, 25.0, 50.0, 75.0, 95.0};
+        unsigned int threadCount = 0;       // 0 = hardware concurrency (own pool only)
+    };
+
+    // Nearest-rank percentile of each statistic across samples
+    struct PercentileRow {
+        double percentile = 0.0;
+        double finalBalance = 0.0;
+        double maxDrawdownPercent = 0.0;
+        double sharpeRatio = 0.0;
+    };
+
+    struct ResampleResult {
+        ResampleMethod method = ResampleMethod::Shuffle;
+        std::size_t numSamples = 0;
+        std::size_t numTrades = 0;  // Length of the original sequence
+        std::vector<PercentileRow> percentiles;
+
+        double meanFinalBalance = 0.0;
+        double meanMaxDrawdownPercent = 0.0;
+        double meanSharpeRatio = 0.0;
+    };
+
+    // Confidence intervals for a backtest from resampled trade sequences.
+    // Trades are reduced to one compact array of per-trade returns
+    // (P&L / balance before the trade), so a sample is replayed by compounding
+    // returns rather than re-simulating trades; this keeps percentage risk
+    // sizing intact when trades move. Drawdown and Sharpe ratio use the same
+    // rules as EquityAccumulator.
+    //
+    // Every sample draws from its own Philox stream (seed, sample index).
+    class TradeResampler {
+    public:
+        TradeResampler(double initialBalance, std::vector<double> returns);
+
+        // Per-trade returns of closed trades; pending trades are left out
+        static TradeResampler fromTrades(const std::vector<Backtest::BacktestTrade>& trades,
+                                         double initialBalance);
+
+        // Runs on its own pool with params.threadCount workers
+        ResampleResult run(const ResampleParams& params) const;
+
+        // Runs on a caller's pool; may be called from inside one of its tasks
+        ResampleResult run(const ResampleParams& params, Utils::WorkStealingPool& pool) const;
+
+        const std::vector<double>& getReturns() const { return m_returns; }
+        double getInitialBalance() const { return m_initialBalance; }
+
+        // Markdown table of a result's percentiles, with a column for each
+        // statistic that varies under the result's method
+        static std::string toMarkdown(const ResampleResult& result);
+
+        // False when every sample has the original value. Shuffling only
+        // reorders the returns: compounded balance is a product, and Sharpe
+        // depends on their mean and spread, so only drawdown varies.
+        static bool statisticVaries(ResampleMethod method, ResampleStatistic statistic);
+
+        // "shuffle", "bootstrap" or "skip"
+        static const char* methodName(ResampleMethod method);
+        static bool parseMethod(const std::string& name, ResampleMethod& method);
+
+    private:
+        double m_initialBalance;
+        std::vector<double> m_returns;
+    };
+}
+
+#endif // ANALYTICS_TRADE_RESAMPLER_H
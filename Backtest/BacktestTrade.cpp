@@ -0,0 +1,42 @@
+#include "BacktestTrade.h"
+
+namespace Backtest {
+    std::shared_ptr<Trade> BacktestTrade::toTrade() const {
+        auto trade = std::make_shared<Trade>();
+        trade->setAccountBalance(balanceBefore);
+        trade->setRiskPercentage(riskPercent);
+        trade->setEntryPrice(entryPrice);
+        trade->setStopLoss(stopLoss, InputType::Price);
+        trade->setTakeProfit(takeProfit, InputType::Price);
+        trade->setInstrumentType(0); // Forex
+        trade->setLotSizeType(0);    // Standard lot
+        trade->setTimestamp(static_cast<std::time_t>(entryTime));
+        trade->calculate();
+        trade->simulateOutcome(outcome);
+        return trade;
+    }
+    
+    std::string outcomeToString(TradeOutcome outcome) {
+        switch (outcome) {
+            case TradeOutcome::LossAtSL:
+                return "Loss at Stop Loss";
+            case TradeOutcome::WinAtTP1:
+                return "Win at Take Profit 1";
+            case TradeOutcome::WinAtTP2:
+                return "Win at Take Profit 2";
+            case TradeOutcome::BreakEven:
+                return "Break Even";
+            default:
+                return "Pending";
+        }
+    }
+    
+    std::vector<std::shared_ptr<Trade>> toTrades(const std::vector<BacktestTrade>& trades) {
+        std::vector<std::shared_ptr<Trade>> result;
+        result.reserve(trades.size());
+        for (const auto& trade : trades) {
+            result.push_back(trade.toTrade());
+        }
+        return result;
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef BACKTEST_BACKTEST_TRADE_H
+#define BACKTEST_BACKTEST_TRADE_H
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "../Trade.h"
+
+namespace Backtest {
+    // Compact record of one simulated trade. Backtests store these by value;
+    // a full Trade is only built when something needs one (display, export).
+    struct BacktestTrade {
+        std::uint32_t entryIndex = 0;   // Bar whose close opened the trade
+        std::uint32_t exitIndex = 0;    // Bar on which it closed
+        std::int64_t entryTime = 0;
+        std::int64_t exitTime = 0;
+        
+        double entryPrice = 0.0;
+        double stopLoss = 0.0;
+        double takeProfit = 0.0;
+        double riskPercent = 0.0;
+        
+        // Sizing, as computed by TradeCalculator
+        double positionSize = 0.0;
+        double riskAmount = 0.0;
+        double rewardAmount = 0.0;
+        double riskRewardRatio = 0.0;
+        
+        double pnl = 0.0;               // +rewardAmount, -riskAmount or 0
+        double balanceBefore = 0.0;
+        double balanceAfter = 0.0;
+        
+        TradeOutcome outcome = TradeOutcome::Pending;
+        bool isLong = true;
+        
+        bool isWin() const {
+            return outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2;
+        }
+        bool isLoss() const { return outcome == TradeOutcome::LossAtSL; }
+        
+        // Build an equivalent Trade (forex, standard lots)
+        std::shared_ptr<Trade> toTrade() const;
+    };
+    
+    static_assert(std::is_trivially_copyable<BacktestTrade>::value,
+                  "BacktestTrade must stay trivially copyable");
+    
+    // Same labels as Trade::getOutcomeAsString
+    std::string outcomeToString(TradeOutcome outcome);
+    
+    // Build Trade objects for a whole result
+    std::vector<std::shared_ptr<Trade>> toTrades(const std::vector<BacktestTrade>& trades);
+}
+
+#endif // BACKTEST_BACKTEST_TRADE_H
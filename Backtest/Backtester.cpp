@@ -1,8 +1,13 @@
 #include "Backtester.h"
+#include "PriceDataLoader.h"
+#include "CandleCache.h"
+#include "TickData.h"
 #include "../Utils.h"
+#include "../TradeCalculator.h"
 #include <fstream>
-#include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <iomanip>
 #include <iostream>
 
@@ -22,62 +27,70 @@ namespace Backtest {
     }
     
     bool Backtester::loadPriceData(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open file " << filename << std::endl;
-            return false;
-        }
-        
-        m_priceData.clear();
-        
-        std::string line;
-        std::getline(file, line); // Skip header line
-        
-        while (std::getline(file, line)) {
-            std::stringstream ss(line);
-            std::string field;
-            CandleData candle;
+        // Taken before reading, so caches written below go stale if the CSV
+        // changes while it is parsed
+        SourceSignature source;
+        bool useCache = m_useCandleCache && CandleCache::sourceSignature(filename, source);
+        
+        auto series = std::make_shared<CandleSeries>();
+        bool loaded = useCache && CandleCache::load(filename, m_loaderMode, *series, m_loaderStats);
+        
+        if (!loaded) {
+            loaded = (m_loaderMode == LoaderMode::MemoryMapped)
+                ? PriceDataLoader::loadMapped(filename, *series, m_loaderStats)
+                : PriceDataLoader::loadStream(filename, *series, m_loaderStats);
             
-            // Parse date/time
-            std::getline(ss, field, ',');
-            std::tm tm = {};
-            std::istringstream dateStream(field);
-            dateStream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
-            candle.timestamp = std::mktime(&tm);
-            
-            // Parse OHLC
-            std::getline(ss, field, ',');
-            candle.open = std::stod(field);
-            
-            std::getline(ss, field, ',');
-            candle.high = std::stod(field);
-            
-            std::getline(ss, field, ',');
-            candle.low = std::stod(field);
-            
-            std::getline(ss, field, ',');
-            candle.close = std::stod(field);
-            
-            // Parse volume if available
-            if (std::getline(ss, field, ',')) {
-                try {
-                    candle.volume = std::stod(field);
-                } catch (...) {
-                    candle.volume = 0.0;
-                }
+            // Cache write failures only cost the next run a re-parse
+            if (loaded && useCache) {
+                CandleCache::write(filename, m_loaderMode, *series, source);
             }
-            
-            m_priceData.push_back(candle);
         }
         
-        file.close();
+        if (!loaded) {
+            return false;
+        }
         
-        // Sort by timestamp if needed
-        std::sort(m_priceData.begin(), m_priceData.end(), [](const CandleData& a, const CandleData& b) {
-            return a.timestamp < b.timestamp;
-        });
+        // Higher timeframes come from their caches while those are current
+        std::shared_ptr<const MultiTimeframeSeries> timeframes;
+        if (!m_timeframeList.empty() && useCache) {
+            timeframes = Resampler::load(filename, m_loaderMode, source, series, m_timeframeList);
+        }
         
-        return !m_priceData.empty();
+        attachPriceData(std::move(series), std::move(timeframes));
+        return true;
+    }
+    
+    void Backtester::setPriceData(std::shared_ptr<const CandleSeries> series) {
+        attachPriceData(std::move(series), nullptr);
+    }
+    
+    void Backtester::attachPriceData(std::shared_ptr<const CandleSeries> series,
+                                     std::shared_ptr<const MultiTimeframeSeries> timeframes) {
+        // Signals depend only on the data, so scan once here rather than per run
+        m_signals = std::make_shared<const SignalMask>(SignalScanner::scan(*series));
+        m_exitResolver = std::make_shared<ExitResolver>(series);
+        if (!timeframes && !m_timeframeList.empty()) {
+            timeframes = Resampler::build(series, m_timeframeList);
+        }
+        m_timeframes = std::move(timeframes);
+        m_series = std::move(series);
+    }
+    
+    void Backtester::sharePriceData(const Backtester& source) {
+        m_series = source.m_series;
+        m_signals = source.m_signals;
+        m_exitResolver = source.m_exitResolver;
+        m_timeframes = source.m_timeframes;
+        m_ticks = source.m_ticks;
+    }
+    
+    bool Backtester::loadTickData(const std::string& filename) {
+        auto ticks = std::make_shared<TickData>();
+        if (!ticks->open(filename, m_loaderMode)) {
+            return false;
+        }
+        m_ticks = std::move(ticks);
+        return true;
     }
     
     BacktestResult Backtester::runBacktest() {
@@ -90,74 +103,53 @@ namespace Backtest {
         result.drawdownCurve.clear();
         result.drawdownCurve.push_back(0.0);
         
-        double currentBalance = m_config.initialBalance;
-        double peakBalance = currentBalance;
-        
-        // Simple fixed RR strategy implementation for demonstration
-        for (size_t i = 1; i < m_priceData.size() - 1; ++i) {
-            bool isLongEntry = false;
+        // Position sizing for every simulated trade
+        const TradeCalculator calculator;
+        
+        // Statistics, drawdown included, maintained as trades close
+        Analytics::EquityAccumulator equity(m_config.initialBalance);
+        
+        std::uint8_t enabledSignals = static_cast<std::uint8_t>(
+            (m_config.longEnabled ? SIGNAL_LONG : 0) | (m_config.shortEnabled ? SIGNAL_SHORT : 0));
+        size_t rangeEnd = rangeEndIndex();
+        size_t nextEntry = std::max<size_t>(1, m_range.begin);
+        
+        // Simple fixed RR strategy implementation for demonstration.
+        // Only bars flagged by the signal scan are visited.
+        static const SignalMask noSignals;
+        const SignalMask& signals = m_signals ? *m_signals : noSignals;
+        auto first = std::lower_bound(signals.candidates.begin(), signals.candidates.end(), nextEntry);
+        for (auto it = first; it != signals.candidates.end(); ++it) {
+            size_t i = *it;
+            if (i >= rangeEnd) {
+                break;
+            }
+            if (i < nextEntry) {
+                continue;
+            }
             
-            // Check if we have an entry signal at this candle
-            if (detectEntry(i, isLongEntry)) {
-                // If direction is disabled in config, skip
-                if ((isLongEntry && !m_config.longEnabled) || 
-                    (!isLongEntry && !m_config.shortEnabled)) {
-                    continue;
-                }
-                
-                // Create a trade
-                auto trade = std::make_shared<Trade>();
-                trade->setAccountBalance(currentBalance);
-                trade->setEntryPrice(m_priceData[i].close);
-                
-                // Set risk percentage (fixed or compounding)
-                double riskPercent = m_config.riskPerTrade;
-                trade->setRiskPercentage(riskPercent);
-                
-                // Calculate SL and TP based on strategy
-                auto [sl, tp] = calculateStopLossAndTakeProfit(i, isLongEntry);
-                
-                // Set trade properties
-                if (isLongEntry) {
-                    // Long trade
-                    trade->setStopLoss(sl, InputType::Price);
-                    trade->setTakeProfit(tp, InputType::Price);
-                } else {
-                    // Short trade
-                    trade->setStopLoss(sl, InputType::Price);
-                    trade->setTakeProfit(tp, InputType::Price);
-                }
-                
-                // Calculate position size
-                trade->setInstrumentType(0); // Forex
-                trade->setLotSizeType(0);    // Standard lot
-                trade->calculate();
-                
-                // Forward test this trade to find outcome
-                bool simulated = simulateTrade(i, isLongEntry, result);
-                if (simulated) {
-                    i += 5; // Skip a few candles after a trade (to avoid immediate re-entry)
-                }
+            std::uint8_t signal = signals.flags[i];
+            bool isLongEntry = (signal & SIGNAL_LONG) != 0;
+            
+            // If direction is disabled in config, skip
+            if ((signal & enabledSignals) == 0) {
+                continue;
+            }
+            
+            // Forward test this trade to find outcome
+            bool simulated = simulateTrade(static_cast<int>(i), isLongEntry, calculator, result, equity);
+            if (simulated) {
+                nextEntry = i + 6; // Skip a few candles after a trade (to avoid immediate re-entry)
             }
         }
         
         // Calculate statistics
-        Analytics::EquityAnalyzer analyzer;
-        result.stats = analyzer.calculateStats(result.trades, m_config.initialBalance);
+        result.stats = equity.snapshot();
         
         // Update summary stats
         result.totalTrades = result.trades.size();
-        result.winningTrades = 0;
-        result.losingTrades = 0;
-        
-        for (const auto& trade : result.trades) {
-            if (trade->getOutcome() == TradeOutcome::WinAtTP1 || 
-                trade->getOutcome() == TradeOutcome::WinAtTP2) {
-                result.winningTrades++;
-            } else if (trade->getOutcome() == TradeOutcome::LossAtSL) {
-                result.losingTrades++;
-            }
-        }
+        result.winningTrades = equity.getWinningTrades();
+        result.losingTrades = equity.getLosingTrades();
         
         result.winRate = (result.totalTrades > 0) ? 
             (static_cast<double>(result.winningTrades) / result.totalTrades * 100.0) : 0.0;
@@ -169,39 +161,17 @@ namespace Backtest {
         return result;
     }
     
-    bool Backtester::detectEntry(int index, bool& isLong) const {
-        // Simple strategy for demonstration purposes:
-        // Long entry: current close > previous close and current close > current open
-        // Short entry: current close < previous close and current close < current open
-        
-        if (index <= 0 || index >= static_cast<int>(m_priceData.size()) - 1) {
-            return false;
-        }
-        
-        const auto& current = m_priceData[index];
-        const auto& previous = m_priceData[index - 1];
-        
-        // Long entry conditions
-        if (current.close > previous.close && current.close > current.open) {
-            isLong = true;
-            return true;
-        }
-        
-        // Short entry conditions
-        if (current.close < previous.close && current.close < current.open) {
-            isLong = false;
-            return true;
-        }
-        
-        return false;
+    size_t Backtester::rangeEndIndex() const {
+        size_t size = m_series ? m_series->size() : 0;
+        return std::min(m_range.end, size);
     }
     
     std::pair<double, double> Backtester::calculateStopLossAndTakeProfit(int index, bool isLong) const {
         double sl = 0.0, tp = 0.0;
         
         // Get the current candle
-        const auto& current = m_priceData[index];
-        double entryPrice = current.close;
+        const CandleSeries& series = *m_series;
+        double entryPrice = series.close()[index];
         
         switch (m_config.strategyType) {
             case StrategyType::FIXED_RR: {
@@ -224,8 +194,8 @@ namespace Backtest {
                 
                 // Find swing points in last 10 candles
                 for (int i = index - 1; i >= std::max(0, index - 10); --i) {
-                    swingHigh = std::max(swingHigh, m_priceData[i].high);
-                    swingLow = std::min(swingLow, m_priceData[i].low);
+                    swingHigh = std::max(swingHigh, series.high()[i]);
+                    swingLow = std::min(swingLow, series.low()[i]);
                 }
                 
                 if (isLong) {
@@ -255,113 +225,109 @@ namespace Backtest {
         return {sl, tp};
     }
     
-    bool Backtester::simulateTrade(int entryIndex, bool isLong, BacktestResult& result) {
-        if (entryIndex >= static_cast<int>(m_priceData.size()) - 1) {
+    bool Backtester::simulateTrade(int entryIndex, bool isLong, const TradeCalculator& calculator,
+                                   BacktestResult& result, Analytics::EquityAccumulator& equity) {
+        const CandleSeries& series = *m_series;
+        size_t rangeEnd = rangeEndIndex();
+        if (static_cast<size_t>(entryIndex) + 1 >= rangeEnd) {
             return false;
         }
         
-        const auto& entryCandle = m_priceData[entryIndex];
-        double entryPrice = entryCandle.close;
-        
-        // Create a new trade
-        auto trade = std::make_shared<Trade>();
-        
-        // Current account balance for risk calculation
-        double currentBalance = result.equityCurve.back();
-        trade->setAccountBalance(currentBalance);
-        trade->setRiskPercentage(m_config.riskPerTrade);
-        trade->setEntryPrice(entryPrice);
-        
-        // Set stop loss and take profit
+        double entryPrice = series.close()[entryIndex];
         auto [stopLoss, takeProfit] = calculateStopLossAndTakeProfit(entryIndex, isLong);
-        trade->setStopLoss(stopLoss, InputType::Price);
-        trade->setTakeProfit(takeProfit, InputType::Price);
         
-        // Calculate the trade
-        trade->setInstrumentType(0); // Forex
-        trade->setLotSizeType(0);    // Standard lot
-        trade->calculate();
+        // Find where SL, TP or the holding limit closes the trade
+        ExitResolution exit = m_exitResolver->resolve(entryIndex, isLong, stopLoss, takeProfit);
+        bool fromTicks = resolveFromTicks(entryIndex, isLong, stopLoss, takeProfit, exit);
         
-        // Simulate the trade outcome
-        TradeOutcome outcome = TradeOutcome::Pending;
-        bool tradeFinished = false;
+        // If we ran out of data (or range) before the trade completed, leave it out
+        if (!exit.finished || exit.exitIndex >= rangeEnd) {
+            return false;
+        }
         
-        // Look forward in time to see if SL or TP is hit
-        for (int i = entryIndex + 1; i < static_cast<int>(m_priceData.size()) && !tradeFinished; ++i) {
-            const auto& candle = m_priceData[i];
-            
-            if (isLong) {
-                // Check if stop loss hit
-                if (candle.low <= stopLoss) {
-                    outcome = TradeOutcome::LossAtSL;
-                    tradeFinished = true;
-                }
-                // Check if take profit hit
-                else if (candle.high >= takeProfit) {
-                    outcome = TradeOutcome::WinAtTP1;
-                    tradeFinished = true;
-                }
-            } else {
-                // Check if stop loss hit
-                if (candle.high >= stopLoss) {
-                    outcome = TradeOutcome::LossAtSL;
-                    tradeFinished = true;
-                }
-                // Check if take profit hit
-                else if (candle.low <= takeProfit) {
-                    outcome = TradeOutcome::WinAtTP1;
-                    tradeFinished = true;
-                }
-            }
-            
-            // Limit maximum trade duration 
-            if (i >= entryIndex + 100) {
-                // If trade doesn't hit SL or TP within 100 candles, close at current price
-                double closePrice = candle.close;
-                
-                if (isLong) {
-                    if (closePrice > entryPrice) {
-                        outcome = TradeOutcome::WinAtTP1;
-                    } else if (closePrice < entryPrice) {
-                        outcome = TradeOutcome::LossAtSL;
-                    } else {
-                        outcome = TradeOutcome::BreakEven;
-                    }
-                } else {
-                    if (closePrice < entryPrice) {
-                        outcome = TradeOutcome::WinAtTP1;
-                    } else if (closePrice > entryPrice) {
-                        outcome = TradeOutcome::LossAtSL;
-                    } else {
-                        outcome = TradeOutcome::BreakEven;
-                    }
-                }
-                
-                tradeFinished = true;
-            }
+        BacktestTrade trade;
+        trade.entryIndex = static_cast<std::uint32_t>(entryIndex);
+        trade.exitIndex = static_cast<std::uint32_t>(exit.exitIndex);
+        trade.entryTime = series.timestamp()[entryIndex];
+        trade.exitTime = series.timestamp()[exit.exitIndex];
+        trade.entryPrice = entryPrice;
+        trade.stopLoss = stopLoss;
+        trade.takeProfit = takeProfit;
+        trade.riskPercent = m_config.riskPerTrade;
+        trade.isLong = isLong;
+        trade.outcome = exit.outcome;
+        
+        // Current account balance for risk calculation
+        trade.balanceBefore = result.equityCurve.back();
+        
+        // Size the position (forex, standard lots) with SL given as a price
+        TradeParameters params;
+        params.accountBalance = trade.balanceBefore;
+        params.riskPercent = trade.riskPercent;
+        params.entryPrice = entryPrice;
+        params.stopLossPrice = stopLoss;
+        params.isStopLossPriceOverride = true;
+        params.takeProfitInPips = std::abs(takeProfit - entryPrice) / 0.0001;
+        params.instrumentType = InstrumentType::Forex;
+        params.lotSizeType = LotSizeType::Standard;
+        params.timestamp = static_cast<std::time_t>(trade.entryTime);
+        
+        try {
+            TradeResults sizing = calculator.calculateTrade(params);
+            trade.positionSize = sizing.positionSize;
+            trade.riskAmount = sizing.riskAmount;
+            trade.rewardAmount = sizing.rewardAmount;
+            trade.riskRewardRatio = sizing.riskRewardRatio;
+        } catch (const std::exception& e) {
+            Utils::printError("Calculation error: " + std::string(e.what()));
         }
         
-        // If we ran out of data before the trade completed, close it at the last price
-        if (!tradeFinished && !m_priceData.empty()) {
-            outcome = TradeOutcome::Pending;
-            return false;
+        // Book P&L the same way as EquityAccumulator
+        if (trade.isWin()) {
+            trade.pnl = trade.rewardAmount;
+        } else if (trade.isLoss()) {
+            trade.pnl = -trade.riskAmount;
         }
+        trade.balanceAfter = trade.balanceBefore + trade.pnl;
         
-        // Complete the trade
-        trade->simulateOutcome(outcome);
+        // Update equity and drawdown curves
+        result.equityCurve.push_back(trade.balanceAfter);
+        result.drawdownCurve.push_back(equity.push(trade));
         
-        // Update equity curve
-        double newBalance = trade->getUpdatedAccountBalance();
-        result.equityCurve.push_back(newBalance);
+        result.trades.push_back(trade);
+        if (fromTicks) {
+            result.tickResolvedExits++;
+        }
+        return true;
+    }
+    
+    bool Backtester::resolveFromTicks(size_t entryIndex, bool isLong, double stopLoss, double takeProfit,
+                                      ExitResolution& exit) const {
+        // Only an SL exit can be ambiguous: it is the first bar touching either
+        // level, and SL wins ties. Holding-limit exits close at the bar's close.
+        if (!m_ticks || !exit.finished || exit.outcome != TradeOutcome::LossAtSL ||
+            exit.exitIndex >= entryIndex + ExitResolver::MAX_HOLDING_BARS) {
+            return false;
+        }
         
-        // Update drawdown curve
-        double peakBalance = *std::max_element(result.equityCurve.begin(), result.equityCurve.end());
-        double currentDrawdown = (peakBalance - newBalance) / peakBalance * 100.0;
-        result.drawdownCurve.push_back(currentDrawdown);
+        const CandleSeries& series = *m_series;
+        size_t bar = exit.exitIndex;
+        bool targetTouched = isLong ? series.high()[bar] >= takeProfit : series.low()[bar] <= takeProfit;
+        if (!targetTouched) {
+            return false;
+        }
         
-        // Add trade to results
-        result.trades.push_back(trade);
+        // The bar's ticks run up to the next bar's open time (seconds -> ms)
+        std::int64_t from = series.timestamp()[bar] * 1000;
+        std::int64_t to = (bar + 1 < series.size()) ? series.timestamp()[bar + 1] * 1000
+                                                    : std::numeric_limits<std::int64_t>::max();
         
+        // Without ticks that reach a level, keep the bar rule
+        TickTouch touch = m_ticks->firstTouch(from, to, isLong, stopLoss, takeProfit);
+        if (touch == TickTouch::None) {
+            return false;
+        }
+        exit.outcome = (touch == TickTouch::TakeProfit) ? TradeOutcome::WinAtTP1 : TradeOutcome::LossAtSL;
         return true;
     }
     
@@ -378,27 +344,18 @@ namespace Backtest {
         double balance = m_config.initialBalance;
         for (size_t i = 0; i < m_lastResult.trades.size(); ++i) {
             const auto& trade = m_lastResult.trades[i];
-            auto results = trade->getResults();
             
             // Update balance
-            if (trade->getOutcome() == TradeOutcome::WinAtTP1 || 
-                trade->getOutcome() == TradeOutcome::WinAtTP2) {
-                balance += results.rewardAmount;
-            } else if (trade->getOutcome() == TradeOutcome::LossAtSL) {
-                balance -= results.riskAmount;
-            }
+            balance += trade.pnl;
             
             file << i + 1 << ","
-                 << trade->getParameters().entryPrice << ","
-                 << results.stopLossPrice << ","
-                 << results.takeProfitPrice << ","
-                 << trade->getOutcomeAsString() << ",";
+                 << trade.entryPrice << ","
+                 << trade.stopLoss << ","
+                 << trade.takeProfit << ","
+                 << outcomeToString(trade.outcome) << ",";
                  
-            if (trade->getOutcome() == TradeOutcome::WinAtTP1 || 
-                trade->getOutcome() == TradeOutcome::WinAtTP2) {
-                file << results.rewardAmount;
-            } else if (trade->getOutcome() == TradeOutcome::LossAtSL) {
-                file << -results.riskAmount;
+            if (trade.isWin() || trade.isLoss()) {
+                file << trade.pnl;
             } else {
                 file << "0.00";
             }
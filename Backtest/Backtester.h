@@ -6,15 +6,33 @@
 #include <memory>
 #include "../Trade.h"
 #include "../Analytics/EquityStats.h"
+#include "CandleSeries.h"
+#include "SignalScanner.h"
+#include "ExitResolver.h"
+#include "BacktestTrade.h"
+#include "Resampler.h"
+
+class TradeCalculator;
 
 namespace Backtest {
-    struct CandleData {
-        std::time_t timestamp;
-        double open;
-        double high;
-        double low;
-        double close;
-        double volume = 0.0;
+    class TickData;
+    
+    // How loadPriceData reads CSV files
+    enum class LoaderMode {
+        Stream,        // iostream parsing, local-time timestamps
+        MemoryMapped   // In-place parsing of a mapped file, UTC timestamps
+    };
+    
+    // Throughput of the last loadPriceData call
+    struct LoaderStats {
+        size_t rows = 0;
+        size_t rejectedRows = 0;   // Malformed rows skipped by the mapped loader
+        size_t bytes = 0;
+        double seconds = 0.0;
+        double rowsPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+        bool sortSkipped = false;  // Input was already in timestamp order
+        bool fromCache = false;    // Served from the binary candle cache
     };
     
     enum class StrategyType {
@@ -39,9 +57,19 @@ namespace Backtest {
         bool shortEnabled = true;
     };
     
+    // Half-open range of bars [begin, end) within a loaded series
+    struct BarRange {
+        static constexpr size_t npos = static_cast<size_t>(-1);
+        
+        size_t begin = 0;
+        size_t end = npos;  // npos = to the end of the series
+        
+        size_t size() const { return end - begin; }
+    };
+    
     // Result of a backtest run
     struct BacktestResult {
-        std::vector<std::shared_ptr<Trade>> trades;
+        std::vector<BacktestTrade> trades;  // Use toTrades() for full Trade objects
         Analytics::EquityStats stats;
         std::vector<double> equityCurve;
         std::vector<double> drawdownCurve;
@@ -52,6 +80,7 @@ namespace Backtest {
         double winRate = 0.0;
         double profitFactor = 0.0;
         double netProfit = 0.0;
+        int tickResolvedExits = 0;  // Bars touching both SL and TP settled from ticks
     };
     
     class Backtester {
@@ -65,6 +94,56 @@ namespace Backtest {
         // Load data from CSV file
         bool loadPriceData(const std::string& filename);
         
+        // Select the CSV reader. Stream is the default so timestamps keep their
+        // local-time meaning; MemoryMapped is faster but reads them as UTC.
+        void setLoaderMode(LoaderMode mode) { m_loaderMode = mode; }
+        LoaderMode getLoaderMode() const { return m_loaderMode; }
+        
+        // Reuse/maintain the binary cache written next to each CSV (on by default)
+        void setUseCandleCache(bool useCache) { m_useCandleCache = useCache; }
+        bool getUseCandleCache() const { return m_useCandleCache; }
+        
+        // Rows/bytes per second of the last load
+        const LoaderStats& getLoaderStats() const { return m_loaderStats; }
+        
+        // Loaded candles (shared, never modified after loading)
+        std::shared_ptr<const CandleSeries> getPriceData() const { return m_series; }
+        
+        // Use candles loaded elsewhere; scans signals and builds exit tables
+        void setPriceData(std::shared_ptr<const CandleSeries> series);
+        
+        // Use another backtester's candles, entry signals and exit tables as
+        // they are (no copy, no rescan). Several backtesters can then run
+        // different configs over one load, each from its own thread.
+        void sharePriceData(const Backtester& source);
+        
+        bool hasPriceData() const { return m_series != nullptr; }
+        
+        // Higher timeframes built from every load (none by default). Loads
+        // from a CSV keep them in per-timeframe caches next to the file.
+        void setTimeframes(const std::vector<Timeframe>& timeframes) { m_timeframeList = timeframes; }
+        
+        // Higher-timeframe bars and base-to-bar lookups for the loaded data
+        // (null unless timeframes were requested before loading)
+        std::shared_ptr<const MultiTimeframeSeries> getTimeframes() const { return m_timeframes; }
+        
+        // Optional tick/quote stream ("timestamp,bid,ask") for exits on bars
+        // that touch both SL and TP, where bars alone have to assume SL came
+        // first. Every other exit stays on the bar path. The CSV is converted
+        // once to a mapped binary file next to it ("<csv>.ttk"). Tick times
+        // are read in the loader mode's time base, so set the mode before
+        // loading either file.
+        bool loadTickData(const std::string& filename);
+        void setTickData(std::shared_ptr<const TickData> ticks) { m_ticks = std::move(ticks); }
+        std::shared_ptr<const TickData> getTickData() const { return m_ticks; }
+        
+        // Restrict runs to a slice of the loaded series without copying it.
+        // Entries are taken inside the range and trades must close before its
+        // end (ones still open are left out, as at the end of the data).
+        // Bars before the range may still be read as history.
+        void setRange(const BarRange& range) { m_range = range; }
+        const BarRange& getRange() const { return m_range; }
+        
         // Run backtest
         BacktestResult runBacktest();
         
@@ -76,13 +155,27 @@ namespace Backtest {
         
     private:
         BacktestConfig m_config;
-        std::vector<CandleData> m_priceData;
+        std::shared_ptr<const CandleSeries> m_series;
+        std::shared_ptr<const SignalMask> m_signals;  // Entry signals for m_series, computed once per load
+        std::shared_ptr<const ExitResolver> m_exitResolver;  // SL/TP lookup over m_series
+        std::vector<Timeframe> m_timeframeList;
+        std::shared_ptr<const MultiTimeframeSeries> m_timeframes;
+        std::shared_ptr<const TickData> m_ticks;  // Intrabar order for ambiguous exits
+        BarRange m_range;
         BacktestResult m_lastResult;
+        LoaderMode m_loaderMode = LoaderMode::Stream;
+        LoaderStats m_loaderStats;
+        bool m_useCandleCache = true;
         
         // Helper methods
-        bool detectEntry(int index, bool& isLong) const;
+        void attachPriceData(std::shared_ptr<const CandleSeries> series,
+                             std::shared_ptr<const MultiTimeframeSeries> timeframes);
+        size_t rangeEndIndex() const;
+        bool resolveFromTicks(size_t entryIndex, bool isLong, double stopLoss, double takeProfit,
+                              ExitResolution& exit) const;
         std::pair<double, double> calculateStopLossAndTakeProfit(int index, bool isLong) const;
-        bool simulateTrade(int entryIndex, bool isLong, BacktestResult& result);
+        bool simulateTrade(int entryIndex, bool isLong, const TradeCalculator& calculator,
+                           BacktestResult& result, Analytics::EquityAccumulator& equity);
     };
 }
 
@@ -8,12 +8,16 @@
 #include <iomanip>
 #include <ctime>
 #include <thread>
-#include <future>
+#include <atomic>
 #include <mutex>
 #include <chrono>
 #include <spdlog/spdlog.h>
 #include <matplot/matplot.h>
 #include "EquityCurveGenerator.h"
+#include "ChartRenderQueue.h"
+#include "DurationHistory.h"
+#include "MemoryBudget.h"
+#include "../Utils/WorkStealingPool.h"
 
 // Platform-specific memory tracking
 #if defined(_WIN32)
@@ -32,7 +36,8 @@ void to_json(nlohmann::json& j, const BatchConfig& config) {
         {"performance", {
             {"thread_count", config.threadCount},
             {"batch_size", config.batchSize},
-            {"memory_limit_mb", config.memoryLimitMB}
+            {"memory_limit_mb", config.memoryLimitMB},
+            {"schedule_longest_first", config.scheduleLongestFirst}
         }},
         {"output", {
             {"formats", config.outputFormats},
@@ -40,7 +45,8 @@ void to_json(nlohmann::json& j, const BatchConfig& config) {
             {"chart_width", config.chartWidth},
             {"chart_height", config.chartHeight},
             {"chart_dpi", config.chartDPI},
-            {"include_charts_in_report", config.includeChartsInReport}
+            {"include_charts_in_report", config.includeChartsInReport},
+            {"chart_mode", config.chartMode}
         }},
         {"paths", {
             {"strategy_dir", config.strategyDir},
@@ -52,6 +58,14 @@ void to_json(nlohmann::json& j, const BatchConfig& config) {
             {"file", config.logFile},
             {"console", config.consoleOutput},
             {"performance_metrics", config.trackPerformance}
+        }},
+        {"robustness", {
+            {"enabled", config.robustnessEnabled},
+            {"methods", config.robustnessMethods},
+            {"samples", config.robustnessSamples},
+            {"seed", config.robustnessSeed},
+            {"block_length", config.robustnessBlockLength},
+            {"skip_probability", config.robustnessSkipProbability}
         }}
     };
 }
@@ -63,6 +77,7 @@ void from_json(const nlohmann::json& j, BatchConfig& config) {
         if (perf.contains("thread_count")) config.threadCount = perf["thread_count"];
         if (perf.contains("batch_size")) config.batchSize = perf["batch_size"];
         if (perf.contains("memory_limit_mb")) config.memoryLimitMB = perf["memory_limit_mb"];
+        if (perf.contains("schedule_longest_first")) config.scheduleLongestFirst = perf["schedule_longest_first"];
     }
     
     // Output settings
@@ -74,6 +89,7 @@ void from_json(const nlohmann::json& j, BatchConfig& config) {
         if (output.contains("chart_height")) config.chartHeight = output["chart_height"];
         if (output.contains("chart_dpi")) config.chartDPI = output["chart_dpi"];
         if (output.contains("include_charts_in_report")) config.includeChartsInReport = output["include_charts_in_report"];
+        if (output.contains("chart_mode")) config.chartMode = output["chart_mode"];
     }
     
     // Path settings
@@ -93,6 +109,17 @@ void from_json(const nlohmann::json& j, BatchConfig& config) {
         if (logging.contains("performance_metrics")) config.trackPerformance = logging["performance_metrics"];
     }
     
+    // Robustness settings
+    if (j.contains("robustness")) {
+        const auto& robustness = j["robustness"];
+        if (robustness.contains("enabled")) config.robustnessEnabled = robustness["enabled"];
+        if (robustness.contains("methods")) config.robustnessMethods = robustness["methods"].get<std::vector<std::string>>();
+        if (robustness.contains("samples")) config.robustnessSamples = robustness["samples"];
+        if (robustness.contains("seed")) config.robustnessSeed = robustness["seed"];
+        if (robustness.contains("block_length")) config.robustnessBlockLength = robustness["block_length"];
+        if (robustness.contains("skip_probability")) config.robustnessSkipProbability = robustness["skip_probability"];
+    }
+    
     // Backtest settings
     if (j.contains("backtest")) {
         const auto& backtest = j["backtest"];
@@ -116,6 +143,16 @@ BatchBacktester::BatchBacktester() {
     applyDefaultConfig();
 }
 
+BatchBacktester::~BatchBacktester() = default;
+
+Utils::WorkStealingPool& BatchBacktester::getThreadPool(unsigned int threadCount) {
+    if (!m_pool || m_pool->size() != threadCount) {
+        m_pool.reset();
+        m_pool = std::make_unique<Utils::WorkStealingPool>(threadCount);
+    }
+    return *m_pool;
+}
+
 void BatchBacktester::applyDefaultConfig() {
     // Performance defaults
     if (m_batchConfig.threadCount == 0) {
@@ -270,103 +307,210 @@ BatchBacktestResults BatchBacktester::runBatchBacktest() {
     
     spdlog::info("Using {} threads for parallel processing", numThreads);
     
-    // Create thread pool
-    std::vector<std::future<void>> futures;
-    std::mutex resultsMutex;
-    std::atomic<int> completedTests{0};
+    // Persistent pool; batchSize bounds how many strategies wait in its queues
+    const size_t batchSize = std::max<size_t>(m_batchConfig.batchSize, 1);
+    Utils::WorkStealingPool& pool = getThreadPool(numThreads);
+    pool.setQueueCapacity(batchSize);
     
-    // Track strategy durations for performance metrics
-    std::map<std::string, std::chrono::milliseconds> strategyDurations;
-    std::mutex durationMutex;
+    // Finished strategies, one slot per input file
+    struct StrategyRun {
+        bool completed = false;
+        std::string strategyName;
+        BacktestResult result;
+        std::vector<Analytics::ResampleResult> robustness;
+        std::chrono::milliseconds duration{0};
+    };
+    Utils::CompletionChannel<StrategyRun> completions(m_strategyFiles.size());
+    
+    // Admission control: memoryLimitMB covers the whole process, so strategies
+    // share what is left above the memory already in use
+    size_t memoryLimitBytes = m_batchConfig.memoryLimitMB * 1024 * 1024;
+    size_t strategyBudgetBytes = 0;
+    if (memoryLimitBytes > 0) {
+        strategyBudgetBytes = (memoryLimitBytes > initialMemory) ? memoryLimitBytes - initialMemory : 1;
+    }
+    MemoryBudget memoryBudget(strategyBudgetBytes);
     
     // Track peak memory usage
     std::atomic<size_t> peakMemoryUsage{initialMemory};
     
-    // Process strategies in batches to manage memory
-    const size_t batchSize = m_batchConfig.batchSize;
-    size_t batchesProcessed = 0;
-    
-    for (size_t i = 0; i < m_strategyFiles.size(); i += batchSize) {
-        size_t endIdx = std::min(i + batchSize, m_strategyFiles.size());
-        batchesProcessed++;
-        
-        spdlog::info("Processing batch {}/{} (strategies {}-{})", 
-                   batchesProcessed, 
-                   (m_strategyFiles.size() + batchSize - 1) / batchSize,
-                   i + 1, endIdx);
-        
-        for (size_t j = i; j < endIdx; ++j) {
-            futures.push_back(std::async(std::launch::async, [&, j]() {
-                try {
-                    const std::string& filePath = m_strategyFiles[j];
-                    std::string strategyName = std::filesystem::path(filePath).stem().string();
-                    
-                    spdlog::info("Processing strategy: {}", strategyName);
-                    
-                    // Start timing for strategy duration
-                    auto strategyStartTime = std::chrono::high_resolution_clock::now();
-                    
-                    // Run backtest
-                    Backtester backtester;
-                    backtester.setConfig(m_commonConfig);
-                    backtester.loadData(filePath);
-                    BacktestResult result = backtester.runBacktest();
-                    
-                    // Generate equity curve image
-                    std::string imagePath = generateEquityCurveImage(strategyName, result);
-                    
-                    // Update results thread-safely
-                    {
-                        std::lock_guard<std::mutex> lock(resultsMutex);
-                        m_results.strategyNames.push_back(strategyName);
-                        m_results.results[strategyName] = result;
-                        m_results.equityCurveImages[strategyName] = imagePath;
-                    }
-                    
-                    // Record strategy duration
-                    auto strategyEndTime = std::chrono::high_resolution_clock::now();
-                    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                        strategyEndTime - strategyStartTime);
-                    
-                    {
-                        std::lock_guard<std::mutex> lock(durationMutex);
-                        strategyDurations[strategyName] = duration;
+    // Reported for compatibility: number of batchSize-sized groups submitted
+    size_t batchesProcessed = (m_strategyFiles.size() + batchSize - 1) / batchSize;
+    
+    // Longest expected strategies first, so a slow file does not start last
+    DurationHistory history((std::filesystem::path(m_batchConfig.outputDir) / DurationHistory::FILE_NAME).string());
+    history.load();
+    
+    std::vector<std::string> fingerprints(m_strategyFiles.size());
+    std::vector<std::uintmax_t> fileSizes(m_strategyFiles.size(), 0);
+    std::vector<double> estimates(m_strategyFiles.size(), 0.0);
+    std::vector<size_t> order(m_strategyFiles.size());
+    size_t knownDurations = 0;
+    for (size_t j = 0; j < m_strategyFiles.size(); ++j) {
+        std::error_code ec;
+        fileSizes[j] = std::filesystem::file_size(m_strategyFiles[j], ec);
+        if (ec) fileSizes[j] = 0;
+        fingerprints[j] = DurationHistory::fingerprint(m_strategyFiles[j]);
+        
+        std::chrono::milliseconds recorded{0};
+        if (history.lookup(m_strategyFiles[j], fingerprints[j], recorded)) {
+            knownDurations++;
+        }
+        estimates[j] = history.estimate(m_strategyFiles[j], fingerprints[j], fileSizes[j]);
+        order[j] = j;
+    }
+    
+    if (m_batchConfig.scheduleLongestFirst) {
+        std::stable_sort(order.begin(), order.end(), [&estimates](size_t a, size_t b) {
+            return estimates[a] > estimates[b];
+        });
+        spdlog::info("Scheduling longest strategies first ({}/{} with recorded durations)",
+                   knownDurations, m_strategyFiles.size());
+    }
+    
+    // MatPlot++ is not thread-safe, so charts are drawn on one renderer thread
+    // while the workers move on to the next strategy. Queued curve copies are
+    // charged to the memory budget until they have been drawn.
+    std::unique_ptr<ChartRenderQueue> chartQueue;
+    if (m_batchConfig.chartMode == "async") {
+        chartQueue = std::make_unique<ChartRenderQueue>(
+            [this, &memoryBudget](const std::string& name, const BacktestResult& curves) {
+                std::string image = generateEquityCurveImage(name, curves);
+                memoryBudget.releaseRetained(ChartRenderQueue::chartBytes(curves));
+                return image;
+            },
+            batchSize);
+    } else if (m_batchConfig.chartMode == "deferred") {
+        spdlog::info("Deferred chart mode: saving curves to {}", chartDataDir());
+    } else if (m_batchConfig.chartMode != "none") {
+        spdlog::warn("Unknown chart mode '{}'; charts disabled", m_batchConfig.chartMode);
+    }
+    
+    // Results move into m_results in input order, as soon as every earlier
+    // strategy has finished, so reports do not depend on completion order.
+    std::map<std::string, std::chrono::milliseconds> strategyDurations;
+    size_t nextMerge = 0;
+    auto mergeFinished = [&]() {
+        for (; nextMerge < completions.slots() && completions.ready(nextMerge); ++nextMerge) {
+            StrategyRun& run = completions.get(nextMerge);
+            if (run.completed) {
+                m_results.strategyNames.push_back(run.strategyName);
+                m_results.results[run.strategyName] = std::move(run.result);
+                if (!run.robustness.empty()) {
+                    m_results.robustness[run.strategyName] = std::move(run.robustness);
+                }
+                strategyDurations[run.strategyName] = run.duration;
+                history.record(m_strategyFiles[nextMerge], fingerprints[nextMerge], fileSizes[nextMerge], run.duration);
+            }
+        }
+    };
+    
+    for (size_t j : order) {
+        mergeFinished();
+        
+        size_t footprint = MemoryBudget::estimateStrategyBytes(m_strategyFiles[j]);
+        if (memoryBudget.acquire(footprint)) {
+            spdlog::debug("Held back {} until {:.1f} MB fit in the memory budget",
+                        m_strategyFiles[j], footprint / (1024.0 * 1024.0));
+        }
+        
+        pool.submit([&, j, footprint]() {
+            StrategyRun run;
+            try {
+                const std::string& filePath = m_strategyFiles[j];
+                run.strategyName = std::filesystem::path(filePath).stem().string();
+                
+                spdlog::info("Processing strategy: {}", run.strategyName);
+                
+                // Start timing for strategy duration
+                auto strategyStartTime = std::chrono::high_resolution_clock::now();
+                
+                // Run backtest
+                Backtester backtester;
+                backtester.setConfig(m_commonConfig);
+                if (!backtester.loadPriceData(filePath)) {
+                    throw std::runtime_error("No price data loaded from " + filePath);
+                }
+                
+                const LoaderStats& loaderStats = backtester.getLoaderStats();
+                spdlog::debug("Loaded {} rows from {} in {:.3f}s ({:.0f} rows/s, {:.1f} MB/s)",
+                            loaderStats.rows, run.strategyName, loaderStats.seconds,
+                            loaderStats.rowsPerSecond, loaderStats.bytesPerSecond / (1024.0 * 1024.0));
+                
+                run.result = backtester.runBacktest();
+                
+                // Resampled trade orders; samples spread over this same pool
+                if (m_batchConfig.robustnessEnabled) {
+                    run.robustness = runRobustness(run.result, pool);
+                }
+                
+                // Hand the curves off for rendering
+                if (chartQueue) {
+                    size_t chartBytes = ChartRenderQueue::chartBytes(run.result);
+                    memoryBudget.retain(chartBytes);
+                    if (!chartQueue->push(run.strategyName, run.result)) {
+                        memoryBudget.releaseRetained(chartBytes);
                     }
-                    
-                    // Update memory usage if tracking is enabled
-                    if (m_batchConfig.trackPerformance) {
-                        size_t currentMemory = getCurrentMemoryUsage();
-                        size_t expected = peakMemoryUsage.load();
-                        while (currentMemory > expected && 
-                               !peakMemoryUsage.compare_exchange_weak(expected, currentMemory)) {
-                            // Keep trying until we succeed or another thread sets a higher value
-                        }
+                } else if (m_batchConfig.chartMode == "deferred" &&
+                           !saveChartData(run.strategyName, run.result)) {
+                    spdlog::warn("Could not save chart data for {}", run.strategyName);
+                }
+                
+                // Record strategy duration
+                auto strategyEndTime = std::chrono::high_resolution_clock::now();
+                run.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    strategyEndTime - strategyStartTime);
+                run.completed = true;
+                
+                // Update memory usage if tracking is enabled
+                if (m_batchConfig.trackPerformance) {
+                    size_t currentMemory = getCurrentMemoryUsage();
+                    size_t expected = peakMemoryUsage.load();
+                    while (currentMemory > expected && 
+                           !peakMemoryUsage.compare_exchange_weak(expected, currentMemory)) {
+                        // Keep trying until we succeed or another thread sets a higher value
                     }
-                    
-                    completedTests++;
-                    spdlog::info("Completed strategy {} ({}/{}) in {:.2f} seconds", 
-                               strategyName, completedTests.load(), m_strategyFiles.size(),
-                               duration.count() / 1000.0);
-                    
-                } catch (const std::exception& e) {
-                    spdlog::error("Error processing strategy {}: {}", 
-                               m_strategyFiles[j], e.what());
                 }
-            }));
+            } catch (const std::exception& e) {
+                spdlog::error("Error processing strategy {}: {}", 
+                           m_strategyFiles[j], e.what());
+            }
             
-            // Wait if we've reached the thread limit
-            if (futures.size() >= numThreads) {
-                for (auto& future : futures) {
-                    future.wait();
-                }
-                futures.clear();
+            // Candles are gone now, but the result stays in m_results for the
+            // reports, so its memory stays charged for the rest of the batch
+            memoryBudget.release(footprint);
+            if (run.completed) {
+                memoryBudget.retain(run.result.trades.capacity() * sizeof(BacktestTrade) +
+                    (run.result.equityCurve.capacity() + run.result.drawdownCurve.capacity()) * sizeof(double));
             }
-        }
+            
+            std::string strategyName = run.strategyName;
+            bool completed = run.completed;
+            double seconds = run.duration.count() / 1000.0;
+            size_t finished = completions.publish(j, std::move(run));
+            if (completed) {
+                spdlog::info("Completed strategy {} ({}/{}) in {:.2f} seconds", 
+                           strategyName, finished, m_strategyFiles.size(), seconds);
+            }
+        });
     }
     
     // Wait for remaining tasks
-    for (auto& future : futures) {
-        future.wait();
+    pool.waitIdle();
+    mergeFinished();
+    
+    if (chartQueue) {
+        std::map<std::string, std::string> chartImages = chartQueue->finish();
+        for (const auto& strategyName : m_results.strategyNames) {
+            auto image = chartImages.find(strategyName);
+            if (image != chartImages.end()) {
+                m_results.equityCurveImages[strategyName] = image->second;
+            }
+        }
+    }
+    
+    if (!history.save()) {
+        spdlog::warn("Could not write strategy duration history to {}", m_batchConfig.outputDir);
     }
     
     // Calculate aggregate statistics
@@ -379,6 +523,10 @@ BatchBacktestResults BatchBacktester::runBatchBacktest() {
     m_results.performance.totalDuration = totalDuration;
     m_results.performance.peakMemoryUsageMB = peakMemoryUsage.load() / (1024 * 1024);
     m_results.performance.batchesProcessed = batchesProcessed;
+    m_results.performance.memoryBudgetMB = strategyBudgetBytes / (1024 * 1024);
+    m_results.performance.admissionThrottles = memoryBudget.getThrottleCount();
+    m_results.performance.admissionWait = memoryBudget.getThrottleTime();
+    m_results.performance.peakReservedMemoryMB = memoryBudget.getPeakReservedBytes() / (1024 * 1024);
     
     // Calculate average and max strategy durations
     if (!strategyDurations.empty()) {
@@ -408,6 +556,10 @@ BatchBacktestResults BatchBacktester::runBatchBacktest() {
                    m_results.performance.maxStrategyDuration.count() / 1000.0,
                    m_results.performance.slowestStrategy);
         spdlog::info("  Peak memory usage: {} MB", m_results.performance.peakMemoryUsageMB);
+        spdlog::info("  Memory admission: {} throttles, {:.2f} seconds waiting, {} MB peak reserved",
+                   m_results.performance.admissionThrottles,
+                   m_results.performance.admissionWait.count() / 1000.0,
+                   m_results.performance.peakReservedMemoryMB);
     }
     
     return m_results;
@@ -517,6 +669,17 @@ std::string BatchBacktester::generateStrategySection(const std::string& strategy
        << result.sharpeRatio << "\n";
     ss << "- Number of Trades: " << result.numTrades << "\n\n";
     
+    // Percentile tables from trade resampling
+    auto robustness = m_results.robustness.find(strategyName);
+    if (robustness != m_results.robustness.end()) {
+        ss << "### Robustness\n\n";
+        for (const auto& resampled : robustness->second) {
+            ss << "#### " << Analytics::TradeResampler::methodName(resampled.method)
+               << " (" << resampled.numSamples << " samples of " << resampled.numTrades << " trades)\n\n";
+            ss << Analytics::TradeResampler::toMarkdown(resampled) << "\n";
+        }
+    }
+    
     // Add equity curve image if available
     auto it = m_results.equityCurveImages.find(strategyName);
     if (it != m_results.equityCurveImages.end()) {
@@ -527,6 +690,30 @@ std::string BatchBacktester::generateStrategySection(const std::string& strategy
     return ss.str();
 }
 
+std::vector<Analytics::ResampleResult> BatchBacktester::runRobustness(const BacktestResult& result,
+                                                                     Utils::WorkStealingPool& pool) const {
+    std::vector<Analytics::ResampleResult> tables;
+    Analytics::TradeResampler resampler =
+        Analytics::TradeResampler::fromTrades(result.trades, m_commonConfig.initialBalance);
+    if (resampler.getReturns().empty()) {
+        return tables;
+    }
+    
+    for (const auto& name : m_batchConfig.robustnessMethods) {
+        Analytics::ResampleParams params;
+        if (!Analytics::TradeResampler::parseMethod(name, params.method)) {
+            spdlog::warn("Unknown resampling method '{}'; skipped", name);
+            continue;
+        }
+        params.numSamples = m_batchConfig.robustnessSamples;
+        params.seed = m_batchConfig.robustnessSeed;
+        params.blockLength = m_batchConfig.robustnessBlockLength;
+        params.skipProbability = m_batchConfig.robustnessSkipProbability;
+        tables.push_back(resampler.run(params, pool));
+    }
+    return tables;
+}
+
 void BatchBacktester::clearStrategyFiles() {
     m_strategyFiles.clear();
     m_results = BatchBacktestResults();
@@ -606,6 +793,83 @@ std::string BatchBacktester::generateEquityCurveImage(const std::string& strateg
     }
 }
 
+std::string BatchBacktester::chartDataDir() const {
+    return (std::filesystem::path(m_batchConfig.outputDir) / "curves").string();
+}
+
+bool BatchBacktester::saveChartData(const std::string& strategyName, const BacktestResult& result) const {
+    try {
+        std::error_code ec;
+        std::filesystem::create_directories(chartDataDir(), ec);
+        
+        nlohmann::json j = {
+            {"strategy", strategyName},
+            {"equity_curve", result.equityCurve},
+            {"drawdown_curve", result.drawdownCurve},
+            {"total_trades", result.totalTrades},
+            {"win_rate", result.winRate},
+            {"profit_factor", result.profitFactor},
+            {"net_profit", result.netProfit}
+        };
+        
+        std::ofstream file(std::filesystem::path(chartDataDir()) / (strategyName + ".json"));
+        if (!file.is_open()) {
+            return false;
+        }
+        file << j.dump();
+        return static_cast<bool>(file);
+    } catch (const std::exception& e) {
+        spdlog::error("Error saving chart data for {}: {}", strategyName, e.what());
+        return false;
+    }
+}
+
+size_t BatchBacktester::renderSavedCharts(const std::string& curvesDir) {
+    std::string dir = curvesDir.empty() ? chartDataDir() : curvesDir;
+    if (!std::filesystem::is_directory(dir)) {
+        spdlog::error("Chart data directory does not exist: {}", dir);
+        return 0;
+    }
+    
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".json") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    
+    // Rendering stays on this thread; MatPlot++ is not thread-safe
+    size_t rendered = 0;
+    for (const auto& path : files) {
+        try {
+            std::ifstream file(path);
+            nlohmann::json j;
+            file >> j;
+            
+            BacktestResult curves;
+            std::string strategyName = j.value("strategy", path.stem().string());
+            curves.equityCurve = j.value("equity_curve", std::vector<double>());
+            curves.drawdownCurve = j.value("drawdown_curve", std::vector<double>());
+            curves.totalTrades = j.value("total_trades", 0);
+            curves.winRate = j.value("win_rate", 0.0);
+            curves.profitFactor = j.value("profit_factor", 0.0);
+            curves.netProfit = j.value("net_profit", 0.0);
+            
+            std::string imagePath = generateEquityCurveImage(strategyName, curves);
+            if (!imagePath.empty()) {
+                m_results.equityCurveImages[strategyName] = imagePath;
+                rendered++;
+            }
+        } catch (const std::exception& e) {
+            spdlog::error("Error reading chart data {}: {}", path.string(), e.what());
+        }
+    }
+    
+    spdlog::info("Rendered charts for {}/{} saved strategies", rendered, files.size());
+    return rendered;
+}
+
 size_t BatchBacktester::getCurrentMemoryUsage() const {
 #if defined(_WIN32)
     PROCESS_MEMORY_COUNTERS_EX pmc;
@@ -642,7 +906,11 @@ bool BatchBacktester::exportJsonReport(const std::string& filename) const {
             {"max_strategy_duration_ms", m_results.performance.maxStrategyDuration.count()},
             {"slowest_strategy", m_results.performance.slowestStrategy},
             {"peak_memory_mb", m_results.performance.peakMemoryUsageMB},
-            {"batches_processed", m_results.performance.batchesProcessed}
+            {"batches_processed", m_results.performance.batchesProcessed},
+            {"memory_budget_mb", m_results.performance.memoryBudgetMB},
+            {"admission_throttles", m_results.performance.admissionThrottles},
+            {"admission_wait_ms", m_results.performance.admissionWait.count()},
+            {"peak_reserved_memory_mb", m_results.performance.peakReservedMemoryMB}
         };
         
         // Add individual strategy results
@@ -666,6 +934,48 @@ bool BatchBacktester::exportJsonReport(const std::string& filename) const {
                 strategyJson["equity_curve_image"] = it->second;
             }
             
+            // Add trade-resampling percentile tables if available
+            auto robustness = m_results.robustness.find(stratName);
+            if (robustness != m_results.robustness.end()) {
+                nlohmann::json methods = nlohmann::json::array();
+                for (const auto& resampled : robustness->second) {
+                    // Statistics every sample shares (e.g. balance under shuffling) are left out
+                    bool withBalance = Analytics::TradeResampler::statisticVaries(
+                        resampled.method, Analytics::ResampleStatistic::FinalBalance);
+                    bool withSharpe = Analytics::TradeResampler::statisticVaries(
+                        resampled.method, Analytics::ResampleStatistic::SharpeRatio);
+                    nlohmann::json percentiles = nlohmann::json::array();
+                    for (const auto& row : resampled.percentiles) {
+                        nlohmann::json rowJson = {
+                            {"percentile", row.percentile},
+                            {"max_drawdown_percent", row.maxDrawdownPercent}
+                        };
+                        if (withBalance) {
+                            rowJson["final_balance"] = row.finalBalance;
+                        }
+                        if (withSharpe) {
+                            rowJson["sharpe_ratio"] = row.sharpeRatio;
+                        }
+                        percentiles.push_back(rowJson);
+                    }
+                    nlohmann::json methodJson = {
+                        {"method", Analytics::TradeResampler::methodName(resampled.method)},
+                        {"samples", resampled.numSamples},
+                        {"trades", resampled.numTrades},
+                        {"percentiles", percentiles},
+                        {"mean_max_drawdown_percent", resampled.meanMaxDrawdownPercent}
+                    };
+                    if (withBalance) {
+                        methodJson["mean_final_balance"] = resampled.meanFinalBalance;
+                    }
+                    if (withSharpe) {
+                        methodJson["mean_sharpe_ratio"] = resampled.meanSharpeRatio;
+                    }
+                    methods.push_back(methodJson);
+                }
+                strategyJson["robustness"] = methods;
+            }
+            
             j["strategies"].push_back(strategyJson);
         }
         
@@ -734,6 +1044,10 @@ bool BatchBacktester::exportCsvReport(const std::string& filename) const {
         file << "Slowest Strategy," << m_results.performance.slowestStrategy << "\n";
         file << "Peak Memory Usage (MB)," << m_results.performance.peakMemoryUsageMB << "\n";
         file << "Batches Processed," << m_results.performance.batchesProcessed << "\n";
+        file << "Memory Budget (MB)," << m_results.performance.memoryBudgetMB << "\n";
+        file << "Admission Throttles," << m_results.performance.admissionThrottles << "\n";
+        file << "Admission Wait (s)," << (m_results.performance.admissionWait.count() / 1000.0) << "\n";
+        file << "Peak Reserved Memory (MB)," << m_results.performance.peakReservedMemoryMB << "\n";
         
         spdlog::info("Exported CSV report to: {}", filename);
         return true;
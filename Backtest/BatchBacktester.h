@@ -1,12 +1,18 @@
 #pragma once
 
 #include "Backtester.h"
+#include "../Analytics/TradeResampler.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <chrono>
+#include <memory>
 #include <nlohmann/json.hpp>
 
+namespace Utils {
+    class WorkStealingPool;
+}
+
 namespace Backtest {
     /**
      * @brief Structure to hold batch backtest results across multiple strategies
@@ -15,6 +21,7 @@ namespace Backtest {
         std::vector<std::string> strategyNames;
         std::map<std::string, BacktestResult> results;
         std::map<std::string, std::string> equityCurveImages;
+        std::map<std::string, std::vector<Analytics::ResampleResult>> robustness;  // One entry per resampling method
         
         // Aggregate statistics
         double averageWinRate = 0.0;
@@ -31,6 +38,12 @@ namespace Backtest {
             std::string slowestStrategy;
             size_t peakMemoryUsageMB = 0;
             size_t batchesProcessed = 0;
+            
+            // Memory admission control (memoryLimitMB)
+            size_t memoryBudgetMB = 0;             // Budget left for strategies (0 = unlimited)
+            size_t admissionThrottles = 0;         // Strategies held back until memory was released
+            std::chrono::milliseconds admissionWait{0};
+            size_t peakReservedMemoryMB = 0;       // Highest estimated footprint in flight
         } performance;
     };
 
@@ -42,6 +55,7 @@ namespace Backtest {
         unsigned int threadCount = 0; // 0 means use hardware concurrency
         size_t batchSize = 10;
         size_t memoryLimitMB = 2048;
+        bool scheduleLongestFirst = true; // Order strategies by recorded/estimated duration
         
         // Output settings
         std::vector<std::string> outputFormats = {"markdown"};
@@ -50,6 +64,7 @@ namespace Backtest {
         int chartHeight = 800;
         int chartDPI = 100;
         bool includeChartsInReport = true;
+        std::string chartMode = "async"; // "async", "deferred" (save curves, render later) or "none"
         
         // Path settings
         std::string strategyDir = "data/strategies";
@@ -62,6 +77,14 @@ namespace Backtest {
         bool consoleOutput = true;
         bool trackPerformance = true;
         
+        // Robustness settings: trade-resampling Monte Carlo on each result
+        bool robustnessEnabled = false;
+        std::vector<std::string> robustnessMethods = {"shuffle", "bootstrap", "skip"};
+        size_t robustnessSamples = 1000;
+        uint64_t robustnessSeed = 0x5EED;
+        size_t robustnessBlockLength = 5;
+        double robustnessSkipProbability = 0.1;
+        
         // Backtest settings
         BacktestConfig backtestConfig;
     };
@@ -76,6 +99,11 @@ namespace Backtest {
          */
         BatchBacktester();
         
+        /**
+         * @brief Destructor; joins the worker pool
+         */
+        ~BatchBacktester();
+        
         /**
          * @brief Add a single strategy file to the batch
          * @param filePath Path to a CSV file containing price data for the strategy
@@ -159,6 +187,13 @@ namespace Backtest {
          */
         const BatchBacktestResults& getResults() const;
         
+        /**
+         * @brief Render charts from curves saved by a run with chart mode "deferred"
+         * @param curvesDir Directory holding the saved curves (default: <output_dir>/curves)
+         * @return Number of strategies rendered
+         */
+        size_t renderSavedCharts(const std::string& curvesDir = "");
+        
     private:
         /**
          * @brief Generate a markdown report containing all results
@@ -175,6 +210,15 @@ namespace Backtest {
         std::string generateStrategySection(const std::string& strategyName, 
                                            const BacktestResult& result) const;
         
+        /**
+         * @brief Run the configured trade-resampling methods on one result
+         * @param result Backtest result whose trades are resampled
+         * @param pool Pool the samples are spread over (callable from its tasks)
+         * @return One percentile table per method
+         */
+        std::vector<Analytics::ResampleResult> runRobustness(const BacktestResult& result,
+                                                             Utils::WorkStealingPool& pool) const;
+        
         /**
          * @brief Calculate aggregate statistics across all strategies
          */
@@ -189,6 +233,26 @@ namespace Backtest {
         std::string generateEquityCurveImage(const std::string& strategyName, 
                                             const BacktestResult& result);
         
+        /**
+         * @brief Save the curves needed to render a strategy's charts later
+         * @param strategyName Name of the strategy
+         * @param result Backtest result containing the curves
+         * @return True if the file was written
+         */
+        bool saveChartData(const std::string& strategyName, const BacktestResult& result) const;
+        
+        /**
+         * @brief Directory used for curves saved in deferred chart mode
+         */
+        std::string chartDataDir() const;
+        
+        /**
+         * @brief Get the persistent worker pool, (re)creating it if the thread count changed
+         * @param threadCount Number of worker threads
+         * @return The worker pool
+         */
+        Utils::WorkStealingPool& getThreadPool(unsigned int threadCount);
+        
         /**
          * @brief Track memory usage of the current process
          * @return Current memory usage in MB
@@ -209,6 +273,7 @@ namespace Backtest {
         BacktestConfig m_commonConfig;             // Common configuration for all backtests
         BatchConfig m_batchConfig;                 // Batch processing configuration
         BatchBacktestResults m_results;            // Results of the batch backtest
+        std::unique_ptr<Utils::WorkStealingPool> m_pool; // Reused across runs
     };
     
     // JSON conversion functions for BatchConfig
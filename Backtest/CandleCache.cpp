@@ -0,0 +1,197 @@
+#include "CandleCache.h"
+#include "MappedFile.h"
+#include "../Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Backtest {
+    namespace {
+        constexpr char CACHE_MAGIC[8] = {'T', 'C', 'C', 'A', 'N', 'D', 'L', 'E'};
+        constexpr std::size_t COLUMN_COUNT = 6;
+
+        std::size_t alignUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    std::string CandleCache::cachePathFor(const std::string& csvFilename) {
+        return csvFilename + ".tcc";
+    }
+
+    std::string CandleCache::cachePathFor(const std::string& csvFilename, const std::string& variant) {
+        return variant.empty() ? cachePathFor(csvFilename) : csvFilename + "." + variant + ".tcc";
+    }
+
+    std::size_t CandleCache::columnOffset(std::size_t column, std::uint64_t rowCount) {
+        std::size_t columnBytes = alignUp(static_cast<std::size_t>(rowCount) * sizeof(double), COLUMN_ALIGNMENT);
+        return alignUp(sizeof(CandleCacheHeader), COLUMN_ALIGNMENT) + column * columnBytes;
+    }
+
+    std::size_t CandleCache::fileSize(std::uint64_t rowCount) {
+        return columnOffset(COLUMN_COUNT, rowCount);
+    }
+
+    std::uint64_t CandleCache::checksum(const void* data, std::size_t size, std::uint64_t seed) {
+        constexpr std::uint64_t prime = 1099511628211ULL;
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::uint64_t hash = seed;
+
+        std::size_t words = size / sizeof(std::uint64_t);
+        for (std::size_t i = 0; i < words; ++i) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+            hash = (hash ^ word) * prime;
+        }
+        for (std::size_t i = words * sizeof(std::uint64_t); i < size; ++i) {
+            hash = (hash ^ bytes[i]) * prime;
+        }
+        return hash;
+    }
+
+    bool CandleCache::sourceSignature(const std::string& csvFilename, SourceSignature& signature) {
+        std::error_code ec;
+        auto fileSize = std::filesystem::file_size(csvFilename, ec);
+        if (ec) {
+            return false;
+        }
+        auto writeTime = std::filesystem::last_write_time(csvFilename, ec);
+        if (ec) {
+            return false;
+        }
+        signature.size = static_cast<std::uint64_t>(fileSize);
+        signature.mtime = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+        return true;
+    }
+
+    bool CandleCache::load(const std::string& csvFilename, LoaderMode mode,
+                           CandleSeries& candles, LoaderStats& stats) {
+        return load(csvFilename, std::string(), mode, candles, stats);
+    }
+
+    bool CandleCache::load(const std::string& csvFilename, const std::string& variant, LoaderMode mode,
+                           CandleSeries& candles, LoaderStats& stats) {
+        auto startTime = std::chrono::steady_clock::now();
+
+        SourceSignature source;
+        if (!sourceSignature(csvFilename, source)) {
+            return false;
+        }
+
+        MappedFile file;
+        if (!file.open(cachePathFor(csvFilename, variant)) || file.size() < sizeof(CandleCacheHeader)) {
+            return false;
+        }
+
+        CandleCacheHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        // Stale or foreign files are simply rebuilt by the caller
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+            header.version != VERSION ||
+            header.headerSize != sizeof(CandleCacheHeader) ||
+            header.timestampMode != static_cast<std::uint32_t>(mode) ||
+            header.sourceSize != source.size ||
+            header.sourceMtime != source.mtime ||
+            header.rowCount == 0 ||
+            file.size() != fileSize(header.rowCount)) {
+            return false;
+        }
+
+        const char* columnData = file.data() + columnOffset(0, header.rowCount);
+        std::size_t columnBytes = fileSize(header.rowCount) - columnOffset(0, header.rowCount);
+        if (checksum(columnData, columnBytes) != header.checksum) {
+            return false;
+        }
+
+        // Columns are stored exactly as CandleSeries keeps them, so each is one copy
+        std::size_t rows = static_cast<std::size_t>(header.rowCount);
+        candles.resize(rows);
+        std::memcpy(candles.timestamp(), file.data() + columnOffset(0, rows), rows * sizeof(std::int64_t));
+        std::memcpy(candles.open(), file.data() + columnOffset(1, rows), rows * sizeof(double));
+        std::memcpy(candles.high(), file.data() + columnOffset(2, rows), rows * sizeof(double));
+        std::memcpy(candles.low(), file.data() + columnOffset(3, rows), rows * sizeof(double));
+        std::memcpy(candles.close(), file.data() + columnOffset(4, rows), rows * sizeof(double));
+        std::memcpy(candles.volume(), file.data() + columnOffset(5, rows), rows * sizeof(double));
+
+        stats = LoaderStats();
+        stats.rows = rows;
+        stats.bytes = file.size();
+        stats.sortSkipped = true;
+        stats.fromCache = true;
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        if (stats.seconds > 0.0) {
+            stats.rowsPerSecond = static_cast<double>(stats.rows) / stats.seconds;
+            stats.bytesPerSecond = static_cast<double>(stats.bytes) / stats.seconds;
+        }
+        return true;
+    }
+
+    bool CandleCache::write(const std::string& csvFilename, LoaderMode mode,
+                            const CandleSeries& candles, const SourceSignature& source) {
+        return write(csvFilename, std::string(), mode, candles, source);
+    }
+
+    bool CandleCache::write(const std::string& csvFilename, const std::string& variant, LoaderMode mode,
+                            const CandleSeries& candles, const SourceSignature& source) {
+        if (candles.empty()) {
+            return false;
+        }
+
+        CandleCacheHeader header{};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = VERSION;
+        header.headerSize = sizeof(CandleCacheHeader);
+        header.rowCount = candles.size();
+        header.timestampMode = static_cast<std::uint32_t>(mode);
+        header.sourceSize = source.size;
+        header.sourceMtime = source.mtime;
+
+        // Build the whole image in memory so the checksum covers exactly what is written
+        std::size_t rows = candles.size();
+        std::vector<char> image(fileSize(rows), 0);
+        std::memcpy(image.data() + columnOffset(0, rows), candles.timestamp(), rows * sizeof(std::int64_t));
+        std::memcpy(image.data() + columnOffset(1, rows), candles.open(), rows * sizeof(double));
+        std::memcpy(image.data() + columnOffset(2, rows), candles.high(), rows * sizeof(double));
+        std::memcpy(image.data() + columnOffset(3, rows), candles.low(), rows * sizeof(double));
+        std::memcpy(image.data() + columnOffset(4, rows), candles.close(), rows * sizeof(double));
+        std::memcpy(image.data() + columnOffset(5, rows), candles.volume(), rows * sizeof(double));
+
+        auto timeRange = std::minmax_element(candles.timestamp(), candles.timestamp() + rows);
+        header.minTimestamp = *timeRange.first;
+        header.maxTimestamp = *timeRange.second;
+
+        std::size_t dataOffset = columnOffset(0, rows);
+        header.checksum = checksum(image.data() + dataOffset, image.size() - dataOffset);
+        std::memcpy(image.data(), &header, sizeof(header));
+
+        // Unique temporary name so concurrent batch workers never see a partial file
+        std::string cachePath = cachePathFor(csvFilename, variant);
+        std::string tempPath = Utils::uniqueTempPath(cachePath);
+
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                return false;
+            }
+            out.write(image.data(), static_cast<std::streamsize>(image.size()));
+            if (!out) {
+                out.close();
+                std::remove(tempPath.c_str());
+                return false;
+            }
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(tempPath, cachePath, ec);
+        if (ec) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+}
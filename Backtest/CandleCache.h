@@ -0,0 +1,81 @@
+#ifndef BACKTEST_CANDLE_CACHE_H
+#define BACKTEST_CANDLE_CACHE_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include "Backtester.h"
+#include "CandleSeries.h"
+
+namespace Backtest {
+    // Binary columnar cache of a parsed candle CSV, stored next to the source
+    // file. Layout (native endianness):
+    //   CandleCacheHeader
+    //   int64  timestamp[rowCount]
+    //   double open[rowCount], high[rowCount], low[rowCount], close[rowCount], volume[rowCount]
+    // Each column starts on a 64-byte boundary. The cache is only used while
+    // the CSV's size and modification time match the values in the header.
+    // Loading validates the checksum and copies each column into a
+    // CandleSeries; the mapping is not kept.
+    struct CandleCacheHeader {
+        char magic[8];              // "TCCANDLE"
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t rowCount;
+        std::int64_t minTimestamp;
+        std::int64_t maxTimestamp;
+        std::uint64_t sourceSize;   // CSV size in bytes
+        std::int64_t sourceMtime;   // CSV last_write_time, in file clock ticks
+        std::uint32_t timestampMode; // LoaderMode used to parse the CSV
+        std::uint32_t reserved;
+        std::uint64_t checksum;     // Over all column bytes
+    };
+
+    // Size and modification time of a source CSV, as stored in cache headers
+    struct SourceSignature {
+        std::uint64_t size = 0;
+        std::int64_t mtime = 0;     // last_write_time, in file clock ticks
+    };
+
+    class CandleCache {
+    public:
+        static constexpr std::uint32_t VERSION = 1;
+        static constexpr std::size_t COLUMN_ALIGNMENT = 64;
+
+        // Cache file used for a given CSV
+        static std::string cachePathFor(const std::string& csvFilename);
+
+        // Cache file for series derived from a CSV ("<csv>.<variant>.tcc"),
+        // e.g. resampled timeframes; an empty variant is the CSV's own cache
+        static std::string cachePathFor(const std::string& csvFilename, const std::string& variant);
+
+        // Load the cache for csvFilename if it exists and is still current.
+        // Returns false (leaving candles untouched) on any mismatch.
+        static bool load(const std::string& csvFilename, LoaderMode mode,
+                         CandleSeries& candles, LoaderStats& stats);
+        static bool load(const std::string& csvFilename, const std::string& variant, LoaderMode mode,
+                         CandleSeries& candles, LoaderStats& stats);
+
+        // Write the cache for csvFilename, stamped with the signature the CSV
+        // had before it was read, so a change made while parsing leaves the
+        // cache stale. The file is written under a temporary name and
+        // renamed into place.
+        static bool write(const std::string& csvFilename, LoaderMode mode,
+                          const CandleSeries& candles, const SourceSignature& source);
+        static bool write(const std::string& csvFilename, const std::string& variant, LoaderMode mode,
+                          const CandleSeries& candles, const SourceSignature& source);
+
+        // Current signature of a CSV; false if it cannot be read
+        static bool sourceSignature(const std::string& csvFilename, SourceSignature& signature);
+
+        // 64-bit FNV-1a style hash over 8-byte words
+        static std::uint64_t checksum(const void* data, std::size_t size,
+                                      std::uint64_t seed = 14695981039346656037ULL);
+
+        // Byte offset of each column for a given row count
+        static std::size_t columnOffset(std::size_t column, std::uint64_t rowCount);
+        static std::size_t fileSize(std::uint64_t rowCount);
+    };
+}
+
+#endif // BACKTEST_CANDLE_CACHE_H
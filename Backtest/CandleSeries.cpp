@@ -0,0 +1,93 @@
+#include "CandleSeries.h"
+#include <algorithm>
+#include <numeric>
+
+namespace Backtest {
+    namespace {
+        template<typename Column>
+        void applyPermutation(Column& column, const std::vector<std::size_t>& order) {
+            Column reordered(column.size());
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                reordered[i] = column[order[i]];
+            }
+            column.swap(reordered);
+        }
+    }
+
+    CandleSeries::CandleSeries(const std::vector<CandleData>& candles) {
+        reserve(candles.size());
+        for (const auto& candle : candles) {
+            push_back(candle);
+        }
+    }
+
+    void CandleSeries::clear() {
+        m_timestamp.clear();
+        m_open.clear();
+        m_high.clear();
+        m_low.clear();
+        m_close.clear();
+        m_volume.clear();
+    }
+
+    void CandleSeries::reserve(std::size_t count) {
+        m_timestamp.reserve(count);
+        m_open.reserve(count);
+        m_high.reserve(count);
+        m_low.reserve(count);
+        m_close.reserve(count);
+        m_volume.reserve(count);
+    }
+
+    void CandleSeries::resize(std::size_t count) {
+        m_timestamp.resize(count);
+        m_open.resize(count);
+        m_high.resize(count);
+        m_low.resize(count);
+        m_close.resize(count);
+        m_volume.resize(count);
+    }
+
+    void CandleSeries::push_back(const CandleData& candle) {
+        m_timestamp.push_back(static_cast<std::int64_t>(candle.timestamp));
+        m_open.push_back(candle.open);
+        m_high.push_back(candle.high);
+        m_low.push_back(candle.low);
+        m_close.push_back(candle.close);
+        m_volume.push_back(candle.volume);
+    }
+
+    CandleData CandleSeries::operator[](std::size_t index) const {
+        CandleData candle;
+        candle.timestamp = static_cast<std::time_t>(m_timestamp[index]);
+        candle.open = m_open[index];
+        candle.high = m_high[index];
+        candle.low = m_low[index];
+        candle.close = m_close[index];
+        candle.volume = m_volume[index];
+        return candle;
+    }
+
+    bool CandleSeries::isSortedByTimestamp() const {
+        return std::is_sorted(m_timestamp.begin(), m_timestamp.end());
+    }
+
+    void CandleSeries::sortByTimestamp() {
+        if (isSortedByTimestamp()) {
+            return;
+        }
+
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) {
+            return m_timestamp[a] < m_timestamp[b];
+        });
+
+        applyPermutation(m_timestamp, order);
+        applyPermutation(m_open, order);
+        applyPermutation(m_high, order);
+        applyPermutation(m_low, order);
+        applyPermutation(m_close, order);
+        applyPermutation(m_volume, order);
+    }
+}
@@ -0,0 +1,101 @@
+#ifndef BACKTEST_CANDLE_SERIES_H
+#define BACKTEST_CANDLE_SERIES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace Backtest {
+    struct CandleData {
+        std::time_t timestamp;
+        double open;
+        double high;
+        double low;
+        double close;
+        double volume = 0.0;
+    };
+
+    // Minimal allocator returning Alignment-byte aligned storage
+    template<typename T, std::size_t Alignment>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        template<typename U>
+        struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+        AlignedAllocator() noexcept = default;
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept {
+            ::operator delete(p, std::align_val_t(Alignment));
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+    };
+
+    // Structure-of-arrays candle storage. Each field lives in its own
+    // cache-line aligned array so whole-series passes stream one column at a time.
+    class CandleSeries {
+    public:
+        static constexpr std::size_t ALIGNMENT = 64;
+        using DoubleColumn = std::vector<double, AlignedAllocator<double, ALIGNMENT>>;
+        using TimeColumn = std::vector<std::int64_t, AlignedAllocator<std::int64_t, ALIGNMENT>>;
+
+        CandleSeries() = default;
+        explicit CandleSeries(const std::vector<CandleData>& candles);
+
+        std::size_t size() const { return m_close.size(); }
+        bool empty() const { return m_close.empty(); }
+
+        void clear();
+        void reserve(std::size_t count);
+        void resize(std::size_t count);
+        void push_back(const CandleData& candle);
+
+        // Gather a single bar (for display and per-trade code paths)
+        CandleData operator[](std::size_t index) const;
+
+        // Reorder all columns by ascending timestamp
+        void sortByTimestamp();
+        bool isSortedByTimestamp() const;
+
+        // Column access
+        const std::int64_t* timestamp() const { return m_timestamp.data(); }
+        const double* open() const { return m_open.data(); }
+        const double* high() const { return m_high.data(); }
+        const double* low() const { return m_low.data(); }
+        const double* close() const { return m_close.data(); }
+        const double* volume() const { return m_volume.data(); }
+
+        std::int64_t* timestamp() { return m_timestamp.data(); }
+        double* open() { return m_open.data(); }
+        double* high() { return m_high.data(); }
+        double* low() { return m_low.data(); }
+        double* close() { return m_close.data(); }
+        double* volume() { return m_volume.data(); }
+
+    private:
+        TimeColumn m_timestamp;
+        DoubleColumn m_open;
+        DoubleColumn m_high;
+        DoubleColumn m_low;
+        DoubleColumn m_close;
+        DoubleColumn m_volume;
+    };
+}
+
+#endif // BACKTEST_CANDLE_SERIES_H
@@ -0,0 +1,94 @@
+#include "ChartRenderQueue.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace Backtest {
+
+ChartRenderQueue::ChartRenderQueue(RenderFunction render, size_t capacity)
+    : m_render(std::move(render)), m_capacity(std::max<size_t>(capacity, 1)) {
+    m_thread = std::thread(&ChartRenderQueue::renderLoop, this);
+}
+
+ChartRenderQueue::~ChartRenderQueue() {
+    finish();
+}
+
+BacktestResult ChartRenderQueue::chartData(const BacktestResult& result) {
+    BacktestResult curves;
+    curves.stats = result.stats;
+    curves.equityCurve = result.equityCurve;
+    curves.drawdownCurve = result.drawdownCurve;
+    curves.totalTrades = result.totalTrades;
+    curves.winningTrades = result.winningTrades;
+    curves.losingTrades = result.losingTrades;
+    curves.winRate = result.winRate;
+    curves.profitFactor = result.profitFactor;
+    curves.netProfit = result.netProfit;
+    return curves;
+}
+
+size_t ChartRenderQueue::chartBytes(const BacktestResult& result) {
+    return (result.equityCurve.size() + result.drawdownCurve.size()) * sizeof(double);
+}
+
+bool ChartRenderQueue::push(const std::string& strategyName, const BacktestResult& result) {
+    Job job{strategyName, chartData(result)};
+    
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_spaceAvailable.wait(lock, [this] { return m_jobs.size() < m_capacity || m_finishing; });
+        if (m_finishing) {
+            spdlog::warn("Chart renderer already stopped; skipping charts for {}", strategyName);
+            return false;
+        }
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobAvailable.notify_one();
+    return true;
+}
+
+std::map<std::string, std::string> ChartRenderQueue::finish() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_finishing = true;
+    }
+    m_jobAvailable.notify_all();
+    m_spaceAvailable.notify_all();
+    
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_images;
+}
+
+void ChartRenderQueue::renderLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this] { return !m_jobs.empty() || m_finishing; });
+            if (m_jobs.empty()) {
+                return; // Finishing and fully drained
+            }
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+        m_spaceAvailable.notify_one();
+        
+        std::string imagePath;
+        try {
+            imagePath = m_render(job.strategyName, job.result);
+        } catch (const std::exception& e) {
+            spdlog::error("Error rendering charts for {}: {}", job.strategyName, e.what());
+        }
+        
+        if (!imagePath.empty()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_images[job.strategyName] = imagePath;
+        }
+    }
+}
+
+} // namespace Backtest
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Backtester.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace Backtest {
+    /**
+     * @brief Bounded hand-off from backtest workers to a single chart renderer thread
+     *
+     * MatPlot++ keeps global figure state, so all rendering happens on the one
+     * thread owned by this queue. Workers only copy the curves they produced
+     * and return to backtesting; push() blocks only when the queue is full.
+     */
+    class ChartRenderQueue {
+    public:
+        /**
+         * @brief Renders one strategy and returns the main image path ("" on failure)
+         */
+        using RenderFunction = std::function<std::string(const std::string&, const BacktestResult&)>;
+        
+        /**
+         * @brief Start the renderer thread
+         * @param render Function called on the renderer thread for each job
+         * @param capacity Maximum number of queued jobs before push() blocks
+         */
+        ChartRenderQueue(RenderFunction render, size_t capacity);
+        
+        /**
+         * @brief Render whatever is still queued and join the renderer thread
+         */
+        ~ChartRenderQueue();
+        
+        ChartRenderQueue(const ChartRenderQueue&) = delete;
+        ChartRenderQueue& operator=(const ChartRenderQueue&) = delete;
+        
+        /**
+         * @brief Queue a strategy's curves for rendering
+         * @param strategyName Name of the strategy
+         * @param result Result to plot; trade records are not copied
+         * @return False if the renderer has already stopped and the job was dropped
+         */
+        bool push(const std::string& strategyName, const BacktestResult& result);
+        
+        /**
+         * @brief Render all queued jobs, stop the renderer and collect image paths
+         * @return Image path per strategy (failed renders are omitted)
+         */
+        std::map<std::string, std::string> finish();
+        
+        /**
+         * @brief Copy of a result without its trade records (all charts need)
+         * @param result Full backtest result
+         * @return Curves and summary fields only
+         */
+        static BacktestResult chartData(const BacktestResult& result);
+        
+        /**
+         * @brief Memory held by a queued job's curves
+         * @param result Result passed to push() or its chartData() copy
+         * @return Bytes of the copied equity and drawdown curves
+         */
+        static size_t chartBytes(const BacktestResult& result);
+        
+    private:
+        struct Job {
+            std::string strategyName;
+            BacktestResult result;
+        };
+        
+        void renderLoop();
+        
+        RenderFunction m_render;
+        size_t m_capacity;
+        
+        std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_spaceAvailable;
+        std::deque<Job> m_jobs;
+        std::map<std::string, std::string> m_images;
+        bool m_finishing = false;
+        
+        std::thread m_thread;
+    };
+}
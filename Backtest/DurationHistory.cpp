@@ -0,0 +1,167 @@
+#include "DurationHistory.h"
+#include "CandleCache.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+
+namespace Backtest {
+
+namespace {
+    constexpr int HISTORY_VERSION = 1;
+    constexpr std::streamsize SAMPLE_BYTES = 64 * 1024;
+}
+
+DurationHistory::DurationHistory(std::string historyFile)
+    : m_historyFile(std::move(historyFile)) {
+}
+
+std::string DurationHistory::normalizePath(const std::string& filePath) {
+    std::error_code ec;
+    std::filesystem::path absolute = std::filesystem::absolute(filePath, ec);
+    return ec ? filePath : absolute.lexically_normal().string();
+}
+
+bool DurationHistory::load() {
+    m_entries.clear();
+    
+    std::ifstream file(m_historyFile);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    try {
+        nlohmann::json j;
+        file >> j;
+        if (j.value("version", 0) != HISTORY_VERSION || !j.contains("strategies")) {
+            return false;
+        }
+        
+        for (const auto& [path, value] : j["strategies"].items()) {
+            Entry entry;
+            entry.fingerprint = value.at("fingerprint").get<std::string>();
+            entry.fileSize = value.at("file_size").get<std::uintmax_t>();
+            entry.durationMs = value.at("duration_ms").get<std::int64_t>();
+            m_entries[path] = entry;
+        }
+    } catch (const std::exception& e) {
+        spdlog::warn("Ignoring unreadable duration history {}: {}", m_historyFile, e.what());
+        m_entries.clear();
+        return false;
+    }
+    
+    return true;
+}
+
+bool DurationHistory::save() const {
+    nlohmann::json strategies = nlohmann::json::object();
+    for (const auto& [path, entry] : m_entries) {
+        strategies[path] = {
+            {"fingerprint", entry.fingerprint},
+            {"file_size", entry.fileSize},
+            {"duration_ms", entry.durationMs}
+        };
+    }
+    nlohmann::json j = {
+        {"version", HISTORY_VERSION},
+        {"strategies", strategies}
+    };
+    
+    std::string tempFile = m_historyFile + ".tmp";
+    {
+        std::ofstream file(tempFile, std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << j.dump(2);
+        if (!file) {
+            file.close();
+            std::remove(tempFile.c_str());
+            return false;
+        }
+    }
+    
+    std::error_code ec;
+    std::filesystem::rename(tempFile, m_historyFile, ec);
+    if (ec) {
+        std::remove(tempFile.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string DurationHistory::fingerprint(const std::string& filePath) {
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(filePath, ec);
+    if (ec) {
+        return "";
+    }
+    
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return "";
+    }
+    
+    // Hash the head and the tail; the size catches most edits in between
+    std::vector<char> buffer(static_cast<size_t>(SAMPLE_BYTES));
+    file.read(buffer.data(), SAMPLE_BYTES);
+    std::uint64_t hash = CandleCache::checksum(buffer.data(), static_cast<size_t>(file.gcount()));
+    
+    if (fileSize > static_cast<std::uintmax_t>(SAMPLE_BYTES)) {
+        file.clear();
+        file.seekg(-SAMPLE_BYTES, std::ios::end);
+        file.read(buffer.data(), SAMPLE_BYTES);
+        hash = CandleCache::checksum(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+    }
+    
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << hash << "-" << std::dec << fileSize;
+    return ss.str();
+}
+
+bool DurationHistory::lookup(const std::string& filePath, const std::string& fingerprint,
+                             std::chrono::milliseconds& duration) const {
+    auto it = m_entries.find(normalizePath(filePath));
+    if (it == m_entries.end() || fingerprint.empty() || it->second.fingerprint != fingerprint) {
+        return false;
+    }
+    duration = std::chrono::milliseconds(it->second.durationMs);
+    return true;
+}
+
+void DurationHistory::record(const std::string& filePath, const std::string& fingerprint,
+                             std::uintmax_t fileSize, std::chrono::milliseconds duration) {
+    if (fingerprint.empty()) {
+        return;
+    }
+    Entry& entry = m_entries[normalizePath(filePath)];
+    entry.fingerprint = fingerprint;
+    entry.fileSize = fileSize;
+    entry.durationMs = duration.count();
+}
+
+double DurationHistory::estimate(const std::string& filePath, const std::string& fingerprint,
+                                 std::uintmax_t fileSize) const {
+    std::chrono::milliseconds recorded{0};
+    if (lookup(filePath, fingerprint, recorded)) {
+        return static_cast<double>(recorded.count());
+    }
+    
+    double totalMs = 0.0;
+    double totalBytes = 0.0;
+    for (const auto& [_, entry] : m_entries) {
+        totalMs += static_cast<double>(entry.durationMs);
+        totalBytes += static_cast<double>(entry.fileSize);
+    }
+    
+    if (totalBytes > 0.0 && totalMs > 0.0) {
+        return static_cast<double>(fileSize) * (totalMs / totalBytes);
+    }
+    return static_cast<double>(fileSize);
+}
+
+} // namespace Backtest
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Backtest {
+    /**
+     * @brief Per-strategy run times remembered between batch runs
+     *
+     * Entries are keyed by the strategy file's absolute path and are only used
+     * while the file's content fingerprint is unchanged. The history is a small
+     * JSON file, normally kept in the batch output directory.
+     */
+    class DurationHistory {
+    public:
+        /**
+         * @brief Default file name inside the output directory
+         */
+        static constexpr const char* FILE_NAME = "strategy_durations.json";
+        
+        /**
+         * @brief Constructor
+         * @param historyFile Path of the JSON history file
+         */
+        explicit DurationHistory(std::string historyFile);
+        
+        /**
+         * @brief Read the history file. A missing or unreadable file leaves the history empty.
+         * @return True if the file was read
+         */
+        bool load();
+        
+        /**
+         * @brief Write the history file (via a temporary file and rename)
+         * @return True if the file was written
+         */
+        bool save() const;
+        
+        /**
+         * @brief Cheap content fingerprint: file size plus a hash of the first and last 64 KB
+         * @param filePath Strategy file
+         * @return Hex fingerprint, or an empty string if the file cannot be read
+         */
+        static std::string fingerprint(const std::string& filePath);
+        
+        /**
+         * @brief Look up the recorded duration for a file
+         * @param filePath Strategy file
+         * @param fingerprint Current fingerprint of the file
+         * @param duration Receives the recorded duration
+         * @return True if a duration was recorded for this exact content
+         */
+        bool lookup(const std::string& filePath, const std::string& fingerprint,
+                   std::chrono::milliseconds& duration) const;
+        
+        /**
+         * @brief Record the measured duration of a strategy
+         * @param filePath Strategy file
+         * @param fingerprint Fingerprint of the file that was run
+         * @param fileSize File size in bytes
+         * @param duration Measured duration
+         */
+        void record(const std::string& filePath, const std::string& fingerprint,
+                    std::uintmax_t fileSize, std::chrono::milliseconds duration);
+        
+        /**
+         * @brief Estimated run time used for scheduling
+         *
+         * Uses the recorded duration when the content matches. Otherwise the
+         * file size is scaled by the average milliseconds per byte of all
+         * recorded entries, or used as-is when there is no history.
+         * @param filePath Strategy file
+         * @param fingerprint Current fingerprint of the file
+         * @param fileSize File size in bytes
+         * @return Estimated duration in milliseconds (or bytes, without history)
+         */
+        double estimate(const std::string& filePath, const std::string& fingerprint,
+                        std::uintmax_t fileSize) const;
+        
+        /**
+         * @return Number of recorded strategies
+         */
+        size_t size() const { return m_entries.size(); }
+        
+    private:
+        struct Entry {
+            std::string fingerprint;
+            std::uintmax_t fileSize = 0;
+            std::int64_t durationMs = 0;
+        };
+        
+        static std::string normalizePath(const std::string& filePath);
+        
+        std::string m_historyFile;
+        std::map<std::string, Entry> m_entries;
+    };
+}
@@ -1,4 +1,5 @@
 #include "EquityCurveGenerator.h"
+#include "../Utils/Downsampler.h"
 #include <spdlog/spdlog.h>
 #include <matplot/matplot.h>
 #include <algorithm>
@@ -64,20 +65,15 @@ std::string EquityCurveGenerator::generateEquityCurve(
             return "";
         }
         
-        // Create date indexes for X-axis
-        std::vector<double> x(result.equityCurve.size());
-        std::iota(x.begin(), x.end(), 0);
-        
-        // Get Y values (equity values)
-        std::vector<double> y(result.equityCurve.size());
-        std::transform(result.equityCurve.begin(), result.equityCurve.end(), y.begin(),
-                       [](double value) { return value; });
+        // One point per pixel column is all the image can show; x keeps trade numbers
+        Utils::CurvePoints points = Utils::downsampleLTTB(
+            result.equityCurve, static_cast<size_t>(std::max(m_config.width, 3)));
         
         // Clear previous plot
         matplot::cla();
         
         // Create the plot
-        matplot::plot(x, y)->line_width(2).color("blue");
+        matplot::plot(points.x, points.y)->line_width(2).color("blue");
         
         // Add horizontal line at initial equity
         matplot::yline(result.equityCurve.front())->line_width(1).color("gray").line_style("--");
@@ -131,20 +127,20 @@ std::string EquityCurveGenerator::generateDrawdownChart(
             return "";
         }
         
-        // Create date indexes for X-axis
-        std::vector<double> x(result.drawdowns.size());
-        std::iota(x.begin(), x.end(), 0);
-        
         // Get Y values (drawdown percentages)
         std::vector<double> y(result.drawdowns.size());
         std::transform(result.drawdowns.begin(), result.drawdowns.end(), y.begin(),
                        [](double value) { return -value * 100.0; }); // Negate to show as negative values
         
+        // Low and high of each pair of pixel columns, so no trough is lost; x keeps trade numbers
+        Utils::CurvePoints points = Utils::downsampleMinMax(
+            y, static_cast<size_t>(std::max(m_config.width / 2, 1)));
+        
         // Clear previous plot
         matplot::cla();
         
         // Create the plot
-        matplot::plot(x, y)->line_width(2).color("red");
+        matplot::plot(points.x, points.y)->line_width(2).color("red");
         
         // Add title and labels
         matplot::title("Drawdown Chart: " + strategyName);
@@ -0,0 +1,140 @@
+#include "ExitResolver.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Backtest {
+    ExitResolver::ExitResolver(std::shared_ptr<const CandleSeries> series)
+        : m_series(std::move(series)) {
+        std::size_t n = m_series->size();
+        m_minLow.emplace_back(m_series->low(), m_series->low() + n);
+        m_maxHigh.emplace_back(m_series->high(), m_series->high() + n);
+
+        // A search never spans more than MAX_HOLDING_BARS bars, so blocks
+        // larger than that are never needed. fmin/fmax skip NaN bars, which
+        // never trigger an exit in the scan either.
+        for (std::size_t k = 1; (std::size_t(1) << k) <= std::min(n, MAX_HOLDING_BARS); ++k) {
+            std::size_t half = std::size_t(1) << (k - 1);
+            std::size_t count = n - (std::size_t(1) << k) + 1;
+            const auto& lowPrev = m_minLow[k - 1];
+            const auto& highPrev = m_maxHigh[k - 1];
+
+            CandleSeries::DoubleColumn lowLevel(count);
+            CandleSeries::DoubleColumn highLevel(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                lowLevel[i] = std::fmin(lowPrev[i], lowPrev[i + half]);
+                highLevel[i] = std::fmax(highPrev[i], highPrev[i + half]);
+            }
+            m_minLow.push_back(std::move(lowLevel));
+            m_maxHigh.push_back(std::move(highLevel));
+        }
+    }
+
+    std::size_t ExitResolver::firstLowAtOrBelow(std::size_t first, std::size_t last, double level) const {
+        // Skip the longest prefix that stays above the level, largest blocks first
+        std::size_t pos = first;
+        for (std::size_t k = m_minLow.size(); k-- > 0;) {
+            std::size_t block = std::size_t(1) << k;
+            if (pos + block - 1 <= last && !(m_minLow[k][pos] <= level)) {
+                pos += block;
+            }
+        }
+        return pos;
+    }
+
+    std::size_t ExitResolver::firstHighAtOrAbove(std::size_t first, std::size_t last, double level) const {
+        std::size_t pos = first;
+        for (std::size_t k = m_maxHigh.size(); k-- > 0;) {
+            std::size_t block = std::size_t(1) << k;
+            if (pos + block - 1 <= last && !(m_maxHigh[k][pos] >= level)) {
+                pos += block;
+            }
+        }
+        return pos;
+    }
+
+    ExitResolution ExitResolver::timeoutExit(const CandleSeries& series, std::size_t entryIndex,
+                                             std::size_t exitIndex, bool isLong) {
+        double entryPrice = series.close()[entryIndex];
+        double closePrice = series.close()[exitIndex];
+
+        ExitResolution exit;
+        exit.exitIndex = exitIndex;
+        exit.finished = true;
+        if (isLong) {
+            if (closePrice > entryPrice) {
+                exit.outcome = TradeOutcome::WinAtTP1;
+            } else if (closePrice < entryPrice) {
+                exit.outcome = TradeOutcome::LossAtSL;
+            } else {
+                exit.outcome = TradeOutcome::BreakEven;
+            }
+        } else {
+            if (closePrice < entryPrice) {
+                exit.outcome = TradeOutcome::WinAtTP1;
+            } else if (closePrice > entryPrice) {
+                exit.outcome = TradeOutcome::LossAtSL;
+            } else {
+                exit.outcome = TradeOutcome::BreakEven;
+            }
+        }
+        return exit;
+    }
+
+    ExitResolution ExitResolver::resolve(std::size_t entryIndex, bool isLong,
+                                         double stopLoss, double takeProfit) const {
+        ExitResolution exit;
+        std::size_t n = m_series->size();
+        if (n == 0 || entryIndex + 1 >= n) {
+            return exit;
+        }
+
+        std::size_t first = entryIndex + 1;
+        std::size_t timeoutIndex = entryIndex + MAX_HOLDING_BARS;
+        std::size_t last = std::min(n - 1, timeoutIndex);
+
+        std::size_t stopIndex = isLong ? firstLowAtOrBelow(first, last, stopLoss)
+                                       : firstHighAtOrAbove(first, last, stopLoss);
+        // TP only matters before the SL bar (SL wins ties)
+        std::size_t targetLast = std::min(stopIndex, last + 1) - 1;
+        std::size_t targetIndex = (targetLast + 1 > first)
+            ? (isLong ? firstHighAtOrAbove(first, targetLast, takeProfit)
+                      : firstLowAtOrBelow(first, targetLast, takeProfit))
+            : last + 1;
+
+        std::size_t hitIndex = std::min(stopIndex, targetIndex);
+        if (hitIndex < timeoutIndex && hitIndex <= last) {
+            exit.outcome = (stopIndex <= targetIndex) ? TradeOutcome::LossAtSL : TradeOutcome::WinAtTP1;
+            exit.exitIndex = hitIndex;
+            exit.finished = true;
+            return exit;
+        }
+
+        if (timeoutIndex <= n - 1) {
+            return timeoutExit(*m_series, entryIndex, timeoutIndex, isLong);
+        }
+        return exit;
+    }
+
+    ExitResolution ExitResolver::resolveScalar(const CandleSeries& series, std::size_t entryIndex,
+                                               bool isLong, double stopLoss, double takeProfit) {
+        ExitResolution exit;
+        const double* high = series.high();
+        const double* low = series.low();
+
+        for (std::size_t i = entryIndex + 1; i < series.size(); ++i) {
+            if (i >= entryIndex + MAX_HOLDING_BARS) {
+                return timeoutExit(series, entryIndex, i, isLong);
+            }
+
+            bool stopHit = isLong ? low[i] <= stopLoss : high[i] >= stopLoss;
+            bool targetHit = isLong ? high[i] >= takeProfit : low[i] <= takeProfit;
+            if (stopHit || targetHit) {
+                exit.outcome = stopHit ? TradeOutcome::LossAtSL : TradeOutcome::WinAtTP1;
+                exit.exitIndex = i;
+                exit.finished = true;
+                return exit;
+            }
+        }
+        return exit;
+    }
+}
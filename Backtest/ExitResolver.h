@@ -0,0 +1,58 @@
+#ifndef BACKTEST_EXIT_RESOLVER_H
+#define BACKTEST_EXIT_RESOLVER_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "../Trade.h"
+#include "CandleSeries.h"
+
+namespace Backtest {
+    // How a simulated trade ended
+    struct ExitResolution {
+        TradeOutcome outcome = TradeOutcome::Pending;
+        std::size_t exitIndex = 0;  // Bar on which the trade closed
+        bool finished = false;      // False when the data ran out first
+    };
+
+    // Finds where a trade opened at a bar's close exits, using sparse tables
+    // (range minimum of low, range maximum of high) and binary lifting instead
+    // of a bar-by-bar scan. Rules are the same as the original scan:
+    //   - bars after the entry bar are checked in order
+    //   - SL is checked before TP on the same bar
+    //   - on bar entry + MAX_HOLDING_BARS the trade is closed at that bar's
+    //     close (win, loss or break-even against the entry price), even if
+    //     SL or TP is touched on that bar
+    //   - if the data ends first, the trade stays pending
+    class ExitResolver {
+    public:
+        static constexpr std::size_t MAX_HOLDING_BARS = 100;
+
+        explicit ExitResolver(std::shared_ptr<const CandleSeries> series);
+
+        ExitResolution resolve(std::size_t entryIndex, bool isLong,
+                               double stopLoss, double takeProfit) const;
+
+        // Reference bar-by-bar implementation
+        static ExitResolution resolveScalar(const CandleSeries& series, std::size_t entryIndex,
+                                            bool isLong, double stopLoss, double takeProfit);
+
+        const CandleSeries& series() const { return *m_series; }
+
+    private:
+        // First bar in [first, last] with low <= level (or high >= level);
+        // returns last + 1 if there is none
+        std::size_t firstLowAtOrBelow(std::size_t first, std::size_t last, double level) const;
+        std::size_t firstHighAtOrAbove(std::size_t first, std::size_t last, double level) const;
+
+        static ExitResolution timeoutExit(const CandleSeries& series, std::size_t entryIndex,
+                                          std::size_t exitIndex, bool isLong);
+
+        std::shared_ptr<const CandleSeries> m_series;
+        // m_minLow[k][i] = min(low[i .. i + 2^k - 1]); level 0 is the low column itself
+        std::vector<CandleSeries::DoubleColumn> m_minLow;
+        std::vector<CandleSeries::DoubleColumn> m_maxHigh;
+    };
+}
+
+#endif // BACKTEST_EXIT_RESOLVER_H
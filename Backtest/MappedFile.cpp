@@ -0,0 +1,142 @@
+#include "MappedFile.h"
+#include <utility>
+
+// Platform-specific file mapping
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Backtest {
+    MappedFile::MappedFile(const std::string& filename) {
+        open(filename);
+    }
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        swap(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            swap(other);
+        }
+        return *this;
+    }
+
+    void MappedFile::swap(MappedFile& other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_isOpen, other.m_isOpen);
+#if defined(_WIN32)
+        std::swap(m_fileHandle, other.m_fileHandle);
+        std::swap(m_mappingHandle, other.m_mappingHandle);
+#endif
+    }
+
+    bool MappedFile::open(const std::string& filename) {
+        close();
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_fileHandle = file;
+        m_size = static_cast<std::size_t>(fileSize.QuadPart);
+        m_isOpen = true;
+
+        if (m_size == 0) {
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            close();
+            return false;
+        }
+        m_mappingHandle = mapping;
+
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            close();
+            return false;
+        }
+        m_data = static_cast<const char*>(view);
+        return true;
+#else
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return false;
+        }
+
+        m_size = static_cast<std::size_t>(st.st_size);
+        m_isOpen = true;
+
+        if (m_size == 0) {
+            ::close(fd);
+            return true;
+        }
+
+        void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        // The mapping keeps its own reference to the file
+        ::close(fd);
+
+        if (view == MAP_FAILED) {
+            m_size = 0;
+            m_isOpen = false;
+            return false;
+        }
+
+        // Loaders walk the file front to back exactly once
+        madvise(view, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(view);
+        return true;
+#endif
+    }
+
+    void MappedFile::close() {
+#if defined(_WIN32)
+        if (m_data) {
+            UnmapViewOfFile(m_data);
+        }
+        if (m_mappingHandle) {
+            CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        }
+        if (m_fileHandle) {
+            CloseHandle(static_cast<HANDLE>(m_fileHandle));
+        }
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        if (m_data) {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+#endif
+        m_data = nullptr;
+        m_size = 0;
+        m_isOpen = false;
+    }
+}
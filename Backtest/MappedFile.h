@@ -0,0 +1,42 @@
+#ifndef BACKTEST_MAPPED_FILE_H
+#define BACKTEST_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace Backtest {
+    // Read-only memory mapping of a whole file. Empty files open successfully
+    // with a null data pointer and a size of zero.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& filename);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        // Map the file, replacing any previous mapping
+        bool open(const std::string& filename);
+        void close();
+
+        bool isOpen() const { return m_isOpen; }
+        const char* data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+
+    private:
+        const char* m_data = nullptr;
+        std::size_t m_size = 0;
+        bool m_isOpen = false;
+#if defined(_WIN32)
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#endif
+
+        void swap(MappedFile& other) noexcept;
+    };
+}
+
+#endif // BACKTEST_MAPPED_FILE_H
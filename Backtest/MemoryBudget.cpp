@@ -0,0 +1,156 @@
+#include "MemoryBudget.h"
+#include "BacktestTrade.h"
+#include "CandleCache.h"
+#include "ExitResolver.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace Backtest {
+
+namespace {
+    constexpr std::streamsize SAMPLE_BYTES = 64 * 1024;
+    
+    // Bytes held per candle while a strategy runs
+    constexpr size_t CANDLE_BYTES = sizeof(std::int64_t) + 5 * sizeof(double);  // CandleSeries columns
+    constexpr size_t SIGNAL_BYTES = sizeof(std::uint8_t) + sizeof(std::uint32_t); // Flags + candidate index
+    constexpr size_t EXIT_TABLE_LEVELS = 7;                                         // 2^6 <= MAX_HOLDING_BARS < 2^7
+    constexpr size_t EXIT_TABLE_BYTES = 2 * EXIT_TABLE_LEVELS * sizeof(double);   // min(low) and max(high)
+    
+    // At most one trade per 6 bars (the re-entry gap), each with two curve points
+    constexpr size_t BARS_PER_TRADE = 6;
+    constexpr size_t TRADE_BYTES = sizeof(BacktestTrade) + 2 * sizeof(double);
+    
+    static_assert((size_t(1) << (EXIT_TABLE_LEVELS - 1)) <= ExitResolver::MAX_HOLDING_BARS &&
+                  (size_t(1) << EXIT_TABLE_LEVELS) > ExitResolver::MAX_HOLDING_BARS,
+                  "EXIT_TABLE_LEVELS must match ExitResolver's table depth");
+    
+    bool cachedRowCount(const std::string& filePath, std::uint64_t& rows) {
+        std::ifstream cache(CandleCache::cachePathFor(filePath), std::ios::binary);
+        if (!cache.is_open()) {
+            return false;
+        }
+        
+        CandleCacheHeader header;
+        if (!cache.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            return false;
+        }
+        
+        std::error_code ec;
+        auto sourceSize = std::filesystem::file_size(filePath, ec);
+        if (ec || std::memcmp(header.magic, "TCCANDLE", sizeof(header.magic)) != 0 ||
+            header.version != CandleCache::VERSION || header.sourceSize != sourceSize) {
+            return false;
+        }
+        
+        rows = header.rowCount;
+        return true;
+    }
+    
+    std::uint64_t sampledRowCount(const std::string& filePath, std::uintmax_t fileSize) {
+        std::ifstream file(filePath, std::ios::binary);
+        if (!file.is_open()) {
+            return 0;
+        }
+        
+        std::vector<char> buffer(static_cast<size_t>(SAMPLE_BYTES));
+        file.read(buffer.data(), SAMPLE_BYTES);
+        std::streamsize bytesRead = file.gcount();
+        size_t lines = static_cast<size_t>(std::count(buffer.data(), buffer.data() + bytesRead, '\n'));
+        if (lines == 0) {
+            return 1;
+        }
+        
+        double averageLineLength = static_cast<double>(bytesRead) / static_cast<double>(lines);
+        return static_cast<std::uint64_t>(static_cast<double>(fileSize) / averageLineLength) + 1;
+    }
+}
+
+MemoryBudget::MemoryBudget(size_t budgetBytes)
+    : m_budgetBytes(budgetBytes) {
+}
+
+bool MemoryBudget::acquire(size_t bytes) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    
+    auto fits = [this, bytes] {
+        return m_budgetBytes == 0 || m_inFlight == 0 || m_reservedBytes + bytes <= m_budgetBytes;
+    };
+    
+    bool waited = false;
+    if (!fits()) {
+        waited = true;
+        m_throttleCount++;
+        auto waitStart = std::chrono::steady_clock::now();
+        m_released.wait(lock, fits);
+        m_throttleTime += std::chrono::steady_clock::now() - waitStart;
+    }
+    
+    m_reservedBytes += bytes;
+    m_inFlight++;
+    m_peakReservedBytes = std::max(m_peakReservedBytes, m_reservedBytes);
+    return waited;
+}
+
+void MemoryBudget::release(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reservedBytes -= std::min(bytes, m_reservedBytes);
+        if (m_inFlight > 0) {
+            m_inFlight--;
+        }
+    }
+    m_released.notify_all();
+}
+
+void MemoryBudget::retain(size_t bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reservedBytes += bytes;
+    m_peakReservedBytes = std::max(m_peakReservedBytes, m_reservedBytes);
+}
+
+void MemoryBudget::releaseRetained(size_t bytes) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_reservedBytes -= std::min(bytes, m_reservedBytes);
+    }
+    m_released.notify_all();
+}
+
+size_t MemoryBudget::getThrottleCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_throttleCount;
+}
+
+std::chrono::milliseconds MemoryBudget::getThrottleTime() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(m_throttleTime);
+}
+
+size_t MemoryBudget::getPeakReservedBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_peakReservedBytes;
+}
+
+size_t MemoryBudget::estimateStrategyBytes(const std::string& filePath) {
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(filePath, ec);
+    if (ec) {
+        return 0;
+    }
+    
+    std::uint64_t rows = 0;
+    size_t sourceBytes = 0;
+    if (!cachedRowCount(filePath, rows)) {
+        rows = sampledRowCount(filePath, fileSize);
+        sourceBytes = static_cast<size_t>(fileSize);  // Mapped CSV pages while parsing
+    }
+    
+    size_t perRow = CANDLE_BYTES + SIGNAL_BYTES + EXIT_TABLE_BYTES;
+    size_t trades = static_cast<size_t>(rows / BARS_PER_TRADE) + 1;
+    return sourceBytes + static_cast<size_t>(rows) * perRow + trades * TRADE_BYTES;
+}
+
+} // namespace Backtest
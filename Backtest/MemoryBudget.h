@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace Backtest {
+    /**
+     * @brief Admission control for batch runs against a memory limit
+     *
+     * Each strategy reserves its estimated footprint before it is queued and
+     * returns it when it finishes. A reservation that does not fit blocks the
+     * caller until enough memory is released. A single strategy larger than the
+     * whole budget is still admitted, but only when nothing else is in flight.
+     */
+    class MemoryBudget {
+    public:
+        /**
+         * @brief Constructor
+         * @param budgetBytes Bytes available to strategies (0 = unlimited)
+         */
+        explicit MemoryBudget(size_t budgetBytes);
+        
+        /**
+         * @brief Reserve memory, blocking until it fits
+         * @param bytes Estimated footprint
+         * @return True if the call had to wait
+         */
+        bool acquire(size_t bytes);
+        
+        /**
+         * @brief Return a reservation made with acquire()
+         * @param bytes The reserved amount
+         */
+        void release(size_t bytes);
+        
+        /**
+         * @brief Account for memory that stays resident after a task finishes
+         *        (e.g. results kept for the report, queued chart data). Never blocks.
+         * @param bytes Retained amount
+         */
+        void retain(size_t bytes);
+        
+        /**
+         * @brief Return memory accounted with retain() once it has been freed
+         * @param bytes The retained amount
+         */
+        void releaseRetained(size_t bytes);
+        
+        /**
+         * @return Number of acquire() calls that had to wait
+         */
+        size_t getThrottleCount() const;
+        
+        /**
+         * @return Total time spent waiting in acquire()
+         */
+        std::chrono::milliseconds getThrottleTime() const;
+        
+        /**
+         * @return Highest total reservation seen
+         */
+        size_t getPeakReservedBytes() const;
+        
+        /**
+         * @brief Estimate the peak memory a strategy file needs while it runs
+         *
+         * Row count comes from the candle cache header when a current cache
+         * exists, otherwise from the average line length of the first 64 KB.
+         * Per row it counts the candle columns, signal mask and exit tables,
+         * plus trade records and curves for the densest possible trade rate.
+         * Without a cache the mapped CSV itself is counted as well.
+         * @param filePath Strategy CSV
+         * @return Estimated bytes
+         */
+        static size_t estimateStrategyBytes(const std::string& filePath);
+        
+    private:
+        mutable std::mutex m_mutex;
+        std::condition_variable m_released;
+        size_t m_budgetBytes;
+        size_t m_reservedBytes = 0;
+        size_t m_inFlight = 0;
+        size_t m_peakReservedBytes = 0;
+        size_t m_throttleCount = 0;
+        std::chrono::steady_clock::duration m_throttleTime{0};
+    };
+}
@@ -0,0 +1,206 @@
+#include "ParameterSweep.h"
+#include "../Utils/Philox.h"
+#include "../Utils/WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace Backtest {
+    std::vector<double> ParameterRange::gridValues() const {
+        if (!(step > 0.0) || !(max > min)) {
+            return {min};
+        }
+
+        // Multiply rather than accumulate so the last value does not drift past max
+        std::size_t count = static_cast<std::size_t>(std::floor((max - min) / step + 1e-9)) + 1;
+        std::vector<double> values;
+        values.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            values.push_back(min + static_cast<double>(i) * step);
+        }
+        return values;
+    }
+
+    bool ParameterSweep::loadPriceData(const std::string& filename) {
+        return m_data.loadPriceData(filename);
+    }
+
+    void ParameterSweep::setPriceData(std::shared_ptr<const CandleSeries> series) {
+        m_data.setPriceData(std::move(series));
+    }
+
+    std::vector<BacktestConfig> ParameterSweep::expand(const SweepSpec& spec) {
+        std::vector<std::vector<double>> axes;
+        axes.reserve(spec.ranges.size());
+        for (const auto& range : spec.ranges) {
+            axes.push_back(range.gridValues());
+        }
+
+        std::vector<BacktestConfig> configs;
+
+        if (spec.mode == SweepMode::Random) {
+            Utils::PhiloxStream rng(spec.seed, 0);
+            configs.reserve(spec.samples);
+            for (std::size_t sample = 0; sample < spec.samples; ++sample) {
+                BacktestConfig config = spec.base;
+                for (std::size_t axis = 0; axis < axes.size(); ++axis) {
+                    const ParameterRange& range = spec.ranges[axis];
+                    double u = rng.nextUniform();
+                    double value;
+                    if (range.step > 0.0) {
+                        std::size_t pick = std::min(axes[axis].size() - 1,
+                                                    static_cast<std::size_t>(u * axes[axis].size()));
+                        value = axes[axis][pick];
+                    } else {
+                        value = range.min + u * (range.max - range.min);
+                    }
+                    applyParameter(config, range.parameter, value);
+                }
+                configs.push_back(config);
+            }
+            return configs;
+        }
+
+        // Grid: odometer over the axes, last range varying fastest
+        std::size_t total = 1;
+        for (const auto& values : axes) {
+            total *= values.size();
+        }
+        configs.reserve(total);
+
+        std::vector<std::size_t> position(axes.size(), 0);
+        for (std::size_t n = 0; n < total; ++n) {
+            BacktestConfig config = spec.base;
+            for (std::size_t axis = 0; axis < axes.size(); ++axis) {
+                applyParameter(config, spec.ranges[axis].parameter, axes[axis][position[axis]]);
+            }
+            configs.push_back(config);
+
+            for (std::size_t axis = axes.size(); axis-- > 0;) {
+                if (++position[axis] < axes[axis].size()) {
+                    break;
+                }
+                position[axis] = 0;
+            }
+        }
+        return configs;
+    }
+
+    SweepResult ParameterSweep::evaluate(const BacktestConfig& config, const BarRange& range) const {
+        Backtester backtester;
+        backtester.sharePriceData(m_data);
+        backtester.setRange(range);
+        backtester.setConfig(config);
+        return summarize(config, backtester.runBacktest());
+    }
+
+    SweepResult ParameterSweep::summarize(const BacktestConfig& config, const BacktestResult& backtest) {
+        SweepResult result;
+        result.config = config;
+        result.totalTrades = backtest.totalTrades;
+        result.winningTrades = backtest.winningTrades;
+        result.losingTrades = backtest.losingTrades;
+        result.winRate = backtest.winRate;
+        result.profitFactor = backtest.profitFactor;
+        result.netProfit = backtest.netProfit;
+        result.percentGain = backtest.stats.percentGain;
+        result.maxDrawdownPercent = backtest.stats.maxDrawdownPercent;
+        result.sharpeRatio = backtest.stats.sharpeRatio;
+        return result;
+    }
+
+    std::vector<SweepResult> ParameterSweep::run(const SweepSpec& spec, SweepRanking ranking) const {
+        if (!m_data.hasPriceData()) {
+            return {};
+        }
+        Utils::WorkStealingPool pool(spec.threadCount);
+        return run(spec, ranking, BarRange(), pool);
+    }
+
+    std::vector<SweepResult> ParameterSweep::run(const SweepSpec& spec, SweepRanking ranking,
+                                                 const BarRange& range, Utils::WorkStealingPool& pool) const {
+        std::vector<BacktestConfig> configs = expand(spec);
+        if (configs.empty() || !m_data.hasPriceData()) {
+            return {};
+        }
+        std::vector<SweepResult> results(configs.size());
+
+        // Each evaluation writes only its own slot, so the merge is in expansion order
+        pool.parallelFor(configs.size(), [&](std::size_t i) {
+            results[i] = evaluate(configs[i], range);
+            results[i].index = i;
+        });
+
+        rank(results, ranking);
+        return results;
+    }
+
+    void ParameterSweep::rank(std::vector<SweepResult>& results, SweepRanking ranking) {
+        auto key = [ranking](const SweepResult& result) {
+            switch (ranking) {
+                case SweepRanking::ProfitFactor: return result.profitFactor;
+                case SweepRanking::SharpeRatio: return result.sharpeRatio;
+                case SweepRanking::WinRate: return result.winRate;
+                case SweepRanking::MaxDrawdown: return -result.maxDrawdownPercent;
+                case SweepRanking::NetProfit:
+                default: return result.netProfit;
+            }
+        };
+
+        // NaN keys (e.g. no trades) sort last
+        std::stable_sort(results.begin(), results.end(), [&key](const SweepResult& a, const SweepResult& b) {
+            double ka = key(a);
+            double kb = key(b);
+            if (std::isnan(kb)) return !std::isnan(ka);
+            return ka > kb;
+        });
+    }
+
+    bool ParameterSweep::exportCsv(const std::vector<SweepResult>& results, const std::string& filename) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        file << "Rank,Index,Risk Per Trade (%),Stop Loss (pips),Take Profit (pips),Risk Reward,"
+             << "Trades,Win Rate (%),Profit Factor,Net Profit,Gain (%),Max Drawdown (%),Sharpe Ratio\n";
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const SweepResult& result = results[i];
+            file << i + 1 << ","
+                 << result.index << ","
+                 << result.config.riskPerTrade << ","
+                 << result.config.stopLossPips << ","
+                 << result.config.takeProfitPips << ","
+                 << result.config.riskRewardRatio << ","
+                 << result.totalTrades << ","
+                 << result.winRate << ","
+                 << result.profitFactor << ","
+                 << result.netProfit << ","
+                 << result.percentGain << ","
+                 << result.maxDrawdownPercent << ","
+                 << result.sharpeRatio << "\n";
+        }
+
+        return file.good();
+    }
+
+    void ParameterSweep::applyParameter(BacktestConfig& config, SweepParameter parameter, double value) {
+        switch (parameter) {
+            case SweepParameter::RiskPerTrade: config.riskPerTrade = value; break;
+            case SweepParameter::StopLossPips: config.stopLossPips = value; break;
+            case SweepParameter::TakeProfitPips: config.takeProfitPips = value; break;
+            case SweepParameter::RiskRewardRatio: config.riskRewardRatio = value; break;
+        }
+    }
+
+    const char* ParameterSweep::parameterName(SweepParameter parameter) {
+        switch (parameter) {
+            case SweepParameter::RiskPerTrade: return "riskPerTrade";
+            case SweepParameter::StopLossPips: return "stopLossPips";
+            case SweepParameter::TakeProfitPips: return "takeProfitPips";
+            case SweepParameter::RiskRewardRatio: return "riskRewardRatio";
+        }
+        return "unknown";
+    }
+}
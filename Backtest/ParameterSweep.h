@@ -0,0 +1,126 @@
+#ifndef BACKTEST_PARAMETER_SWEEP_H
+#define BACKTEST_PARAMETER_SWEEP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Backtester.h"
+
+namespace Utils {
+    class WorkStealingPool;
+}
+
+namespace Backtest {
+    // BacktestConfig fields a sweep can vary
+    enum class SweepParameter {
+        RiskPerTrade,
+        StopLossPips,
+        TakeProfitPips,
+        RiskRewardRatio
+    };
+
+    // Values tried for one parameter. A grid uses min, min + step, ... up to
+    // max (just min when step <= 0). Random sampling draws uniformly from
+    // those grid values when step > 0, otherwise from [min, max].
+    struct ParameterRange {
+        SweepParameter parameter = SweepParameter::RiskPerTrade;
+        double min = 0.0;
+        double max = 0.0;
+        double step = 0.0;
+
+        std::vector<double> gridValues() const;
+    };
+
+    enum class SweepMode {
+        Grid,    // Every combination of the ranges' grid values
+        Random   // `samples` independent draws
+    };
+
+    struct SweepSpec {
+        BacktestConfig base;                 // Every field not swept
+        std::vector<ParameterRange> ranges;
+        SweepMode mode = SweepMode::Grid;
+        std::size_t samples = 100;           // Random mode only
+        std::uint64_t seed = 0x5EED;         // Random mode only; same seed, same samples
+        unsigned int threadCount = 0;        // 0 = hardware concurrency
+    };
+
+    // Sort order of sweep results; every ranking puts the best first
+    enum class SweepRanking {
+        NetProfit,
+        ProfitFactor,
+        SharpeRatio,
+        WinRate,
+        MaxDrawdown   // Smallest drawdown first
+    };
+
+    // Summary of one evaluated parameter set (trades and curves are not kept)
+    struct SweepResult {
+        std::size_t index = 0;  // Position in the expanded parameter list
+        BacktestConfig config;
+
+        int totalTrades = 0;
+        int winningTrades = 0;
+        int losingTrades = 0;
+        double winRate = 0.0;
+        double profitFactor = 0.0;
+        double netProfit = 0.0;
+        double percentGain = 0.0;
+        double maxDrawdownPercent = 0.0;
+        double sharpeRatio = 0.0;
+    };
+
+    // Runs many BacktestConfig variants over one price series. The series is
+    // loaded once; its entry-signal mask and exit tables are built once and
+    // shared read-only by every evaluation, so a parameter set costs only the
+    // trade loop. Evaluations run in parallel on a work-stealing pool and
+    // results do not depend on the thread count.
+    class ParameterSweep {
+    public:
+        ParameterSweep() = default;
+
+        // Load candles (through the candle cache when present)
+        bool loadPriceData(const std::string& filename);
+
+        // Use candles that are already loaded
+        void setPriceData(std::shared_ptr<const CandleSeries> series);
+
+        // Backtester holding the shared data, e.g. to set the loader mode
+        Backtester& getDataSource() { return m_data; }
+        const Backtester& getDataSource() const { return m_data; }
+
+        // Every parameter set the spec describes, in evaluation order
+        static std::vector<BacktestConfig> expand(const SweepSpec& spec);
+
+        // Evaluate every parameter set and return them ranked best first
+        std::vector<SweepResult> run(const SweepSpec& spec,
+                                     SweepRanking ranking = SweepRanking::NetProfit) const;
+
+        // Same, over a slice of the series and on a caller's pool (spec.threadCount
+        // is ignored). May be called from inside one of the pool's tasks.
+        std::vector<SweepResult> run(const SweepSpec& spec, SweepRanking ranking,
+                                     const BarRange& range, Utils::WorkStealingPool& pool) const;
+
+        // Evaluate one parameter set against the shared data
+        SweepResult evaluate(const BacktestConfig& config, const BarRange& range = BarRange()) const;
+
+        // Summary of a finished backtest of `config`
+        static SweepResult summarize(const BacktestConfig& config, const BacktestResult& backtest);
+
+        // Stable sort (ties keep expansion order)
+        static void rank(std::vector<SweepResult>& results, SweepRanking ranking);
+
+        // One row per result with the swept parameters and summary statistics
+        static bool exportCsv(const std::vector<SweepResult>& results, const std::string& filename);
+
+        static void applyParameter(BacktestConfig& config, SweepParameter parameter, double value);
+        static const char* parameterName(SweepParameter parameter);
+
+    private:
+        Backtester m_data;  // Loaded once; evaluations share its series, signals and exit tables
+    };
+}
+
+#endif // BACKTEST_PARAMETER_SWEEP_H
@@ -0,0 +1,258 @@
+#include "PriceDataLoader.h"
+#include "MappedFile.h"
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+
+namespace Backtest {
+    namespace {
+        // Days since 1970-01-01 for a proleptic Gregorian date
+        std::int64_t daysFromCivil(int year, unsigned month, unsigned day) {
+            year -= month <= 2 ? 1 : 0;
+            const int era = (year >= 0 ? year : year - 399) / 400;
+            const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+            const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+            return static_cast<std::int64_t>(era) * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+        }
+
+        // Read exactly `digits` decimal digits
+        bool readFixed(const char*& p, const char* last, int digits, int& value) {
+            if (last - p < digits) {
+                return false;
+            }
+            value = 0;
+            for (int i = 0; i < digits; ++i) {
+                unsigned d = static_cast<unsigned char>(p[i]) - '0';
+                if (d > 9) {
+                    return false;
+                }
+                value = value * 10 + static_cast<int>(d);
+            }
+            p += digits;
+            return true;
+        }
+
+        bool expect(const char*& p, const char* last, char c) {
+            if (p == last || *p != c) {
+                return false;
+            }
+            ++p;
+            return true;
+        }
+
+        // Parse one numeric field, tolerating surrounding spaces
+        bool parseDouble(const char* first, const char* last, double& value) {
+            while (first < last && *first == ' ') ++first;
+            while (last > first && (last[-1] == ' ' || last[-1] == '\r')) --last;
+            if (first < last && *first == '+') ++first;
+            auto [ptr, ec] = std::from_chars(first, last, value);
+            return ec == std::errc() && ptr == last;
+        }
+    }
+
+    bool PriceDataLoader::parseTimestamp(const char* first, const char* last, std::time_t& timestamp) {
+        const char* p = first;
+        int year = 0, month = 0, day = 0;
+        int hour = 0, minute = 0, second = 0;
+
+        if (!readFixed(p, last, 4, year) || !expect(p, last, '-') ||
+            !readFixed(p, last, 2, month) || !expect(p, last, '-') ||
+            !readFixed(p, last, 2, day)) {
+            return false;
+        }
+
+        if (p != last && (*p == ' ' || *p == 'T')) {
+            ++p;
+            if (!readFixed(p, last, 2, hour) || !expect(p, last, ':') ||
+                !readFixed(p, last, 2, minute)) {
+                return false;
+            }
+            if (p != last && *p == ':' && !(++p, readFixed(p, last, 2, second))) {
+                return false;
+            }
+        }
+
+        while (p != last && (*p == ' ' || *p == '\r')) ++p;
+        if (p != last || month < 1 || month > 12 || day < 1 || day > 31 ||
+            hour > 23 || minute > 59 || second > 60) {
+            return false;
+        }
+
+        std::int64_t days = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+        timestamp = static_cast<std::time_t>(days * 86400 + hour * 3600 + minute * 60 + second);
+        return true;
+    }
+
+    bool PriceDataLoader::loadStream(const std::string& filename, CandleSeries& candles,
+                                     LoaderStats& stats) {
+        auto startTime = std::chrono::steady_clock::now();
+        stats = LoaderStats();
+
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+
+        candles.clear();
+
+        std::string line;
+        std::getline(file, line); // Skip header line
+        stats.bytes += line.size() + 1;
+
+        while (std::getline(file, line)) {
+            stats.bytes += line.size() + 1;
+
+            std::stringstream ss(line);
+            std::string field;
+            CandleData candle;
+
+            // Parse date/time
+            std::getline(ss, field, ',');
+            std::tm tm = {};
+            std::istringstream dateStream(field);
+            dateStream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+            candle.timestamp = std::mktime(&tm);
+
+            // Parse OHLC
+            std::getline(ss, field, ',');
+            candle.open = std::stod(field);
+
+            std::getline(ss, field, ',');
+            candle.high = std::stod(field);
+
+            std::getline(ss, field, ',');
+            candle.low = std::stod(field);
+
+            std::getline(ss, field, ',');
+            candle.close = std::stod(field);
+
+            // Parse volume if available
+            if (std::getline(ss, field, ',')) {
+                try {
+                    candle.volume = std::stod(field);
+                } catch (...) {
+                    candle.volume = 0.0;
+                }
+            }
+
+            candles.push_back(candle);
+        }
+
+        file.close();
+
+        // Sort by timestamp if needed
+        stats.sortSkipped = candles.isSortedByTimestamp();
+        candles.sortByTimestamp();
+        stats.rows = candles.size();
+
+        finishStats(stats, std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+        return !candles.empty();
+    }
+
+    bool PriceDataLoader::loadMapped(const std::string& filename, CandleSeries& candles,
+                                     LoaderStats& stats) {
+        auto startTime = std::chrono::steady_clock::now();
+        stats = LoaderStats();
+
+        MappedFile file;
+        if (!file.open(filename)) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+
+        candles.clear();
+        stats.bytes = file.size();
+
+        const char* p = file.data();
+        const char* const end = p + file.size();
+
+        // Skip header line
+        const char* headerEnd = p ? static_cast<const char*>(std::memchr(p, '\n', end - p)) : nullptr;
+        if (!headerEnd) {
+            return false;
+        }
+        p = headerEnd + 1;
+
+        // Size the output from the first data row to avoid regrowth
+        const char* firstRowEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        std::size_t firstRowLength = firstRowEnd ? static_cast<std::size_t>(firstRowEnd - p) + 1 : 0;
+        if (firstRowLength > 0) {
+            candles.reserve(static_cast<std::size_t>(end - p) / firstRowLength + 1);
+        }
+
+        bool monotonic = true;
+        std::time_t lastTimestamp = std::numeric_limits<std::time_t>::min();
+        const char* fields[8];
+
+        while (p < end) {
+            const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!lineEnd) {
+                lineEnd = end;
+            }
+
+            // Locate the first six comma-separated fields; extra columns are ignored
+            int fieldCount = 0;
+            fields[fieldCount++] = p;
+            for (const char* c = p; c < lineEnd && fieldCount < 7; ++c) {
+                if (*c == ',') {
+                    fields[fieldCount++] = c + 1;
+                }
+            }
+            fields[fieldCount] = lineEnd + 1;
+
+            // Blank lines (including a trailing newline) are not rows
+            bool blank = (lineEnd == p) || (lineEnd - p == 1 && *p == '\r');
+            if (!blank) {
+                CandleData candle;
+                bool valid = fieldCount >= 5 &&
+                    parseTimestamp(fields[0], fields[1] - 1, candle.timestamp) &&
+                    parseDouble(fields[1], fields[2] - 1, candle.open) &&
+                    parseDouble(fields[2], fields[3] - 1, candle.high) &&
+                    parseDouble(fields[3], fields[4] - 1, candle.low) &&
+                    parseDouble(fields[4], fields[5] - 1, candle.close);
+
+                if (valid) {
+                    if (fieldCount >= 6 && !parseDouble(fields[5], fields[6] - 1, candle.volume)) {
+                        candle.volume = 0.0;
+                    }
+
+                    if (candle.timestamp < lastTimestamp) {
+                        monotonic = false;
+                    }
+                    lastTimestamp = candle.timestamp;
+                    candles.push_back(candle);
+                } else {
+                    stats.rejectedRows++;
+                }
+            }
+
+            p = lineEnd + 1;
+        }
+
+        // Already-ordered files (the common case) skip the sort entirely
+        stats.sortSkipped = monotonic;
+        if (!monotonic) {
+            candles.sortByTimestamp();
+        }
+        stats.rows = candles.size();
+
+        finishStats(stats, std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+        return !candles.empty();
+    }
+
+    void PriceDataLoader::finishStats(LoaderStats& stats, double seconds) {
+        stats.seconds = seconds;
+        if (seconds > 0.0) {
+            stats.rowsPerSecond = static_cast<double>(stats.rows) / seconds;
+            stats.bytesPerSecond = static_cast<double>(stats.bytes) / seconds;
+        }
+    }
+}
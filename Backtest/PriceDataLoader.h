@@ -0,0 +1,32 @@
+#ifndef BACKTEST_PRICE_DATA_LOADER_H
+#define BACKTEST_PRICE_DATA_LOADER_H
+
+#include <string>
+#include <ctime>
+#include "Backtester.h"
+#include "CandleSeries.h"
+
+namespace Backtest {
+    // CSV readers behind Backtester::loadPriceData.
+    // Expected layout: header line, then "timestamp,open,high,low,close[,volume]".
+    class PriceDataLoader {
+    public:
+        // Original line-by-line reader (iostreams, std::get_time, std::mktime)
+        static bool loadStream(const std::string& filename, CandleSeries& candles,
+                               LoaderStats& stats);
+
+        // Memory-mapped reader that parses fields in place with std::from_chars.
+        // Timestamps are read as UTC and malformed rows are skipped.
+        static bool loadMapped(const std::string& filename, CandleSeries& candles,
+                               LoaderStats& stats);
+
+        // Parse "YYYY-MM-DD", "YYYY-MM-DD HH:MM" or "YYYY-MM-DD HH:MM:SS" (a 'T'
+        // separator is accepted too) as seconds since the Unix epoch, UTC.
+        static bool parseTimestamp(const char* first, const char* last, std::time_t& timestamp);
+
+    private:
+        static void finishStats(LoaderStats& stats, double seconds);
+    };
+}
+
+#endif // BACKTEST_PRICE_DATA_LOADER_H
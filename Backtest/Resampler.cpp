@@ -0,0 +1,193 @@
+#include "Resampler.h"
+#include "CandleCache.h"
+#include <stdexcept>
+
+namespace Backtest {
+    const TimeframeBars* MultiTimeframeSeries::find(Timeframe timeframe) const {
+        for (const auto& level : m_levels) {
+            if (level.timeframe == timeframe) {
+                return &level;
+            }
+        }
+        return nullptr;
+    }
+
+    const TimeframeBars& MultiTimeframeSeries::level(Timeframe timeframe) const {
+        const TimeframeBars* found = find(timeframe);
+        if (!found) {
+            throw std::out_of_range(std::string("Timeframe not built: ") + Resampler::timeframeName(timeframe));
+        }
+        return *found;
+    }
+
+    const CandleSeries& MultiTimeframeSeries::bars(Timeframe timeframe) const {
+        return level(timeframe).bars;
+    }
+
+    std::size_t MultiTimeframeSeries::barIndex(Timeframe timeframe, std::size_t baseIndex) const {
+        return level(timeframe).baseToBar[baseIndex];
+    }
+
+    std::size_t MultiTimeframeSeries::closedBarIndex(Timeframe timeframe, std::size_t baseIndex) const {
+        const TimeframeBars& found = level(timeframe);
+        std::size_t bar = found.baseToBar[baseIndex];
+
+        // The bar is complete when this is its last base bar (or the data ends)
+        bool last = baseIndex + 1 == found.baseToBar.size() || found.baseToBar[baseIndex + 1] != bar;
+        if (last) {
+            return bar;
+        }
+        return bar == 0 ? NO_BAR : bar - 1;
+    }
+
+    const std::vector<Timeframe>& Resampler::standardTimeframes() {
+        static const std::vector<Timeframe> timeframes = {
+            Timeframe::M5, Timeframe::M15, Timeframe::H1, Timeframe::H4, Timeframe::D1
+        };
+        return timeframes;
+    }
+
+    const char* Resampler::timeframeName(Timeframe timeframe) {
+        switch (timeframe) {
+            case Timeframe::M5: return "M5";
+            case Timeframe::M15: return "M15";
+            case Timeframe::H1: return "H1";
+            case Timeframe::H4: return "H4";
+            case Timeframe::D1: return "D1";
+        }
+        return "unknown";
+    }
+
+    std::int64_t Resampler::bucketStart(std::int64_t timestamp, Timeframe timeframe) {
+        // Floor division, so timestamps before the epoch fall in the right bar
+        std::int64_t length = static_cast<std::int64_t>(timeframe);
+        std::int64_t bucket = timestamp / length;
+        if (timestamp % length < 0) {
+            --bucket;
+        }
+        return bucket * length;
+    }
+
+    void Resampler::resample(const CandleSeries& base, std::vector<TimeframeBars*>& levels) {
+        std::size_t rows = base.size();
+        const std::int64_t* timestamp = base.timestamp();
+        const double* open = base.open();
+        const double* high = base.high();
+        const double* low = base.low();
+        const double* close = base.close();
+        const double* volume = base.volume();
+
+        // Bar being filled for each level
+        std::vector<CandleData> current(levels.size());
+        std::vector<std::int64_t> currentStart(levels.size());
+
+        for (TimeframeBars* level : levels) {
+            level->bars.clear();
+            level->baseToBar.resize(rows);
+        }
+
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t l = 0; l < levels.size(); ++l) {
+                TimeframeBars& level = *levels[l];
+                CandleData& bar = current[l];
+                std::int64_t start = bucketStart(timestamp[i], level.timeframe);
+
+                if (i == 0 || start != currentStart[l]) {
+                    if (i != 0) {
+                        level.bars.push_back(bar);
+                    }
+                    currentStart[l] = start;
+                    bar.timestamp = static_cast<std::time_t>(start);
+                    bar.open = open[i];
+                    bar.high = high[i];
+                    bar.low = low[i];
+                    bar.close = close[i];
+                    bar.volume = volume[i];
+                } else {
+                    // Comparisons skip NaN highs/lows after the first bar
+                    if (high[i] > bar.high) bar.high = high[i];
+                    if (low[i] < bar.low) bar.low = low[i];
+                    bar.close = close[i];
+                    bar.volume += volume[i];
+                }
+                level.baseToBar[i] = static_cast<std::uint32_t>(level.bars.size());
+            }
+        }
+
+        if (rows > 0) {
+            for (std::size_t l = 0; l < levels.size(); ++l) {
+                levels[l]->bars.push_back(current[l]);
+            }
+        }
+    }
+
+    bool Resampler::mapBaseToBars(const CandleSeries& base, TimeframeBars& level) {
+        // Merge walk over both (sorted) timestamp columns
+        std::size_t rows = base.size();
+        std::size_t barCount = level.bars.size();
+        const std::int64_t* barStart = level.bars.timestamp();
+        level.baseToBar.resize(rows);
+
+        std::size_t bar = 0;
+        for (std::size_t i = 0; i < rows; ++i) {
+            std::int64_t start = bucketStart(base.timestamp()[i], level.timeframe);
+            while (bar < barCount && barStart[bar] < start) {
+                ++bar;
+            }
+            if (bar == barCount || barStart[bar] != start) {
+                return false;  // Bars do not belong to this base series
+            }
+            level.baseToBar[i] = static_cast<std::uint32_t>(bar);
+        }
+        return rows == 0 || bar + 1 == barCount;
+    }
+
+    std::shared_ptr<const MultiTimeframeSeries> Resampler::build(std::shared_ptr<const CandleSeries> base,
+                                                                 const std::vector<Timeframe>& timeframes) {
+        auto result = std::make_shared<MultiTimeframeSeries>();
+        result->m_levels.resize(timeframes.size());
+
+        std::vector<TimeframeBars*> levels;
+        for (std::size_t l = 0; l < timeframes.size(); ++l) {
+            result->m_levels[l].timeframe = timeframes[l];
+            levels.push_back(&result->m_levels[l]);
+        }
+
+        resample(*base, levels);
+        result->m_base = std::move(base);
+        return result;
+    }
+
+    std::shared_ptr<const MultiTimeframeSeries> Resampler::load(const std::string& csvFilename, LoaderMode mode,
+                                                                const SourceSignature& source,
+                                                                std::shared_ptr<const CandleSeries> base,
+                                                                const std::vector<Timeframe>& timeframes) {
+        auto result = std::make_shared<MultiTimeframeSeries>();
+        result->m_levels.resize(timeframes.size());
+
+        // Cached timeframes only need their index map; the rest are resampled together
+        std::vector<TimeframeBars*> missing;
+        for (std::size_t l = 0; l < timeframes.size(); ++l) {
+            TimeframeBars& level = result->m_levels[l];
+            level.timeframe = timeframes[l];
+
+            LoaderStats stats;
+            bool cached = CandleCache::load(csvFilename, timeframeName(level.timeframe), mode, level.bars, stats) &&
+                          mapBaseToBars(*base, level);
+            if (!cached) {
+                missing.push_back(&level);
+            }
+        }
+
+        if (!missing.empty()) {
+            resample(*base, missing);
+            // Write failures only cost the next load a resample
+            for (TimeframeBars* level : missing) {
+                CandleCache::write(csvFilename, timeframeName(level->timeframe), mode, level->bars, source);
+            }
+        }
+
+        result->m_base = std::move(base);
+        return result;
+    }
+}
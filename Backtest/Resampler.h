@@ -0,0 +1,98 @@
+#ifndef BACKTEST_RESAMPLER_H
+#define BACKTEST_RESAMPLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CandleSeries.h"
+
+namespace Backtest {
+    enum class LoaderMode;
+    struct SourceSignature;
+
+    // Higher timeframes, by bar length in seconds. Bars start on multiples of
+    // their length since the epoch, so D1 bars are UTC days.
+    enum class Timeframe : std::uint32_t {
+        M5 = 300,
+        M15 = 900,
+        H1 = 3600,
+        H4 = 14400,
+        D1 = 86400
+    };
+
+    // One timeframe built from a base series
+    struct TimeframeBars {
+        Timeframe timeframe = Timeframe::M5;
+        CandleSeries bars;                      // Timestamp = bar start
+        std::vector<std::uint32_t> baseToBar;   // Bar containing each base bar
+    };
+
+    // A base series with its higher timeframes and O(1) lookups from a base
+    // index to the aligned higher-timeframe bar. Immutable once built, so it
+    // can be shared between backtests and threads.
+    class MultiTimeframeSeries {
+    public:
+        static constexpr std::size_t NO_BAR = static_cast<std::size_t>(-1);
+
+        const CandleSeries& base() const { return *m_base; }
+
+        bool has(Timeframe timeframe) const { return find(timeframe) != nullptr; }
+
+        // Bars of a timeframe; throws std::out_of_range if it was not built
+        const CandleSeries& bars(Timeframe timeframe) const;
+
+        // Bar that contains base bar baseIndex. It may still be forming at that
+        // point, so its close looks ahead of the base bar.
+        std::size_t barIndex(Timeframe timeframe, std::size_t baseIndex) const;
+
+        // Latest bar that is complete once base bar baseIndex has closed
+        // (NO_BAR before the first one closes). Safe to use without look-ahead.
+        std::size_t closedBarIndex(Timeframe timeframe, std::size_t baseIndex) const;
+
+        const std::vector<TimeframeBars>& levels() const { return m_levels; }
+
+    private:
+        friend class Resampler;
+
+        const TimeframeBars& level(Timeframe timeframe) const;
+        const TimeframeBars* find(Timeframe timeframe) const;
+
+        std::shared_ptr<const CandleSeries> m_base;
+        std::vector<TimeframeBars> m_levels;
+    };
+
+    // Builds higher timeframes from a sorted base series: open of the first
+    // base bar, highest high, lowest low, close of the last bar and summed
+    // volume per bucket. All requested timeframes are filled in one pass.
+    class Resampler {
+    public:
+        // M5, M15, H1, H4 and D1
+        static const std::vector<Timeframe>& standardTimeframes();
+
+        static std::shared_ptr<const MultiTimeframeSeries> build(
+            std::shared_ptr<const CandleSeries> base,
+            const std::vector<Timeframe>& timeframes = standardTimeframes());
+
+        // Same, keeping each timeframe in a candle cache next to the CSV
+        // ("<csv>.H1.tcc", ...). Current caches are loaded instead of resampled;
+        // missing or stale ones are rebuilt together in one pass and rewritten,
+        // stamped with the CSV signature taken before the base was loaded.
+        static std::shared_ptr<const MultiTimeframeSeries> load(
+            const std::string& csvFilename, LoaderMode mode, const SourceSignature& source,
+            std::shared_ptr<const CandleSeries> base,
+            const std::vector<Timeframe>& timeframes = standardTimeframes());
+
+        static const char* timeframeName(Timeframe timeframe);
+
+        // Start of the bar containing a timestamp
+        static std::int64_t bucketStart(std::int64_t timestamp, Timeframe timeframe);
+
+    private:
+        static void resample(const CandleSeries& base, std::vector<TimeframeBars*>& levels);
+        static bool mapBaseToBars(const CandleSeries& base, TimeframeBars& level);
+    };
+}
+
+#endif // BACKTEST_RESAMPLER_H
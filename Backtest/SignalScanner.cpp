@@ -0,0 +1,94 @@
+#include "SignalScanner.h"
+#include "../Utils/CpuFeatures.h"
+
+namespace Backtest {
+    namespace {
+        // Scalar rule for bars [begin, end); caller guarantees begin >= 1
+        void scanRange(const double* open, const double* close, std::uint8_t* flags,
+                       std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                bool isLong = close[i] > close[i - 1] && close[i] > open[i];
+                bool isShort = close[i] < close[i - 1] && close[i] < open[i];
+                flags[i] = static_cast<std::uint8_t>((isLong ? SIGNAL_LONG : 0) | (isShort ? SIGNAL_SHORT : 0));
+            }
+        }
+    }
+
+    bool SignalScanner::usesAvx2() {
+        return UTILS_HAS_X86_SIMD && Utils::cpuSupportsAvx2();
+    }
+
+    SignalMask SignalScanner::scan(const CandleSeries& series) {
+        SignalMask mask;
+        mask.flags.assign(series.size(), SIGNAL_NONE);
+        if (series.size() < 3) {
+            return mask;
+        }
+
+        if (usesAvx2()) {
+            scanAvx2(series, mask.flags.data());
+        } else {
+            scanScalar(series, mask.flags.data());
+        }
+
+        // Compact list of bars the backtest loop has to visit
+        for (std::size_t i = 1; i + 1 < series.size(); ++i) {
+            if (mask.flags[i] != SIGNAL_NONE) {
+                mask.candidates.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+        return mask;
+    }
+
+    void SignalScanner::scanScalar(const CandleSeries& series, std::uint8_t* flags) {
+        std::size_t n = series.size();
+        if (n < 3) {
+            return;
+        }
+        flags[0] = SIGNAL_NONE;
+        scanRange(series.open(), series.close(), flags, 1, n - 1);
+        flags[n - 1] = SIGNAL_NONE;
+    }
+
+#if UTILS_HAS_X86_SIMD
+    UTILS_TARGET_AVX2
+    void SignalScanner::scanAvx2(const CandleSeries& series, std::uint8_t* flags) {
+        std::size_t n = series.size();
+        if (n < 3) {
+            return;
+        }
+
+        const double* open = series.open();
+        const double* close = series.close();
+        std::size_t last = n - 1;  // Last bar is excluded
+        std::size_t i = 1;
+
+        flags[0] = SIGNAL_NONE;
+        for (; i + 4 <= last; i += 4) {
+            __m256d current = _mm256_loadu_pd(close + i);
+            __m256d previous = _mm256_loadu_pd(close + i - 1);
+            __m256d opens = _mm256_loadu_pd(open + i);
+
+            // Ordered comparisons: NaN never signals, as in the scalar rule
+            __m256d longMask = _mm256_and_pd(_mm256_cmp_pd(current, previous, _CMP_GT_OQ),
+                                             _mm256_cmp_pd(current, opens, _CMP_GT_OQ));
+            __m256d shortMask = _mm256_and_pd(_mm256_cmp_pd(current, previous, _CMP_LT_OQ),
+                                              _mm256_cmp_pd(current, opens, _CMP_LT_OQ));
+
+            int longBits = _mm256_movemask_pd(longMask);
+            int shortBits = _mm256_movemask_pd(shortMask);
+            for (int lane = 0; lane < 4; ++lane) {
+                flags[i + lane] = static_cast<std::uint8_t>(((longBits >> lane) & 1) |
+                                                            (((shortBits >> lane) & 1) << 1));
+            }
+        }
+
+        scanRange(open, close, flags, i, last);
+        flags[last] = SIGNAL_NONE;
+    }
+#else
+    void SignalScanner::scanAvx2(const CandleSeries& series, std::uint8_t* flags) {
+        scanScalar(series, flags);
+    }
+#endif
+}
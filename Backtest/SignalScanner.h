@@ -0,0 +1,39 @@
+#ifndef BACKTEST_SIGNAL_SCANNER_H
+#define BACKTEST_SIGNAL_SCANNER_H
+
+#include <cstdint>
+#include <vector>
+#include "CandleSeries.h"
+
+namespace Backtest {
+    // Per-bar entry flags produced by SignalScanner
+    enum SignalFlags : std::uint8_t {
+        SIGNAL_NONE = 0,
+        SIGNAL_LONG = 1,
+        SIGNAL_SHORT = 2
+    };
+
+    // Entry signals for a whole series, computed in one pass
+    struct SignalMask {
+        std::vector<std::uint8_t> flags;     // One SignalFlags value per bar
+        std::vector<std::uint32_t> candidates; // Indices of bars with any flag set
+    };
+
+    // Entry rule of the demonstration strategy, applied to the whole series:
+    //   long:  close > previous close && close > open
+    //   short: close < previous close && close < open
+    // The first and last bars never signal. The AVX2 kernel is chosen at
+    // runtime when the CPU supports it; results are identical to the scalar path.
+    class SignalScanner {
+    public:
+        static SignalMask scan(const CandleSeries& series);
+
+        // Individual kernels, exposed for testing and benchmarking
+        static void scanScalar(const CandleSeries& series, std::uint8_t* flags);
+        static void scanAvx2(const CandleSeries& series, std::uint8_t* flags);
+
+        static bool usesAvx2();
+    };
+}
+
+#endif // BACKTEST_SIGNAL_SCANNER_H
@@ -0,0 +1,387 @@
+#include "TickData.h"
+#include "CandleCache.h"
+#include "PriceDataLoader.h"
+#include "../Utils.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <vector>
+
+namespace Backtest {
+    namespace {
+        constexpr char TICK_MAGIC[8] = {'T', 'C', 'T', 'I', 'C', 'K', 'S', '\0'};
+        constexpr std::size_t COLUMN_COUNT = 3;
+
+        std::size_t alignUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        bool sourceSignature(const std::string& csvFilename, std::uint64_t& size, std::int64_t& mtime) {
+            std::error_code ec;
+            auto fileSize = std::filesystem::file_size(csvFilename, ec);
+            if (ec) {
+                return false;
+            }
+            auto writeTime = std::filesystem::last_write_time(csvFilename, ec);
+            if (ec) {
+                return false;
+            }
+            size = static_cast<std::uint64_t>(fileSize);
+            mtime = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+            return true;
+        }
+
+        // Parse one numeric field, tolerating surrounding spaces
+        bool parseDouble(const char* first, const char* last, double& value) {
+            while (first < last && *first == ' ') ++first;
+            while (last > first && (last[-1] == ' ' || last[-1] == '\r')) --last;
+            if (first < last && *first == '+') ++first;
+            auto [ptr, ec] = std::from_chars(first, last, value);
+            return ec == std::errc() && ptr == last;
+        }
+
+        // Maps UTC-read seconds to what the stream loader's std::mktime gives
+        // for the same fields (local time, tm_isdst = 0). mktime normalises
+        // the minute count and is called once per hour of ticks.
+        class LocalClock {
+        public:
+            std::int64_t toLocal(std::int64_t utcSeconds) {
+                std::int64_t hour = (utcSeconds >= 0 ? utcSeconds : utcSeconds - 3599) / 3600;
+                if (hour != m_hour) {
+                    std::tm tm = {};
+                    tm.tm_year = 70;
+                    tm.tm_mday = 1;
+                    tm.tm_min = static_cast<int>(hour * 60);
+                    m_offset = static_cast<std::int64_t>(std::mktime(&tm)) - hour * 3600;
+                    m_hour = hour;
+                }
+                return utcSeconds + m_offset;
+            }
+
+        private:
+            std::int64_t m_hour = std::numeric_limits<std::int64_t>::min();
+            std::int64_t m_offset = 0;
+        };
+
+        // PriceDataLoader timestamp with optional ".fff" (extra digits are
+        // truncated); read as UTC unless a local clock is given
+        bool parseTickTimestamp(const char* first, const char* last, LocalClock* local,
+                                std::int64_t& timestampMs) {
+            const char* dot = static_cast<const char*>(std::memchr(first, '.', last - first));
+            std::time_t parsed;
+            if (!PriceDataLoader::parseTimestamp(first, dot ? dot : last, parsed)) {
+                return false;
+            }
+            std::int64_t seconds = local ? local->toLocal(parsed) : static_cast<std::int64_t>(parsed);
+
+            int millis = 0;
+            if (dot) {
+                const char* p = dot + 1;
+                while (last > p && (last[-1] == ' ' || last[-1] == '\r')) --last;
+                if (p == last) {
+                    return false;
+                }
+                for (int digits = 0; p < last; ++p, ++digits) {
+                    unsigned d = static_cast<unsigned char>(*p) - '0';
+                    if (d > 9) {
+                        return false;
+                    }
+                    if (digits < 3) {
+                        millis = millis * 10 + static_cast<int>(d);
+                    }
+                }
+                for (std::ptrdiff_t digits = (last - dot - 1); digits < 3; ++digits) {
+                    millis *= 10;
+                }
+            }
+
+            timestampMs = seconds * 1000 + millis;
+            return true;
+        }
+
+        // Calls onTick(timestampMs, bid, ask) for every accepted row of a mapped CSV
+        template <typename OnTick>
+        void scanTicks(const char* p, const char* end, LoaderMode mode, LoaderStats& stats, OnTick&& onTick) {
+            LocalClock localClock;
+            LocalClock* local = (mode == LoaderMode::Stream) ? &localClock : nullptr;
+            std::int64_t lastTimestamp = std::numeric_limits<std::int64_t>::min();
+            const char* fields[5];
+
+            while (p < end) {
+                const char* lineEnd = static_cast<const char*>(std::memchr(p, '\n', end - p));
+                if (!lineEnd) {
+                    lineEnd = end;
+                }
+
+                // Locate the first three comma-separated fields; extra columns are ignored
+                int fieldCount = 0;
+                fields[fieldCount++] = p;
+                for (const char* c = p; c < lineEnd && fieldCount < 4; ++c) {
+                    if (*c == ',') {
+                        fields[fieldCount++] = c + 1;
+                    }
+                }
+                fields[fieldCount] = lineEnd + 1;
+
+                bool blank = (lineEnd == p) || (lineEnd - p == 1 && *p == '\r');
+                if (!blank) {
+                    std::int64_t timestamp;
+                    double bid, ask;
+                    bool valid = fieldCount >= 3 &&
+                        parseTickTimestamp(fields[0], fields[1] - 1, local, timestamp) &&
+                        parseDouble(fields[1], fields[2] - 1, bid) &&
+                        parseDouble(fields[2], fields[3] - 1, ask);
+
+                    // Out-of-order ticks would need the whole stream in memory to sort
+                    if (valid && timestamp >= lastTimestamp) {
+                        lastTimestamp = timestamp;
+                        onTick(timestamp, bid, ask);
+                    } else {
+                        stats.rejectedRows++;
+                    }
+                }
+
+                p = lineEnd + 1;
+            }
+        }
+    }
+
+    std::string TickData::binaryPathFor(const std::string& csvFilename) {
+        return csvFilename + ".ttk";
+    }
+
+    std::size_t TickData::columnOffset(std::size_t column, std::uint64_t rowCount) {
+        std::size_t columnBytes = alignUp(static_cast<std::size_t>(rowCount) * sizeof(double), COLUMN_ALIGNMENT);
+        return alignUp(sizeof(TickFileHeader), COLUMN_ALIGNMENT) + column * columnBytes;
+    }
+
+    std::size_t TickData::fileSize(std::uint64_t rowCount) {
+        return columnOffset(COLUMN_COUNT, rowCount);
+    }
+
+    bool TickData::convert(const std::string& csvFilename, LoaderMode mode, LoaderStats& stats,
+                           std::size_t chunkRows) {
+        auto startTime = std::chrono::steady_clock::now();
+        stats = LoaderStats();
+        chunkRows = std::max<std::size_t>(chunkRows, 1);
+
+        TickFileHeader header{};
+        std::memcpy(header.magic, TICK_MAGIC, sizeof(TICK_MAGIC));
+        header.version = VERSION;
+        header.headerSize = sizeof(TickFileHeader);
+        header.timestampMode = static_cast<std::uint32_t>(mode);
+        if (!sourceSignature(csvFilename, header.sourceSize, header.sourceMtime)) {
+            return false;
+        }
+
+        MappedFile csv;
+        if (!csv.open(csvFilename) || csv.size() == 0) {
+            return false;
+        }
+        const char* end = csv.data() + csv.size();
+        const char* headerEnd = static_cast<const char*>(std::memchr(csv.data(), '\n', csv.size()));
+        if (!headerEnd) {
+            return false;
+        }
+        const char* body = headerEnd + 1;
+
+        // Pass 1: row count and time span, so every column's offset is known
+        LoaderStats countStats;
+        std::uint64_t rows = 0;
+        scanTicks(body, end, mode, countStats, [&](std::int64_t timestamp, double, double) {
+            if (rows == 0) {
+                header.minTimestamp = timestamp;
+            }
+            header.maxTimestamp = timestamp;
+            ++rows;
+        });
+        if (rows == 0) {
+            return false;
+        }
+        header.rowCount = rows;
+
+        // Pass 2: fill fixed-size column buffers and write each one in place
+        std::string binaryPath = binaryPathFor(csvFilename);
+        std::string tempPath = Utils::uniqueTempPath(binaryPath);
+        {
+            std::ofstream create(tempPath, std::ios::binary | std::ios::trunc);
+            if (!create.is_open()) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::resize_file(tempPath, fileSize(rows), ec);
+        std::fstream out(tempPath, std::ios::binary | std::ios::in | std::ios::out);
+        if (ec || !out.is_open()) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+        std::vector<std::int64_t> timestamps;
+        std::vector<double> bids;
+        std::vector<double> asks;
+        timestamps.reserve(chunkRows);
+        bids.reserve(chunkRows);
+        asks.reserve(chunkRows);
+
+        std::uint64_t columnChecksums[COLUMN_COUNT];
+        std::fill(columnChecksums, columnChecksums + COLUMN_COUNT, 14695981039346656037ULL);
+        std::uint64_t written = 0;
+
+        auto flush = [&]() {
+            const void* columns[COLUMN_COUNT] = {timestamps.data(), bids.data(), asks.data()};
+            std::size_t bytes = timestamps.size() * sizeof(double);
+            for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+                // Whole 8-byte words, so chunked checksums equal whole-column ones
+                columnChecksums[column] = CandleCache::checksum(columns[column], bytes, columnChecksums[column]);
+                out.seekp(static_cast<std::streamoff>(columnOffset(column, rows) + written * sizeof(double)));
+                out.write(static_cast<const char*>(columns[column]), static_cast<std::streamsize>(bytes));
+            }
+            written += timestamps.size();
+            timestamps.clear();
+            bids.clear();
+            asks.clear();
+        };
+
+        scanTicks(body, end, mode, stats, [&](std::int64_t timestamp, double bid, double ask) {
+            timestamps.push_back(timestamp);
+            bids.push_back(bid);
+            asks.push_back(ask);
+            if (timestamps.size() == chunkRows) {
+                flush();
+            }
+        });
+        if (!timestamps.empty()) {
+            flush();
+        }
+
+        header.checksum = CandleCache::checksum(columnChecksums, sizeof(columnChecksums));
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        if (!out || written != rows) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+        std::filesystem::rename(tempPath, binaryPath, ec);
+        if (ec) {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+        stats.rows = static_cast<std::size_t>(rows);
+        stats.bytes = csv.size();
+        stats.sortSkipped = true;
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        if (stats.seconds > 0.0) {
+            stats.rowsPerSecond = static_cast<double>(stats.rows) / stats.seconds;
+            stats.bytesPerSecond = static_cast<double>(stats.bytes) / stats.seconds;
+        }
+        return true;
+    }
+
+    bool TickData::open(const std::string& csvFilename, LoaderMode mode) {
+        auto startTime = std::chrono::steady_clock::now();
+        if (map(csvFilename, mode)) {
+            m_stats = LoaderStats();
+            m_stats.rows = m_rows;
+            m_stats.bytes = m_file.size();
+            m_stats.sortSkipped = true;
+            m_stats.fromCache = true;
+            m_stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+            if (m_stats.seconds > 0.0) {
+                m_stats.rowsPerSecond = static_cast<double>(m_stats.rows) / m_stats.seconds;
+                m_stats.bytesPerSecond = static_cast<double>(m_stats.bytes) / m_stats.seconds;
+            }
+            return true;
+        }
+
+        LoaderStats stats;
+        if (!convert(csvFilename, mode, stats) || !map(csvFilename, mode)) {
+            return false;
+        }
+        m_stats = stats;
+        return true;
+    }
+
+    bool TickData::map(const std::string& csvFilename, LoaderMode mode) {
+        m_file.close();
+        m_rows = 0;
+        m_timestamp = nullptr;
+        m_bid = nullptr;
+        m_ask = nullptr;
+
+        std::uint64_t sourceSize = 0;
+        std::int64_t sourceMtime = 0;
+        if (!sourceSignature(csvFilename, sourceSize, sourceMtime)) {
+            return false;
+        }
+
+        MappedFile file;
+        if (!file.open(binaryPathFor(csvFilename)) || file.size() < sizeof(TickFileHeader)) {
+            return false;
+        }
+
+        TickFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        // Stale or foreign files are simply converted again
+        if (std::memcmp(header.magic, TICK_MAGIC, sizeof(TICK_MAGIC)) != 0 ||
+            header.version != VERSION ||
+            header.headerSize != sizeof(TickFileHeader) ||
+            header.sourceSize != sourceSize ||
+            header.sourceMtime != sourceMtime ||
+            header.timestampMode != static_cast<std::uint32_t>(mode) ||
+            header.rowCount == 0 ||
+            file.size() != fileSize(header.rowCount)) {
+            return false;
+        }
+
+        std::size_t rows = static_cast<std::size_t>(header.rowCount);
+        std::uint64_t columnChecksums[COLUMN_COUNT];
+        for (std::size_t column = 0; column < COLUMN_COUNT; ++column) {
+            columnChecksums[column] = CandleCache::checksum(file.data() + columnOffset(column, rows),
+                                                            rows * sizeof(double));
+        }
+        if (CandleCache::checksum(columnChecksums, sizeof(columnChecksums)) != header.checksum) {
+            return false;
+        }
+
+        // Columns are used in place; the mapping is page-aligned and every
+        // column offset is a multiple of 64
+        m_timestamp = reinterpret_cast<const std::int64_t*>(file.data() + columnOffset(0, rows));
+        m_bid = reinterpret_cast<const double*>(file.data() + columnOffset(1, rows));
+        m_ask = reinterpret_cast<const double*>(file.data() + columnOffset(2, rows));
+        m_rows = rows;
+        m_file = std::move(file);
+        return true;
+    }
+
+    std::size_t TickData::lowerBound(std::int64_t timestampMs) const {
+        return static_cast<std::size_t>(std::lower_bound(m_timestamp, m_timestamp + m_rows, timestampMs) - m_timestamp);
+    }
+
+    TickTouch TickData::firstTouch(std::int64_t fromMs, std::int64_t toMs, bool isLong,
+                                   double stopLoss, double takeProfit) const {
+        const double* price = isLong ? m_bid : m_ask;
+        for (std::size_t i = lowerBound(fromMs); i < m_rows && m_timestamp[i] < toMs; ++i) {
+            // SL is checked first, as on bars, in case one tick crosses both
+            bool stopHit = isLong ? price[i] <= stopLoss : price[i] >= stopLoss;
+            if (stopHit) {
+                return TickTouch::StopLoss;
+            }
+            bool targetHit = isLong ? price[i] >= takeProfit : price[i] <= takeProfit;
+            if (targetHit) {
+                return TickTouch::TakeProfit;
+            }
+        }
+        return TickTouch::None;
+    }
+}
@@ -0,0 +1,98 @@
+#ifndef BACKTEST_TICK_DATA_H
+#define BACKTEST_TICK_DATA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Backtester.h"
+#include "MappedFile.h"
+
+namespace Backtest {
+    // Binary columnar copy of a tick CSV, stored next to the source file and
+    // used through a read-only mapping. Layout (native endianness):
+    //   TickFileHeader
+    //   int64  timestamp[rowCount]   (milliseconds since the Unix epoch)
+    //   double bid[rowCount], ask[rowCount]
+    // Each column starts on a 64-byte boundary, as in the candle cache. The
+    // file is only used while the CSV's size and modification time match and
+    // it was written in the requested time base.
+    struct TickFileHeader {
+        char magic[8];              // "TCTICKS\0"
+        std::uint32_t version;
+        std::uint32_t headerSize;
+        std::uint64_t rowCount;
+        std::int64_t minTimestamp;
+        std::int64_t maxTimestamp;
+        std::uint64_t sourceSize;   // CSV size in bytes
+        std::int64_t sourceMtime;   // CSV last_write_time, in file clock ticks
+        std::uint32_t timestampMode; // LoaderMode whose time base the ticks use
+        std::uint32_t reserved;
+        std::uint64_t checksum;     // CandleCache::checksum of the three per-column checksums
+    };
+
+    // Which exit level a tick stream reached first
+    enum class TickTouch {
+        None,
+        StopLoss,
+        TakeProfit
+    };
+
+    // Tick/quote stream ("timestamp,bid,ask" with a header line). Timestamps
+    // are "YYYY-MM-DD HH:MM:SS" with optional fractional seconds, read in the
+    // time base of a candle LoaderMode: local time like the stream loader, or
+    // UTC like the memory-mapped one. Ticks must be in time order;
+    // rows that go back in time are rejected rather than sorted, so neither
+    // the conversion nor the lookups ever hold the whole stream in memory.
+    class TickData {
+    public:
+        static constexpr std::uint32_t VERSION = 2;
+        static constexpr std::size_t COLUMN_ALIGNMENT = 64;
+        static constexpr std::size_t DEFAULT_CHUNK_ROWS = 65536;
+
+        // Binary file used for a given tick CSV ("<csv>.ttk")
+        static std::string binaryPathFor(const std::string& csvFilename);
+
+        // Stream the CSV into its binary file in two passes over a mapping
+        // (count, then parse and write chunkRows rows of each column at a
+        // time). Written under a temporary name and renamed into place.
+        static bool convert(const std::string& csvFilename, LoaderMode mode, LoaderStats& stats,
+                            std::size_t chunkRows = DEFAULT_CHUNK_ROWS);
+
+        // Map the binary file for csvFilename, converting the CSV first when
+        // the file is missing, stale or in another time base
+        bool open(const std::string& csvFilename, LoaderMode mode);
+
+        const LoaderStats& getLoaderStats() const { return m_stats; }
+
+        std::size_t size() const { return m_rows; }
+        bool empty() const { return m_rows == 0; }
+
+        const std::int64_t* timestamp() const { return m_timestamp; }
+        const double* bid() const { return m_bid; }
+        const double* ask() const { return m_ask; }
+
+        // Index of the first tick at or after a timestamp (ms); size() if none
+        std::size_t lowerBound(std::int64_t timestampMs) const;
+
+        // Replay the ticks in [fromMs, toMs) and report which level was reached
+        // first. Longs exit on the bid, shorts on the ask.
+        TickTouch firstTouch(std::int64_t fromMs, std::int64_t toMs, bool isLong,
+                             double stopLoss, double takeProfit) const;
+
+        // Byte offset of each column for a given row count
+        static std::size_t columnOffset(std::size_t column, std::uint64_t rowCount);
+        static std::size_t fileSize(std::uint64_t rowCount);
+
+    private:
+        bool map(const std::string& csvFilename, LoaderMode mode);
+
+        MappedFile m_file;
+        std::size_t m_rows = 0;
+        const std::int64_t* m_timestamp = nullptr;
+        const double* m_bid = nullptr;
+        const double* m_ask = nullptr;
+        LoaderStats m_stats;
+    };
+}
+
+#endif // BACKTEST_TICK_DATA_H
@@ -0,0 +1,97 @@
+#include "WalkForward.h"
+#include "../Utils/WorkStealingPool.h"
+#include <algorithm>
+
+namespace Backtest {
+    bool WalkForward::loadPriceData(const std::string& filename) {
+        return m_sweep.loadPriceData(filename);
+    }
+
+    void WalkForward::setPriceData(std::shared_ptr<const CandleSeries> series) {
+        m_sweep.setPriceData(std::move(series));
+    }
+
+    std::vector<std::pair<BarRange, BarRange>> WalkForward::makeWindows(std::size_t bars,
+                                                                        const WalkForwardSpec& spec) {
+        std::vector<std::pair<BarRange, BarRange>> windows;
+        if (spec.inSampleBars == 0 || spec.outOfSampleBars == 0) {
+            return windows;
+        }
+
+        for (std::size_t testBegin = spec.inSampleBars; testBegin < bars; testBegin += spec.outOfSampleBars) {
+            BarRange inSample;
+            inSample.begin = (spec.mode == WalkForwardMode::Anchored) ? 0 : testBegin - spec.inSampleBars;
+            inSample.end = testBegin;
+
+            BarRange outOfSample;
+            outOfSample.begin = testBegin;
+            outOfSample.end = std::min(testBegin + spec.outOfSampleBars, bars);
+
+            windows.emplace_back(inSample, outOfSample);
+        }
+        return windows;
+    }
+
+    WalkForwardResult WalkForward::run(const WalkForwardSpec& spec) const {
+        WalkForwardResult result;
+        const Backtester& data = m_sweep.getDataSource();
+        if (!data.hasPriceData()) {
+            return result;
+        }
+
+        auto ranges = makeWindows(data.getPriceData()->size(), spec);
+        result.windows.resize(ranges.size());
+
+        Utils::WorkStealingPool pool(spec.sweep.threadCount);
+        pool.parallelFor(ranges.size(), [&](std::size_t w) {
+            WalkForwardWindow& window = result.windows[w];
+            window.inSample = ranges[w].first;
+            window.outOfSample = ranges[w].second;
+
+            // Optimize in sample; the sweep's evaluations join the same pool
+            std::vector<SweepResult> ranked = m_sweep.run(spec.sweep, spec.ranking, window.inSample, pool);
+            if (ranked.empty()) {
+                return;
+            }
+            window.inSampleBest = ranked.front();
+
+            // Apply the winner to the following slice, keeping its equity curve
+            Backtester backtester;
+            backtester.sharePriceData(data);
+            backtester.setRange(window.outOfSample);
+            backtester.setConfig(window.inSampleBest.config);
+            BacktestResult tested = backtester.runBacktest();
+
+            window.outOfSampleResult = ParameterSweep::summarize(window.inSampleBest.config, tested);
+            window.outOfSampleResult.index = window.inSampleBest.index;
+            window.equityCurve = std::move(tested.equityCurve);
+        }, 1);
+
+        // Stitch in window order
+        double balance = spec.sweep.base.initialBalance;
+        double peak = balance;
+        result.equityCurve.push_back(balance);
+        for (const WalkForwardWindow& window : result.windows) {
+            result.totalTrades += window.outOfSampleResult.totalTrades;
+            if (window.equityCurve.empty() || window.equityCurve.front() <= 0.0) {
+                continue;
+            }
+
+            double scale = balance / window.equityCurve.front();
+            for (std::size_t i = 1; i < window.equityCurve.size(); ++i) {
+                double value = window.equityCurve[i] * scale;
+                result.equityCurve.push_back(value);
+                peak = std::max(peak, value);
+                if (peak > 0.0) {
+                    result.maxDrawdownPercent = std::max(result.maxDrawdownPercent, (peak - value) / peak * 100.0);
+                }
+            }
+            balance = result.equityCurve.back();
+        }
+
+        result.finalBalance = balance;
+        double initial = spec.sweep.base.initialBalance;
+        result.percentGain = (initial > 0.0) ? (balance - initial) / initial * 100.0 : 0.0;
+        return result;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef BACKTEST_WALK_FORWARD_H
+#define BACKTEST_WALK_FORWARD_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ParameterSweep.h"
+
+namespace Backtest {
+    enum class WalkForwardMode {
+        Rolling,  // In-sample slice of fixed length moves with the windows
+        Anchored  // In-sample slice always starts at the first bar and grows
+    };
+
+    struct WalkForwardSpec {
+        SweepSpec sweep;  // Parameter sets tried on every in-sample slice
+        SweepRanking ranking = SweepRanking::NetProfit;  // Picks each slice's winner
+        WalkForwardMode mode = WalkForwardMode::Rolling;
+        std::size_t inSampleBars = 0;
+        std::size_t outOfSampleBars = 0;  // Also the step between windows
+    };
+
+    // One optimize-then-test step
+    struct WalkForwardWindow {
+        BarRange inSample;
+        BarRange outOfSample;
+        SweepResult inSampleBest;       // Winner of the in-sample sweep
+        SweepResult outOfSampleResult;  // The same config on the following slice
+        std::vector<double> equityCurve;  // Out-of-sample equity from the base initial balance
+    };
+
+    struct WalkForwardResult {
+        std::vector<WalkForwardWindow> windows;
+
+        // Out-of-sample curves chained by their returns: each window's curve is
+        // rescaled to start at the previous window's final balance
+        std::vector<double> equityCurve;
+        double finalBalance = 0.0;
+        double percentGain = 0.0;
+        double maxDrawdownPercent = 0.0;
+        int totalTrades = 0;
+    };
+
+    // Walk-forward analysis: optimize on each in-sample slice, apply the
+    // winner to the next out-of-sample slice, and stitch the out-of-sample
+    // results together. Out-of-sample slices tile the series without gaps.
+    //
+    // All windows are slices (BarRange) of one shared series, with its signal
+    // mask and exit tables, so nothing is copied per window. Windows run
+    // concurrently, and each window's sweep spreads over the same pool.
+    // Trades still open at the end of a slice are left out of that slice.
+    class WalkForward {
+    public:
+        WalkForward() = default;
+
+        bool loadPriceData(const std::string& filename);
+        void setPriceData(std::shared_ptr<const CandleSeries> series);
+
+        ParameterSweep& getSweep() { return m_sweep; }
+
+        // In-sample/out-of-sample ranges for a series of `bars` bars. The last
+        // out-of-sample slice may be shorter than outOfSampleBars.
+        static std::vector<std::pair<BarRange, BarRange>> makeWindows(std::size_t bars,
+                                                                      const WalkForwardSpec& spec);
+
+        // Uses spec.sweep.threadCount workers for the whole run
+        WalkForwardResult run(const WalkForwardSpec& spec) const;
+
+    private:
+        ParameterSweep m_sweep;
+    };
+}
+
+#endif // BACKTEST_WALK_FORWARD_H
@@ -0,0 +1,283 @@
+#include "PathKernel.h"
+#include "../Utils/CpuFeatures.h"
+#include "../Utils/Philox.h"
+#include <algorithm>
+
+namespace Risk {
+    namespace {
+        // Values derived from the parameters, shared by both kernels
+        struct StepConstants {
+            double riskFraction;
+            double riskRewardRatio;
+            double ruinBalance;
+            std::uint32_t winThreshold;  // Win when the random word is below this...
+            bool alwaysWin;              // ...or always, when winRate >= 1
+        };
+
+        StepConstants makeConstants(const PathKernelParams& params) {
+            StepConstants constants;
+            constants.riskFraction = params.riskPercent / 100.0;
+            constants.riskRewardRatio = params.riskRewardRatio;
+            constants.ruinBalance = params.ruinBalance;
+
+            double scaled = params.winRate * 4294967296.0;
+            constants.alwaysWin = scaled >= 4294967296.0;
+            constants.winThreshold = (scaled > 0.0 && !constants.alwaysWin)
+                ? static_cast<std::uint32_t>(scaled) : 0;
+            return constants;
+        }
+
+        void simulatePath(const PathKernelParams& params, const StepConstants& constants,
+                          std::size_t path, const PathKernelOutput& output) {
+            Utils::PhiloxStream random(params.seed, path);
+
+            double balance = params.initialBalance;
+            double peak = balance;
+            double maxDrawdown = 0.0;
+            double maxDrawdownPercent = 0.0;
+            int streak = 0;
+            int maxStreak = 0;
+            bool ruined = balance <= constants.ruinBalance;
+            if (output.balances) {
+                output.balances[path] = balance;
+            }
+
+            for (int trade = 0; trade < params.numTrades; ++trade) {
+                std::uint32_t word = random.nextUInt32();
+                bool isWin = constants.alwaysWin || word < constants.winThreshold;
+
+                // Same arithmetic as RiskCurveGenerator::simulateTrade
+                double riskAmount = balance * constants.riskFraction;
+                double next = isWin ? balance + riskAmount * constants.riskRewardRatio
+                                    : balance - riskAmount;
+
+                streak = (next < balance) ? streak + 1 : 0;
+                maxStreak = std::max(maxStreak, streak);
+                balance = next;
+
+                if (balance > peak) {
+                    peak = balance;
+                }
+                double drawdown = peak - balance;
+                if (drawdown > maxDrawdown) {
+                    maxDrawdown = drawdown;
+                    maxDrawdownPercent = (peak > 0) ? (drawdown / peak * 100.0) : 0.0;
+                }
+                ruined = ruined || balance <= constants.ruinBalance;
+
+                if (output.balances) {
+                    output.balances[static_cast<std::size_t>(trade + 1) * output.balanceStride + path] = balance;
+                }
+            }
+
+            if (output.finalBalance) output.finalBalance[path] = balance;
+            if (output.maxDrawdown) output.maxDrawdown[path] = maxDrawdown;
+            if (output.maxDrawdownPercent) output.maxDrawdownPercent[path] = maxDrawdownPercent;
+            if (output.maxConsecutiveLosses) output.maxConsecutiveLosses[path] = maxStreak;
+            if (output.ruined) output.ruined[path] = ruined ? 1 : 0;
+        }
+    }
+
+    bool PathKernel::usesAvx2() {
+        return UTILS_HAS_X86_SIMD && Utils::cpuSupportsAvx2();
+    }
+
+    void PathKernel::run(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                         const PathKernelOutput& output) {
+        if (usesAvx2()) {
+            runAvx2(params, firstPath, count, output);
+        } else {
+            runScalar(params, firstPath, count, output);
+        }
+    }
+
+    void PathKernel::runScalar(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                               const PathKernelOutput& output) {
+        StepConstants constants = makeConstants(params);
+        for (std::size_t path = firstPath; path < firstPath + count; ++path) {
+            simulatePath(params, constants, path, output);
+        }
+    }
+
+#if UTILS_HAS_X86_SIMD
+    namespace {
+        // 32x32 -> 64-bit products of 8 lanes, split into high and low words
+        UTILS_TARGET_AVX2
+        inline void mulHiLo(__m256i a, __m256i multiplier, __m256i& hi, __m256i& lo) {
+            __m256i even = _mm256_mul_epu32(a, multiplier);
+            __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), multiplier);
+            lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+            hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+        }
+
+        // Philox4x32-10 for 8 streams at once; matches Utils::Philox4x32::generate
+        UTILS_TARGET_AVX2
+        inline void philox8(__m256i counter[4], std::uint32_t key0, std::uint32_t key1) {
+            const __m256i m0 = _mm256_set1_epi32(static_cast<int>(0xD2511F53u));
+            const __m256i m1 = _mm256_set1_epi32(static_cast<int>(0xCD9E8D57u));
+            for (int round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    key0 += 0x9E3779B9u;
+                    key1 += 0xBB67AE85u;
+                }
+                __m256i hi0, lo0, hi1, lo1;
+                mulHiLo(counter[0], m0, hi0, lo0);
+                mulHiLo(counter[2], m1, hi1, lo1);
+                __m256i next0 = _mm256_xor_si256(_mm256_xor_si256(hi1, counter[1]),
+                                                 _mm256_set1_epi32(static_cast<int>(key0)));
+                __m256i next2 = _mm256_xor_si256(_mm256_xor_si256(hi0, counter[3]),
+                                                 _mm256_set1_epi32(static_cast<int>(key1)));
+                counter[0] = next0;
+                counter[1] = lo1;
+                counter[2] = next2;
+                counter[3] = lo0;
+            }
+        }
+
+        // State of 4 paths in one set of double lanes
+        struct LaneState {
+            __m256d balance;
+            __m256d peak;
+            __m256d maxDrawdown;
+            __m256d maxDrawdownPercent;
+            __m256d streak;
+            __m256d maxStreak;
+            __m256d ruined;  // All-ones lanes once ruined
+        };
+
+        UTILS_TARGET_AVX2
+        inline LaneState initLanes(double initialBalance, double ruinBalance) {
+            LaneState state;
+            state.balance = _mm256_set1_pd(initialBalance);
+            state.peak = state.balance;
+            state.maxDrawdown = _mm256_setzero_pd();
+            state.maxDrawdownPercent = _mm256_setzero_pd();
+            state.streak = _mm256_setzero_pd();
+            state.maxStreak = _mm256_setzero_pd();
+            state.ruined = _mm256_cmp_pd(state.balance, _mm256_set1_pd(ruinBalance), _CMP_LE_OQ);
+            return state;
+        }
+
+        // One trade for 4 paths; winMask lanes are all ones for a win. Same
+        // operations, in the same order, as simulatePath (no FMA).
+        UTILS_TARGET_AVX2
+        inline void stepLanes(LaneState& state, __m256d winMask, const StepConstants& constants) {
+            const __m256d riskFraction = _mm256_set1_pd(constants.riskFraction);
+            const __m256d riskReward = _mm256_set1_pd(constants.riskRewardRatio);
+            const __m256d zero = _mm256_setzero_pd();
+
+            __m256d riskAmount = _mm256_mul_pd(state.balance, riskFraction);
+            __m256d win = _mm256_add_pd(state.balance, _mm256_mul_pd(riskAmount, riskReward));
+            __m256d loss = _mm256_sub_pd(state.balance, riskAmount);
+            __m256d next = _mm256_blendv_pd(loss, win, winMask);
+
+            __m256d lossStep = _mm256_cmp_pd(next, state.balance, _CMP_LT_OQ);
+            state.streak = _mm256_and_pd(lossStep, _mm256_add_pd(state.streak, _mm256_set1_pd(1.0)));
+            state.maxStreak = _mm256_max_pd(state.maxStreak, state.streak);
+            state.balance = next;
+
+            __m256d higher = _mm256_cmp_pd(state.balance, state.peak, _CMP_GT_OQ);
+            state.peak = _mm256_blendv_pd(state.peak, state.balance, higher);
+            __m256d drawdown = _mm256_sub_pd(state.peak, state.balance);
+            __m256d deeper = _mm256_cmp_pd(drawdown, state.maxDrawdown, _CMP_GT_OQ);
+            __m256d percent = _mm256_mul_pd(_mm256_div_pd(drawdown, state.peak), _mm256_set1_pd(100.0));
+            percent = _mm256_and_pd(_mm256_cmp_pd(state.peak, zero, _CMP_GT_OQ), percent);
+            state.maxDrawdown = _mm256_blendv_pd(state.maxDrawdown, drawdown, deeper);
+            state.maxDrawdownPercent = _mm256_blendv_pd(state.maxDrawdownPercent, percent, deeper);
+
+            state.ruined = _mm256_or_pd(state.ruined, _mm256_cmp_pd(state.balance,
+                                                                     _mm256_set1_pd(constants.ruinBalance),
+                                                                     _CMP_LE_OQ));
+        }
+
+        UTILS_TARGET_AVX2
+        inline void storeLanes(const LaneState& state, std::size_t path, const PathKernelOutput& output) {
+            if (output.finalBalance) _mm256_storeu_pd(output.finalBalance + path, state.balance);
+            if (output.maxDrawdown) _mm256_storeu_pd(output.maxDrawdown + path, state.maxDrawdown);
+            if (output.maxDrawdownPercent) _mm256_storeu_pd(output.maxDrawdownPercent + path, state.maxDrawdownPercent);
+            if (output.maxConsecutiveLosses) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(output.maxConsecutiveLosses + path),
+                                 _mm256_cvttpd_epi32(state.maxStreak));
+            }
+            if (output.ruined) {
+                int bits = _mm256_movemask_pd(state.ruined);
+                for (int lane = 0; lane < 4; ++lane) {
+                    output.ruined[path + lane] = static_cast<std::uint8_t>((bits >> lane) & 1);
+                }
+            }
+        }
+    }
+
+    UTILS_TARGET_AVX2
+    void PathKernel::runAvx2(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                             const PathKernelOutput& output) {
+        StepConstants constants = makeConstants(params);
+        const std::uint32_t key0 = static_cast<std::uint32_t>(params.seed);
+        const std::uint32_t key1 = static_cast<std::uint32_t>(params.seed >> 32);
+
+        // Unsigned word < threshold, as a signed compare with both sides offset
+        const __m256i signBit = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+        const __m256i threshold = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(constants.winThreshold)), signBit);
+        const __m256i alwaysWin = _mm256_set1_epi32(constants.alwaysWin ? -1 : 0);
+        const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        std::size_t path = firstPath;
+        std::size_t end = firstPath + count;
+        for (; path + 8 <= end; path += 8) {
+            LaneState low = initLanes(params.initialBalance, constants.ruinBalance);
+            LaneState high = low;
+            if (output.balances) {
+                _mm256_storeu_pd(output.balances + path, low.balance);
+                _mm256_storeu_pd(output.balances + path + 4, high.balance);
+            }
+
+            // Stream number (path) of each lane in counter words 2 and 3. A lane
+            // whose low word wrapped around carries into the high word.
+            std::uint64_t stream = static_cast<std::uint64_t>(path);
+            __m256i baseLow = _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(stream)));
+            __m256i streamLow = _mm256_add_epi32(baseLow, laneOffsets);
+            __m256i wrapped = _mm256_cmpgt_epi32(_mm256_xor_si256(baseLow, signBit),
+                                                 _mm256_xor_si256(streamLow, signBit));
+            __m256i streamHigh = _mm256_sub_epi32(
+                _mm256_set1_epi32(static_cast<int>(static_cast<std::uint32_t>(stream >> 32))), wrapped);
+
+            for (int block = 0; block * 4 < params.numTrades; ++block) {
+                __m256i words[4] = {
+                    _mm256_set1_epi32(block), _mm256_setzero_si256(), streamLow, streamHigh};
+                philox8(words, key0, key1);
+
+                int tradesInBlock = std::min(4, params.numTrades - block * 4);
+                for (int k = 0; k < tradesInBlock; ++k) {
+                    __m256i win = _mm256_cmpgt_epi32(threshold, _mm256_xor_si256(words[k], signBit));
+                    win = _mm256_or_si256(win, alwaysWin);
+
+                    // Widen the 32-bit masks to 64-bit lanes for each half
+                    __m256d winLow = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(win)));
+                    __m256d winHigh = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(win, 1)));
+                    stepLanes(low, winLow, constants);
+                    stepLanes(high, winHigh, constants);
+
+                    if (output.balances) {
+                        double* row = output.balances + static_cast<std::size_t>(block * 4 + k + 1) * output.balanceStride;
+                        _mm256_storeu_pd(row + path, low.balance);
+                        _mm256_storeu_pd(row + path + 4, high.balance);
+                    }
+                }
+            }
+
+            storeLanes(low, path, output);
+            storeLanes(high, path + 4, output);
+        }
+
+        // Remaining paths one at a time
+        for (; path < end; ++path) {
+            simulatePath(params, constants, path, output);
+        }
+    }
+#else
+    void PathKernel::runAvx2(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                             const PathKernelOutput& output) {
+        runScalar(params, firstPath, count, output);
+    }
+#endif
+}
@@ -0,0 +1,56 @@
+#ifndef RISK_PATH_KERNEL_H
+#define RISK_PATH_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Risk {
+    // Everything a path needs, resolved once per run
+    struct PathKernelParams {
+        double initialBalance = 10000.0;
+        double riskPercent = 1.0;        // Per trade; sizing strategy already applied
+        double riskRewardRatio = 2.0;
+        double winRate = 0.5;
+        double ruinBalance = 0.0;        // Ruined once the balance is at or below this
+        int numTrades = 100;
+        std::uint64_t seed = 0;
+    };
+
+    // Per-path results, indexed by absolute path number. balances is optional;
+    // when set, the balance of path p after trade t (t = 0 is the initial
+    // balance) is written to balances[t * balanceStride + p].
+    struct PathKernelOutput {
+        double* finalBalance = nullptr;
+        double* maxDrawdown = nullptr;
+        double* maxDrawdownPercent = nullptr;
+        int* maxConsecutiveLosses = nullptr;
+        std::uint8_t* ruined = nullptr;
+        double* balances = nullptr;
+        std::size_t balanceStride = 0;
+    };
+
+    // Advances many simulated accounts in lockstep. Path p draws from Philox
+    // stream p of the seed: trade t wins when 32-bit word t of the stream is
+    // below winRate * 2^32. Drawdown (as in RiskCurveGenerator::calculateDrawdown),
+    // loss streaks and ruin are tracked in the same loop.
+    //
+    // The AVX2 kernel runs 8 paths per iteration as two 4-lane double vectors,
+    // with Philox evaluated for all 8 streams at once. It avoids FMA, so its
+    // results are bit-identical to the scalar kernel.
+    class PathKernel {
+    public:
+        // Simulate paths [firstPath, firstPath + count)
+        static void run(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                        const PathKernelOutput& output);
+
+        // Individual kernels, exposed for testing and benchmarking
+        static void runScalar(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                              const PathKernelOutput& output);
+        static void runAvx2(const PathKernelParams& params, std::size_t firstPath, std::size_t count,
+                            const PathKernelOutput& output);
+
+        static bool usesAvx2();
+    };
+}
+
+#endif // RISK_PATH_KERNEL_H
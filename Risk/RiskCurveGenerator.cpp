@@ -1,5 +1,7 @@
 #include "RiskCurveGenerator.h"
+#include "PathKernel.h"
 #include "../Utils.h"
+#include "../Utils/WorkStealingPool.h"
 #include <random>
 #include <fstream>
 #include <cmath>
@@ -42,24 +44,15 @@ namespace Risk {
         int consecutiveLosses = 0;
         int maxConsecutiveLosses = 0;
         
+        // Sizing depends only on the profile and parameters, so resolve it once
+        const double riskPercent = riskPercentFor(currentBalance);
+        
+        returns.reserve(static_cast<std::size_t>(std::max(m_params.numTrades, 0)));
+        tradeResults.reserve(returns.capacity());
+        m_results.balanceCurve.reserve(returns.capacity() + 1);
+        
         // Run simulation
         for (int i = 0; i < m_params.numTrades; ++i) {
-            double riskPercent;
-            
-            // Calculate risk based on strategy and profile
-            if (m_riskProfile->getStrategy() == RiskStrategy::KELLY_CRITERION) {
-                riskPercent = m_riskProfile->calculateRiskAmount(
-                    currentBalance, m_params.winRate, m_params.riskRewardRatio);
-            } else if (m_riskProfile->getStrategy() == RiskStrategy::COMPOUNDING) {
-                riskPercent = m_riskProfile->getDefaultRisk();
-            } else {
-                // Fixed risk
-                riskPercent = m_riskProfile->getDefaultRisk();
-            }
-            
-            // Cap at max risk
-            riskPercent = std::min(riskPercent, m_params.maxRiskPerTrade);
-            
             // Simulate trade
             bool isWin = winDistribution(gen);
             double previousBalance = currentBalance;
@@ -98,7 +91,130 @@ namespace Risk {
         return m_results;
     }
     
-    double RiskCurveGenerator::simulateTrade(double balance, double riskPercent, bool isWin) {
+    MonteCarloResult RiskCurveGenerator::runMonteCarlo(const MonteCarloParams& mcParams) const {
+        MonteCarloResult result;
+        if (mcParams.numPaths <= 0) {
+            return result;
+        }
+        
+        std::size_t paths = static_cast<std::size_t>(mcParams.numPaths);
+        std::size_t steps = static_cast<std::size_t>(std::max(m_params.numTrades, 0)) + 1;
+        double ruinBalance = m_params.initialBalance * (mcParams.ruinLevelPercent / 100.0);
+        
+        // Step-major, so each step's percentiles are taken over one contiguous column
+        std::vector<double> balances(steps * paths);
+        std::vector<double> drawdowns(paths);
+        std::vector<std::uint8_t> ruined(paths);
+        
+        // Sizing does not change along a path, so it is resolved once for the run
+        PathKernelParams kernelParams;
+        kernelParams.initialBalance = m_params.initialBalance;
+        kernelParams.riskPercent = riskPercentFor(m_params.initialBalance);
+        kernelParams.riskRewardRatio = m_params.riskRewardRatio;
+        kernelParams.winRate = m_params.winRate;
+        kernelParams.ruinBalance = ruinBalance;
+        kernelParams.numTrades = m_params.numTrades;
+        kernelParams.seed = mcParams.seed;
+        
+        PathKernelOutput output;
+        output.maxDrawdownPercent = drawdowns.data();
+        output.ruined = ruined.data();
+        output.balances = balances.data();
+        output.balanceStride = paths;
+        
+        // Chunks are a multiple of the kernel's 8 lanes
+        const std::size_t chunkPaths = 256;
+        std::size_t chunks = (paths + chunkPaths - 1) / chunkPaths;
+        
+        Utils::WorkStealingPool pool(mcParams.threadCount);
+        pool.parallelFor(chunks, [&](std::size_t chunk) {
+            std::size_t first = chunk * chunkPaths;
+            PathKernel::run(kernelParams, first, std::min(chunkPaths, paths - first), output);
+        });
+        
+        // Summaries in path order
+        double finalSum = 0.0;
+        std::size_t ruinCount = 0;
+        const double* finalBalances = balances.data() + (steps - 1) * paths;
+        for (std::size_t path = 0; path < paths; ++path) {
+            finalSum += finalBalances[path];
+            ruinCount += ruined[path];
+        }
+        
+        // Nearest-rank percentiles per step. Selection only reorders within a
+        // column, and each rank is searched above the previous one.
+        const double bandPercentiles[] = {5.0, 25.0, 50.0, 75.0, 95.0};
+        std::vector<double>* bands[] = {&result.balanceP5, &result.balanceP25, &result.balanceP50,
+                                        &result.balanceP75, &result.balanceP95};
+        for (auto* band : bands) {
+            band->resize(steps);
+        }
+        
+        pool.parallelFor(steps, [&](std::size_t step) {
+            double* column = balances.data() + step * paths;
+            std::size_t previousRank = 0;
+            for (std::size_t b = 0; b < 5; ++b) {
+                std::size_t rank = static_cast<std::size_t>(bandPercentiles[b] / 100.0 * static_cast<double>(paths - 1) + 0.5);
+                std::nth_element(column + previousRank, column + rank, column + paths);
+                (*bands[b])[step] = column[rank];
+                previousRank = rank;
+            }
+        });
+        
+        std::sort(drawdowns.begin(), drawdowns.end());
+        
+        result.numPaths = mcParams.numPaths;
+        result.maxDrawdownPercents = std::move(drawdowns);
+        result.ruinProbability = static_cast<double>(ruinCount) / static_cast<double>(paths);
+        result.meanFinalBalance = finalSum / static_cast<double>(paths);
+        return result;
+    }
+    
+    double MonteCarloResult::maxDrawdownPercentile(double percentile) const {
+        if (maxDrawdownPercents.empty()) {
+            return 0.0;
+        }
+        double clamped = std::min(std::max(percentile, 0.0), 100.0);
+        std::size_t rank = static_cast<std::size_t>(clamped / 100.0 * static_cast<double>(maxDrawdownPercents.size() - 1) + 0.5);
+        return maxDrawdownPercents[rank];
+    }
+    
+    bool RiskCurveGenerator::exportMonteCarloToCSV(const MonteCarloResult& result, const std::string& filename) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            return false;
+        }
+        
+        file << "Trade,P5,P25,P50,P75,P95\n";
+        for (size_t i = 0; i < result.balanceP50.size(); ++i) {
+            file << i << "," << result.balanceP5[i] << "," << result.balanceP25[i] << ","
+                 << result.balanceP50[i] << "," << result.balanceP75[i] << ","
+                 << result.balanceP95[i] << "\n";
+        }
+        
+        file.close();
+        return true;
+    }
+    
+    double RiskCurveGenerator::riskPercentFor(double balance) const {
+        double riskPercent;
+        
+        // Calculate risk based on strategy and profile
+        if (m_riskProfile->getStrategy() == RiskStrategy::KELLY_CRITERION) {
+            riskPercent = m_riskProfile->calculateRiskAmount(
+                balance, m_params.winRate, m_params.riskRewardRatio);
+        } else if (m_riskProfile->getStrategy() == RiskStrategy::COMPOUNDING) {
+            riskPercent = m_riskProfile->getDefaultRisk();
+        } else {
+            // Fixed risk
+            riskPercent = m_riskProfile->getDefaultRisk();
+        }
+        
+        // Cap at max risk
+        return std::min(riskPercent, m_params.maxRiskPerTrade);
+    }
+    
+    double RiskCurveGenerator::simulateTrade(double balance, double riskPercent, bool isWin) const {
         double riskAmount = balance * (riskPercent / 100.0);
         
         if (isWin) {
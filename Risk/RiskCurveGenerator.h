@@ -4,6 +4,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdint>
 #include "RiskProfile.h"
 
 namespace Risk {
@@ -27,6 +28,33 @@ namespace Risk {
         double profitFactor = 0.0;
     };
     
+    struct MonteCarloParams {
+        int numPaths = 100000;
+        std::uint64_t seed = 0x5EED;
+        double ruinLevelPercent = 50.0;    // A path is ruined once its balance falls to this % of the initial balance
+        unsigned int threadCount = 0;      // 0 = hardware concurrency
+    };
+    
+    struct MonteCarloResult {
+        int numPaths = 0;
+        
+        // Balance percentiles across paths, one entry per step (initial balance first)
+        std::vector<double> balanceP5;
+        std::vector<double> balanceP25;
+        std::vector<double> balanceP50;
+        std::vector<double> balanceP75;
+        std::vector<double> balanceP95;
+        
+        // Max drawdown (%) of every path, sorted ascending
+        std::vector<double> maxDrawdownPercents;
+        
+        double ruinProbability = 0.0;
+        double meanFinalBalance = 0.0;
+        
+        // Value at the given percentile (0-100) of the drawdown distribution
+        double maxDrawdownPercentile(double percentile) const;
+    };
+    
     class RiskCurveGenerator {
     public:
         RiskCurveGenerator();
@@ -35,12 +63,23 @@ namespace Risk {
         // Set simulation parameters
         void setSimulationParams(const RiskSimulationParams& params);
         
-        // Set custom risk profile
+        // Set custom risk profile. Sizing is resolved once per run, at the
+        // initial balance: a subclass whose calculateRiskAmount depends on the
+        // balance passed in is not re-evaluated as the balance moves.
         void setRiskProfile(std::shared_ptr<RiskProfile> profile);
         
         // Run simulation and get results
         RiskSimulationResult generateCurve();
         
+        // Run numPaths independent paths on all cores with PathKernel. Path i
+        // draws from Philox stream i of the seed. Risk per trade is taken from
+        // the profile once per run.
+        // Holds every path's balance per step: 8 * numPaths * (numTrades + 1) bytes.
+        MonteCarloResult runMonteCarlo(const MonteCarloParams& mcParams) const;
+        
+        // Write the percentile bands of a Monte Carlo run
+        static bool exportMonteCarloToCSV(const MonteCarloResult& result, const std::string& filename);
+        
         // Export to CSV
         bool exportToCSV(const std::string& filename);
         
@@ -53,7 +92,8 @@ namespace Risk {
         std::shared_ptr<RiskProfile> m_riskProfile;
         
         // Helper methods
-        double simulateTrade(double balance, double riskPercent, bool isWin);
+        double riskPercentFor(double balance) const;
+        double simulateTrade(double balance, double riskPercent, bool isWin) const;
         void calculateDrawdown(RiskSimulationResult& result);
         void calculateSharpeRatio(RiskSimulationResult& result, const std::vector<double>& returns);
         void calculateProfitFactor(RiskSimulationResult& result, const std::vector<double>& tradeResults);
@@ -1,4 +1,5 @@
 #include "SessionManager.h"
+#include "SessionWal.h"
 #include "Utils.h"
 #include <algorithm>
 #include <numeric>
@@ -10,6 +11,7 @@
 #include <stdexcept>
 #include <random>
 #include <chrono>
+#include <filesystem>
 
 SessionManager::SessionManager() : 
     m_sessionActive(false),
@@ -23,8 +25,9 @@ SessionManager::SessionManager() :
 
 SessionManager::~SessionManager() {
     if (m_sessionActive && m_autoSave) {
-        saveSession();
+        finishAutosave();
     }
+    clearTrades();
 }
 
 void SessionManager::startNewSession(double initialBalance) {
@@ -34,24 +37,47 @@ void SessionManager::startNewSession(double initialBalance) {
     
     // If there's an active session, save it
     if (m_sessionActive && m_autoSave) {
-        saveSession();
+        finishAutosave();
     }
     
     // Clear previous session data
-    m_trades.clear();
+    clearTrades();
     m_initialBalance = initialBalance;
     m_currentBalance = initialBalance;
     m_sessionActive = true;
     generateSessionId();
+    
+    // The log belongs to one session; begin a fresh one
+    m_wal.reset();
+    autosaveLog();
 }
 
 void SessionManager::endSession() {
     if (m_sessionActive && m_autoSave) {
-        saveSession();
+        finishAutosave();
     }
+    m_wal.reset();
     m_sessionActive = false;
 }
 
+void SessionManager::setAutoSave(bool autoSave) {
+    m_autoSave = autoSave;
+    if (autoSave) {
+        autosaveLog();
+    } else if (m_wal) {
+        checkpointAutosave();
+        m_wal.reset();
+    }
+}
+
+void SessionManager::setSessionFile(const std::string& filename) {
+    if (m_wal) {
+        checkpointAutosave();
+        m_wal.reset();
+    }
+    m_sessionFile = filename;
+}
+
 bool SessionManager::isSessionActive() const {
     return m_sessionActive;
 }
@@ -79,7 +105,7 @@ bool SessionManager::addTrade(std::shared_ptr<Trade> trade) {
         return false;
     }
     
-    m_trades.push_back(trade);
+    appendTrade(trade);
     
     // If outcome is set, update the balance
     if (trade->getOutcome() != TradeOutcome::Pending) {
@@ -87,8 +113,12 @@ bool SessionManager::addTrade(std::shared_ptr<Trade> trade) {
     }
     
     // Auto-save if enabled
-    if (m_autoSave) {
-        trade->save(m_sessionFile);
+    if (SessionWal* wal = autosaveLog()) {
+        if (!wal->appendTrade(trade->toRecord(), m_currentBalance)) {
+            std::cerr << "Error: Unable to write " << wal->getLogPath() << std::endl;
+        } else if (wal->needsCompaction()) {
+            checkpointAutosave();
+        }
     }
     
     return true;
@@ -102,25 +132,32 @@ bool SessionManager::simulateTrade(std::shared_ptr<Trade> trade, TradeOutcome ou
     trade->simulateOutcome(outcome);
     updateBalance(trade);
     
-    // Auto-save if enabled
-    if (m_autoSave) {
-        trade->save(m_sessionFile);
+    // Every slot holding the trade swaps its old contribution for the new one;
+    // trades not in the session are counted when they are added
+    auto slots = m_tradeSlots.equal_range(trade.get());
+    if (slots.first != slots.second) {
+        TradeContribution updated = contributionOf(*trade);
+        for (auto it = slots.first; it != slots.second; ++it) {
+            TradeContribution previous = m_contributions[it->second];
+            m_contributions[it->second] = updated;
+            retractContribution(previous);
+            applyContribution(updated);
+        }
+        
+        // Auto-save if enabled; trades not yet in the session are logged when added
+        if (SessionWal* wal = autosaveLog()) {
+            if (!wal->appendUpdate(trade->toRecord(), m_currentBalance)) {
+                std::cerr << "Error: Unable to write " << wal->getLogPath() << std::endl;
+            }
+        }
     }
     
     return true;
 }
 
 std::shared_ptr<Trade> SessionManager::getTrade(const std::string& id) const {
-    auto it = std::find_if(m_trades.begin(), m_trades.end(), 
-        [&id](const std::shared_ptr<Trade>& trade) {
-            return trade->getId() == id;
-        });
-    
-    if (it != m_trades.end()) {
-        return *it;
-    }
-    
-    return nullptr;
+    auto indexed = m_tradeIndex.find(id);
+    return (indexed != m_tradeIndex.end()) ? m_trades[indexed->second] : nullptr;
 }
 
 std::shared_ptr<Trade> SessionManager::getLastTrade() const {
@@ -137,10 +174,57 @@ std::vector<std::shared_ptr<Trade>> SessionManager::getAllTrades() const {
 
 SessionStats SessionManager::getSessionStats() const {
     SessionStats stats;
-    calculateStats(stats);
+    stats.initialBalance = m_initialBalance;
+    stats.currentBalance = m_currentBalance;
+    stats.totalTrades = static_cast<int>(m_trades.size());
+    stats.winningTrades = m_running.winningTrades;
+    stats.losingTrades = m_running.losingTrades;
+    stats.breakEvenTrades = m_running.breakEvenTrades;
+    stats.largestWin = m_running.largestWin;
+    stats.largestLoss = m_running.largestLoss;
+    stats.totalPnL = stats.currentBalance - stats.initialBalance;
+    
+    int completedTrades = stats.winningTrades + stats.losingTrades + stats.breakEvenTrades;
+    if (completedTrades > 0) {
+        stats.winRate = static_cast<double>(stats.winningTrades) / completedTrades;
+        stats.averageRR = m_running.totalRR / completedTrades;
+    }
+    
+    if (m_running.totalLosses > 0) {
+        stats.profitFactor = m_running.totalWins / m_running.totalLosses;
+    }
+    
     return stats;
 }
 
+bool SessionManager::checkStatsConsistency(double tolerance) const {
+    SessionStats running = getSessionStats();
+    SessionStats full;
+    calculateStats(full);
+    
+    bool consistent = true;
+    auto compare = [&](const char* field, double a, double b) {
+        if (std::abs(a - b) > tolerance * std::max(1.0, std::abs(b))) {
+            std::cerr << "Session stats mismatch in " << field << ": running " << a
+                      << ", recomputed " << b << std::endl;
+            consistent = false;
+        }
+    };
+    
+    compare("totalTrades", running.totalTrades, full.totalTrades);
+    compare("winningTrades", running.winningTrades, full.winningTrades);
+    compare("losingTrades", running.losingTrades, full.losingTrades);
+    compare("breakEvenTrades", running.breakEvenTrades, full.breakEvenTrades);
+    compare("totalPnL", running.totalPnL, full.totalPnL);
+    compare("winRate", running.winRate, full.winRate);
+    compare("averageRR", running.averageRR, full.averageRR);
+    compare("largestWin", running.largestWin, full.largestWin);
+    compare("largestLoss", running.largestLoss, full.largestLoss);
+    compare("profitFactor", running.profitFactor, full.profitFactor);
+    
+    return consistent;
+}
+
 std::string SessionManager::getSessionSummary() const {
     SessionStats stats = getSessionStats();
     
@@ -292,6 +376,11 @@ bool SessionManager::saveSessionAsJson(const std::string& filename) {
 }
 
 bool SessionManager::loadSession(const std::string& filename) {
+    // A log newer than the CSV holds changes the CSV never received
+    if (SessionWal::isCurrent(filename)) {
+        return recoverSession(filename);
+    }
+    
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Unable to open file " << filename << " for reading." << std::endl;
@@ -299,7 +388,8 @@ bool SessionManager::loadSession(const std::string& filename) {
     }
     
     // Clear current trades
-    m_trades.clear();
+    clearTrades();
+    m_wal.reset();
     
     // Skip header
     std::string header;
@@ -372,7 +462,7 @@ bool SessionManager::loadSession(const std::string& filename) {
             }
             
             // Add trade
-            m_trades.push_back(trade);
+            appendTrade(trade);
         } catch (const std::exception& e) {
             std::cerr << "Error parsing trade: " << e.what() << std::endl;
             continue; // Skip this trade
@@ -473,4 +563,208 @@ void SessionManager::calculateStats(SessionStats& stats) const {
     if (totalLosses > 0) {
         stats.profitFactor = totalWins / totalLosses;
     }
-} 
\ No newline at end of file
+} 
+
+SessionManager::TradeContribution SessionManager::contributionOf(const Trade& trade) {
+    // Same classification as calculateStats()
+    TradeContribution contribution;
+    if (trade.getOutcome() == TradeOutcome::Pending) {
+        return contribution;
+    }
+    
+    contribution.completed = true;
+    contribution.pnl = trade.getUpdatedAccountBalance() - trade.getParameters().accountBalance;
+    contribution.riskRewardRatio = trade.getResultsRef().riskRewardRatio;
+    return contribution;
+}
+
+void SessionManager::applyContribution(const TradeContribution& contribution) {
+    if (!contribution.completed) {
+        return;
+    }
+    
+    if (contribution.pnl > 0) {
+        m_running.winningTrades++;
+        m_running.totalWins += contribution.pnl;
+        m_running.largestWin = std::max(m_running.largestWin, contribution.pnl);
+    } else if (contribution.pnl < 0) {
+        m_running.losingTrades++;
+        m_running.totalLosses += std::abs(contribution.pnl);
+        m_running.largestLoss = std::min(m_running.largestLoss, contribution.pnl);
+    } else {
+        m_running.breakEvenTrades++;
+    }
+    
+    m_running.totalRR += contribution.riskRewardRatio;
+}
+
+void SessionManager::retractContribution(const TradeContribution& contribution) {
+    if (!contribution.completed) {
+        return;
+    }
+    
+    bool extremeRemoved = false;
+    if (contribution.pnl > 0) {
+        m_running.winningTrades--;
+        m_running.totalWins -= contribution.pnl;
+        extremeRemoved = (contribution.pnl == m_running.largestWin);
+    } else if (contribution.pnl < 0) {
+        m_running.losingTrades--;
+        m_running.totalLosses -= std::abs(contribution.pnl);
+        extremeRemoved = (contribution.pnl == m_running.largestLoss);
+    } else {
+        m_running.breakEvenTrades--;
+    }
+    
+    m_running.totalRR -= contribution.riskRewardRatio;
+    
+    // Do not let rounding leave a residue behind once a category is empty
+    if (m_running.winningTrades == 0) m_running.totalWins = 0.0;
+    if (m_running.losingTrades == 0) m_running.totalLosses = 0.0;
+    if (m_running.winningTrades + m_running.losingTrades + m_running.breakEvenTrades == 0) {
+        m_running.totalRR = 0.0;
+    }
+    
+    // A maximum cannot be undone in O(1); rescan only when the extreme itself went away
+    if (extremeRemoved) {
+        recomputeExtremes();
+    }
+}
+
+void SessionManager::recomputeExtremes() {
+    m_running.largestWin = 0.0;
+    m_running.largestLoss = 0.0;
+    for (const auto& contribution : m_contributions) {
+        if (!contribution.completed) {
+            continue;
+        }
+        m_running.largestWin = std::max(m_running.largestWin, contribution.pnl);
+        m_running.largestLoss = std::min(m_running.largestLoss, contribution.pnl);
+    }
+}
+
+void SessionManager::appendTrade(const std::shared_ptr<Trade>& trade) {
+    // Keep the first trade for a repeated ID, as the linear lookup did
+    m_tradeIndex.emplace(trade->getId(), m_trades.size());
+    m_trades.push_back(trade);
+    
+    // A reset gives the trade a new ID; reindexing then costs one pass,
+    // and lookups never have to scan
+    trade->addIdChangedHandler(this, [this](const Trade&, const std::string&) {
+        rebuildTradeIndex();
+    });
+    
+    TradeContribution contribution = contributionOf(*trade);
+    m_tradeSlots.emplace(trade.get(), m_contributions.size());
+    m_contributions.push_back(contribution);
+    applyContribution(contribution);
+}
+
+void SessionManager::clearTrades() {
+    // Trades can outlive the session through the pointers it handed out
+    for (const auto& trade : m_trades) {
+        trade->removeIdChangedHandler(this);
+    }
+    m_trades.clear();
+    m_tradeIndex.clear();
+    resetStats();
+}
+
+void SessionManager::rebuildTradeIndex() {
+    m_tradeIndex.clear();
+    for (std::size_t slot = 0; slot < m_trades.size(); ++slot) {
+        m_tradeIndex.emplace(m_trades[slot]->getId(), slot);
+    }
+}
+
+void SessionManager::resetStats() {
+    m_running = RunningStats();
+    m_contributions.clear();
+    m_tradeSlots.clear();
+}
+
+SessionWal* SessionManager::autosaveLog() {
+    if (!m_autoSave || !m_sessionActive) {
+        return nullptr;
+    }
+    
+    if (!m_wal) {
+        // Start the log with everything the session already holds
+        m_wal = std::make_unique<SessionWal>(m_sessionFile);
+        bool ready = m_wal->startSession(m_sessionId, m_initialBalance) &&
+                     (m_trades.empty() || m_wal->compact(buildSnapshot()));
+        if (!ready) {
+            std::cerr << "Error: Unable to open session log " << m_wal->getLogPath() << std::endl;
+            m_wal.reset();
+        }
+    }
+    
+    return m_wal.get();
+}
+
+void SessionManager::checkpointAutosave() {
+    if (m_wal && !m_wal->compact(buildSnapshot())) {
+        std::cerr << "Error: Unable to write session snapshot " << m_wal->getSnapshotPath() << std::endl;
+        m_wal->sync();
+    }
+}
+
+void SessionManager::finishAutosave() {
+    // The CSV is the record of a finished session; the log is only kept if it could not be written
+    if (m_trades.empty() || saveSession()) {
+        m_wal.reset();
+        SessionWal::remove(m_sessionFile);
+    } else {
+        checkpointAutosave();
+    }
+}
+
+SessionSnapshot SessionManager::buildSnapshot() const {
+    SessionSnapshot snapshot;
+    snapshot.sessionId = m_sessionId;
+    snapshot.initialBalance = m_initialBalance;
+    snapshot.currentBalance = m_currentBalance;
+    snapshot.trades.reserve(m_trades.size());
+    for (const auto& trade : m_trades) {
+        snapshot.trades.push_back(trade->toRecord());
+    }
+    return snapshot;
+}
+
+bool SessionManager::recoverSession(const std::string& filename) {
+    SessionSnapshot snapshot;
+    if (!SessionWal::replay(filename, snapshot)) {
+        std::cerr << "Error: No session found in the log for " << filename << std::endl;
+        return false;
+    }
+    
+    m_wal.reset();
+    clearTrades();
+    
+    for (const auto& record : snapshot.trades) {
+        appendTrade(Trade::fromRecord(record));
+    }
+    
+    m_sessionActive = true;
+    m_initialBalance = snapshot.initialBalance;
+    m_currentBalance = snapshot.currentBalance;
+    if (!snapshot.sessionId.empty()) {
+        m_sessionId = snapshot.sessionId;
+    }
+    
+    // Keep the CSV name when given the log itself, so saveSession() cannot overwrite it
+    std::string extension = std::filesystem::path(filename).extension().string();
+    m_sessionFile = (extension == ".wal" || extension == ".snap") ?
+        Utils::replaceExtension(filename, ".csv") : filename;
+    
+    // Continue appending to the recovered log
+    if (m_autoSave) {
+        m_wal = std::make_unique<SessionWal>(m_sessionFile);
+        if (!m_wal->open()) {
+            std::cerr << "Error: Unable to reopen session log " << m_wal->getLogPath() << std::endl;
+            m_wal.reset();
+        }
+    }
+    
+    return true;
+}
@@ -4,8 +4,12 @@
 #include <vector>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include "Trade.h"
 
+class SessionWal;
+struct SessionSnapshot;
+
 struct SessionStats {
     double initialBalance = 0.0;
     double currentBalance = 0.0;
@@ -40,23 +44,54 @@ public:
     std::shared_ptr<Trade> getLastTrade() const;
     std::vector<std::shared_ptr<Trade>> getAllTrades() const;
     
-    // Statistics
+    // The session's trades in the order they were added, without copying.
+    // Invalidated by any call that adds, loads or clears trades.
+    const std::vector<std::shared_ptr<Trade>>& getTradesView() const { return m_trades; }
+    
+    // Statistics (maintained as trades are added or resolved)
     SessionStats getSessionStats() const;
     std::string getSessionSummary() const;
     
-    // Save/Load
+    // Compare the running statistics with a full recompute over all trades
+    bool checkStatsConsistency(double tolerance = 1e-6) const;
+    
+    // Save/Load. loadSession() replays the autosave snapshot and log when
+    // they exist next to the file and are no older than it (a session that
+    // did not end cleanly), and reads the CSV otherwise.
     bool saveSession(const std::string& filename = "");
     bool saveSessionAsJson(const std::string& filename = "");
     bool loadSession(const std::string& filename);
     
-    // Configuration
-    void setAutoSave(bool autoSave) { m_autoSave = autoSave; }
+    // Configuration. With auto-save on, every change is appended to a binary
+    // log next to the session file (see SessionWal). Ending the session
+    // writes the CSV and removes the log.
+    void setAutoSave(bool autoSave);
     bool getAutoSave() const { return m_autoSave; }
-    void setSessionFile(const std::string& filename) { m_sessionFile = filename; }
+    void setSessionFile(const std::string& filename);
     std::string getSessionFile() const { return m_sessionFile; }
     
 private:
+    // What one trade adds to the running statistics, kept so it can be undone
+    struct TradeContribution {
+        bool completed = false;
+        double pnl = 0.0;
+        double riskRewardRatio = 0.0;
+    };
+    
+    // Running totals behind getSessionStats()
+    struct RunningStats {
+        int winningTrades = 0;
+        int losingTrades = 0;
+        int breakEvenTrades = 0;
+        double totalWins = 0.0;
+        double totalLosses = 0.0;
+        double totalRR = 0.0;
+        double largestWin = 0.0;
+        double largestLoss = 0.0;
+    };
+    
     std::vector<std::shared_ptr<Trade>> m_trades;
+    std::unordered_map<std::string, std::size_t> m_tradeIndex;  // Trade ID -> position in m_trades
     bool m_sessionActive;
     double m_initialBalance;
     double m_currentBalance;
@@ -64,10 +99,31 @@ private:
     std::string m_sessionFile;
     std::string m_sessionId;
     
+    RunningStats m_running;
+    std::vector<TradeContribution> m_contributions;  // One per slot of m_trades
+    std::unordered_multimap<const Trade*, std::size_t> m_tradeSlots;  // Slots holding each trade
+    
+    std::unique_ptr<SessionWal> m_wal;  // Open while auto-save is on
+    
     // Helper methods
     void updateBalance(const std::shared_ptr<Trade>& trade);
     void generateSessionId();
+    void appendTrade(const std::shared_ptr<Trade>& trade);
+    void clearTrades();
+    void rebuildTradeIndex();
     void calculateStats(SessionStats& stats) const;
+    
+    static TradeContribution contributionOf(const Trade& trade);
+    void applyContribution(const TradeContribution& contribution);
+    void retractContribution(const TradeContribution& contribution);
+    void recomputeExtremes();
+    void resetStats();
+    
+    SessionWal* autosaveLog();
+    void checkpointAutosave();
+    void finishAutosave();
+    SessionSnapshot buildSnapshot() const;
+    bool recoverSession(const std::string& filename);
 };
 
 #endif // SESSION_MANAGER_H 
\ No newline at end of file
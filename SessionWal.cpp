@@ -0,0 +1,515 @@
+#include "SessionWal.h"
+#include "Utils.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+// Platform-specific unbuffered file output
+#if defined(_WIN32)
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char LOG_MAGIC[8] = {'T', 'C', 'S', 'E', 'S', 'W', 'A', 'L'};
+    constexpr char SNAPSHOT_MAGIC[8] = {'T', 'C', 'S', 'E', 'S', 'S', 'N', 'P'};
+    constexpr std::uint32_t FORMAT_VERSION = 2;
+    constexpr std::uint32_t MAX_PAYLOAD = 4096;
+
+    struct LogHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t tradeRecordSize;
+    };
+
+    // The CRC covers everything after the crc field, then the payload
+    struct RecordHeader {
+        std::uint32_t length;
+        std::uint32_t crc;
+        std::uint64_t sequence;
+        std::uint8_t type;
+        std::uint8_t reserved[7];
+    };
+
+    struct SessionStartRecord {
+        char sessionId[48];
+        double initialBalance;
+    };
+
+    struct TradeEventRecord {
+        double currentBalance;
+        TradeRecord trade;
+    };
+
+    struct SnapshotHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t tradeRecordSize;
+        std::uint64_t lastSequence;   // Log records up to here are already included
+        std::uint64_t tradeCount;
+        double initialBalance;
+        double currentBalance;
+        char sessionId[48];
+        std::uint32_t crc;            // Over the header (with crc = 0) and the trades
+        std::uint32_t reserved;
+    };
+
+    constexpr std::size_t RECORD_CRC_OFFSET = offsetof(RecordHeader, sequence);
+
+    constexpr std::array<std::uint32_t, 256> makeCrcTable() {
+        std::array<std::uint32_t, 256> table{};
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            std::uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            table[i] = c;
+        }
+        return table;
+    }
+
+    constexpr std::array<std::uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+    // CRC-32 (IEEE); pass the previous result to continue over several buffers
+    std::uint32_t crc32(const void* data, std::size_t size, std::uint32_t crc = 0) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i) {
+            crc = CRC_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void copyId(char (&target)[48], const std::string& id) {
+        std::memset(target, 0, sizeof(target));
+        std::memcpy(target, id.data(), std::min(id.size(), sizeof(target) - 1));
+    }
+
+    std::string readId(const char (&source)[48]) {
+        return std::string(source, strnlen(source, sizeof(source)));
+    }
+
+    int openForAppend(const std::string& path, bool truncate) {
+#if defined(_WIN32)
+        int flags = _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | (truncate ? _O_TRUNC : 0);
+        return _open(path.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+        int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0);
+        return ::open(path.c_str(), flags, 0644);
+#endif
+    }
+
+    bool writeAll(int fd, const void* data, std::size_t size) {
+        const char* bytes = static_cast<const char*>(data);
+        while (size > 0) {
+#if defined(_WIN32)
+            int written = _write(fd, bytes, static_cast<unsigned int>(size));
+#else
+            ssize_t written = ::write(fd, bytes, size);
+#endif
+            if (written <= 0) {
+                return false;
+            }
+            bytes += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        return true;
+    }
+
+    // Current end of the file, or -1
+    std::int64_t fileEnd(int fd) {
+#if defined(_WIN32)
+        return _lseeki64(fd, 0, SEEK_END);
+#else
+        return static_cast<std::int64_t>(::lseek(fd, 0, SEEK_END));
+#endif
+    }
+
+    bool truncateFile(int fd, std::int64_t size) {
+#if defined(_WIN32)
+        return _chsize_s(fd, size) == 0;
+#else
+        return ::ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif
+    }
+
+    bool syncFile(int fd) {
+#if defined(_WIN32)
+        return _commit(fd) == 0;
+#else
+        return ::fsync(fd) == 0;
+#endif
+    }
+
+    void closeFile(int fd) {
+#if defined(_WIN32)
+        _close(fd);
+#else
+        ::close(fd);
+#endif
+    }
+
+    std::vector<char> readFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return {};
+        }
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+}
+
+SessionWal::SessionWal(const std::string& sessionFile)
+    : SessionWal(sessionFile, Options()) {
+}
+
+SessionWal::SessionWal(const std::string& sessionFile, const Options& options)
+    : m_logPath(Utils::replaceExtension(sessionFile, ".wal")),
+      m_snapshotPath(Utils::replaceExtension(sessionFile, ".snap")),
+      m_options(options),
+      m_lastSync(std::chrono::steady_clock::now()) {
+}
+
+SessionWal::~SessionWal() {
+    closeLog();
+}
+
+bool SessionWal::exists(const std::string& sessionFile) {
+    std::error_code ec;
+    return std::filesystem::exists(Utils::replaceExtension(sessionFile, ".wal"), ec) ||
+           std::filesystem::exists(Utils::replaceExtension(sessionFile, ".snap"), ec);
+}
+
+bool SessionWal::isCurrent(const std::string& sessionFile) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::file_time_type newest = fs::file_time_type::min();
+    bool found = false;
+    for (const char* extension : {".wal", ".snap"}) {
+        std::string path = Utils::replaceExtension(sessionFile, extension);
+        if (fs::exists(path, ec)) {
+            newest = std::max(newest, fs::last_write_time(path, ec));
+            found = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    // Given the log or snapshot itself, there is nothing else to compare with
+    fs::path extension = fs::path(sessionFile).extension();
+    if (extension == ".wal" || extension == ".snap" || !fs::exists(sessionFile, ec)) {
+        return true;
+    }
+    return newest >= fs::last_write_time(sessionFile, ec);
+}
+
+void SessionWal::remove(const std::string& sessionFile) {
+    std::error_code ec;
+    std::filesystem::remove(Utils::replaceExtension(sessionFile, ".wal"), ec);
+    std::filesystem::remove(Utils::replaceExtension(sessionFile, ".snap"), ec);
+}
+
+bool SessionWal::open() {
+    closeLog();
+
+    SessionSnapshot ignored;
+    std::uint64_t snapshotSequence = 0;
+    readSnapshot(m_snapshotPath, ignored, snapshotSequence);
+
+    LogScan scan = scanLog(m_logPath, nullptr, 0);
+    m_nextSequence = std::max(snapshotSequence, scan.lastSequence) + 1;
+    if (!scan.headerValid) {
+        return createLog();
+    }
+
+    // Drop a record that was only partly written when the process died
+    std::error_code ec;
+    if (std::filesystem::file_size(m_logPath, ec) != scan.validBytes && !ec) {
+        std::filesystem::resize_file(m_logPath, scan.validBytes, ec);
+        if (ec) {
+            return false;
+        }
+    }
+
+    m_fd = openForAppend(m_logPath, false);
+    m_logRecords = scan.records;
+    m_unsyncedRecords = 0;
+    m_lastSync = std::chrono::steady_clock::now();
+    return m_fd >= 0;
+}
+
+bool SessionWal::startSession(const std::string& sessionId, double initialBalance) {
+    closeLog();
+    std::error_code ec;
+    std::filesystem::remove(m_snapshotPath, ec);
+    if (!createLog()) {
+        return false;
+    }
+
+    SessionStartRecord start{};
+    copyId(start.sessionId, sessionId);
+    start.initialBalance = initialBalance;
+    return append(RecordType::SessionStart, &start, sizeof(start)) && sync();
+}
+
+bool SessionWal::appendTrade(const TradeRecord& trade, double currentBalance) {
+    TradeEventRecord event{currentBalance, trade};
+    return append(RecordType::AddTrade, &event, sizeof(event));
+}
+
+bool SessionWal::appendUpdate(const TradeRecord& trade, double currentBalance) {
+    TradeEventRecord event{currentBalance, trade};
+    return append(RecordType::UpdateTrade, &event, sizeof(event));
+}
+
+bool SessionWal::append(RecordType type, const void* payload, std::uint32_t size) {
+    if (m_fd < 0) {
+        return false;
+    }
+
+    // Header and payload go out in a single write
+    char buffer[sizeof(RecordHeader) + MAX_PAYLOAD];
+    RecordHeader header{};
+    header.length = size;
+    header.sequence = m_nextSequence;
+    header.type = static_cast<std::uint8_t>(type);
+    std::memcpy(buffer, &header, sizeof(header));
+    std::memcpy(buffer + sizeof(header), payload, size);
+
+    std::uint32_t crc = crc32(buffer + RECORD_CRC_OFFSET, sizeof(header) - RECORD_CRC_OFFSET + size);
+    std::memcpy(buffer + offsetof(RecordHeader, crc), &crc, sizeof(crc));
+
+    // A write that fails partway must not leave a torn record in front of
+    // later ones, or replay would stop there and drop them. If it cannot be
+    // cut off, the log is closed so that every later append fails too.
+    std::int64_t end = fileEnd(m_fd);
+    if (end < 0) {
+        return false;
+    }
+    if (!writeAll(m_fd, buffer, sizeof(header) + size)) {
+        if (!truncateFile(m_fd, end)) {
+            closeLog();
+        }
+        return false;
+    }
+
+    m_nextSequence++;
+    m_logRecords++;
+    m_unsyncedRecords++;
+
+    // Group commit: one fsync covers every record written since the last one
+    if (m_unsyncedRecords >= m_options.syncEveryRecords ||
+        std::chrono::steady_clock::now() - m_lastSync >= m_options.syncInterval) {
+        return sync();
+    }
+    return true;
+}
+
+bool SessionWal::sync() {
+    if (m_fd < 0) {
+        return false;
+    }
+    if (m_unsyncedRecords == 0) {
+        return true;
+    }
+
+    bool synced = syncFile(m_fd);
+    m_unsyncedRecords = 0;
+    m_lastSync = std::chrono::steady_clock::now();
+    return synced;
+}
+
+bool SessionWal::compact(const SessionSnapshot& snapshot) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.tradeRecordSize = sizeof(TradeRecord);
+    header.lastSequence = m_nextSequence - 1;
+    header.tradeCount = snapshot.trades.size();
+    header.initialBalance = snapshot.initialBalance;
+    header.currentBalance = snapshot.currentBalance;
+    copyId(header.sessionId, snapshot.sessionId);
+
+    std::size_t tradeBytes = snapshot.trades.size() * sizeof(TradeRecord);
+    std::uint32_t crc = crc32(&header, sizeof(header));
+    crc = crc32(snapshot.trades.data(), tradeBytes, crc);
+    header.crc = crc;
+
+    // Write aside and rename, so a crash leaves either the old or the new snapshot
+    std::string tempPath = m_snapshotPath + ".tmp";
+    int fd = openForAppend(tempPath, true);
+    if (fd < 0) {
+        return false;
+    }
+    bool written = writeAll(fd, &header, sizeof(header)) &&
+                   writeAll(fd, snapshot.trades.data(), tradeBytes) &&
+                   syncFile(fd);
+    closeFile(fd);
+
+    std::error_code ec;
+    if (written) {
+        std::filesystem::rename(tempPath, m_snapshotPath, ec);
+    }
+    if (!written || ec) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+
+    // Log records up to lastSequence are in the snapshot; if we crash before
+    // the truncation below, replay skips them by sequence number
+    closeLog();
+    return createLog();
+}
+
+bool SessionWal::replay(const std::string& sessionFile, SessionSnapshot& snapshot) {
+    snapshot = SessionSnapshot();
+    std::uint64_t lastSequence = 0;
+    bool haveSnapshot = readSnapshot(Utils::replaceExtension(sessionFile, ".snap"), snapshot, lastSequence);
+
+    scanLog(Utils::replaceExtension(sessionFile, ".wal"), &snapshot, lastSequence);
+    return haveSnapshot || !snapshot.sessionId.empty();
+}
+
+bool SessionWal::createLog() {
+    m_fd = openForAppend(m_logPath, true);
+    if (m_fd < 0) {
+        return false;
+    }
+
+    LogHeader header{};
+    std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+    header.version = FORMAT_VERSION;
+    header.tradeRecordSize = sizeof(TradeRecord);
+    if (!writeAll(m_fd, &header, sizeof(header)) || !syncFile(m_fd)) {
+        closeLog();
+        return false;
+    }
+
+    m_logRecords = 0;
+    m_unsyncedRecords = 0;
+    m_lastSync = std::chrono::steady_clock::now();
+    return true;
+}
+
+void SessionWal::closeLog() {
+    if (m_fd >= 0) {
+        sync();
+        closeFile(m_fd);
+        m_fd = -1;
+    }
+}
+
+SessionWal::LogScan SessionWal::scanLog(const std::string& path, SessionSnapshot* snapshot,
+                                        std::uint64_t afterSequence) {
+    LogScan scan;
+    std::vector<char> data = readFile(path);
+    if (data.size() < sizeof(LogHeader)) {
+        return scan;
+    }
+
+    LogHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.tradeRecordSize != sizeof(TradeRecord)) {
+        return scan;
+    }
+    scan.headerValid = true;
+
+    // Position of each trade id in snapshot->trades, for updates
+    std::unordered_map<std::string, std::size_t> index;
+    if (snapshot) {
+        for (std::size_t i = 0; i < snapshot->trades.size(); ++i) {
+            index[readId(snapshot->trades[i].id)] = i;
+        }
+    }
+
+    std::size_t offset = sizeof(LogHeader);
+    while (offset + sizeof(RecordHeader) <= data.size()) {
+        RecordHeader record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        if (record.length > MAX_PAYLOAD || offset + sizeof(RecordHeader) + record.length > data.size()) {
+            break; // Torn tail
+        }
+
+        const char* payload = data.data() + offset + sizeof(RecordHeader);
+        std::uint32_t crc = crc32(data.data() + offset + RECORD_CRC_OFFSET,
+                                  sizeof(RecordHeader) - RECORD_CRC_OFFSET + record.length);
+        if (crc != record.crc) {
+            break;
+        }
+
+        if (snapshot && record.sequence > afterSequence) {
+            auto type = static_cast<RecordType>(record.type);
+            if (type == RecordType::SessionStart && record.length == sizeof(SessionStartRecord)) {
+                SessionStartRecord start;
+                std::memcpy(&start, payload, sizeof(start));
+                *snapshot = SessionSnapshot();
+                snapshot->sessionId = readId(start.sessionId);
+                snapshot->initialBalance = start.initialBalance;
+                snapshot->currentBalance = start.initialBalance;
+                index.clear();
+            } else if ((type == RecordType::AddTrade || type == RecordType::UpdateTrade) &&
+                       record.length == sizeof(TradeEventRecord)) {
+                TradeEventRecord event;
+                std::memcpy(&event, payload, sizeof(event));
+                snapshot->currentBalance = event.currentBalance;
+
+                auto found = index.find(readId(event.trade.id));
+                if (found != index.end()) {
+                    snapshot->trades[found->second] = event.trade;
+                } else if (type == RecordType::AddTrade) {
+                    index[readId(event.trade.id)] = snapshot->trades.size();
+                    snapshot->trades.push_back(event.trade);
+                }
+            }
+        }
+
+        offset += sizeof(RecordHeader) + record.length;
+        scan.lastSequence = record.sequence;
+        scan.records++;
+    }
+
+    scan.validBytes = offset;
+    return scan;
+}
+
+bool SessionWal::readSnapshot(const std::string& path, SessionSnapshot& snapshot, std::uint64_t& lastSequence) {
+    std::vector<char> data = readFile(path);
+    if (data.size() < sizeof(SnapshotHeader)) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 ||
+        header.version != FORMAT_VERSION ||
+        header.tradeRecordSize != sizeof(TradeRecord) ||
+        data.size() != sizeof(SnapshotHeader) + header.tradeCount * sizeof(TradeRecord)) {
+        return false;
+    }
+
+    std::uint32_t storedCrc = header.crc;
+    header.crc = 0;
+    std::uint32_t crc = crc32(&header, sizeof(header));
+    crc = crc32(data.data() + sizeof(SnapshotHeader), data.size() - sizeof(SnapshotHeader), crc);
+    if (crc != storedCrc) {
+        return false;
+    }
+
+    snapshot.sessionId = readId(header.sessionId);
+    snapshot.initialBalance = header.initialBalance;
+    snapshot.currentBalance = header.currentBalance;
+    snapshot.trades.resize(static_cast<std::size_t>(header.tradeCount));
+    std::memcpy(snapshot.trades.data(), data.data() + sizeof(SnapshotHeader),
+                snapshot.trades.size() * sizeof(TradeRecord));
+    lastSequence = header.lastSequence;
+    return true;
+}
@@ -0,0 +1,110 @@
+#ifndef SESSION_WAL_H
+#define SESSION_WAL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Trade.h"
+
+// Session state as rebuilt from the snapshot and the log
+struct SessionSnapshot {
+    std::string sessionId;
+    double initialBalance = 0.0;
+    double currentBalance = 0.0;
+    std::vector<TradeRecord> trades;  // In the order they were added
+};
+
+// Append-only binary log of session changes, with periodic compaction into a
+// snapshot. For a session file "trades.csv" the files are "trades.wal" and
+// "trades.snap".
+//
+// Every log record is length-prefixed, numbered and CRC-32 checked, and is
+// handed to the OS with one write() call, so a crashed process loses nothing.
+// fsync is batched (group commit): a power loss can drop at most the records
+// written since the last sync. Replay stops at the first torn or corrupt record.
+class SessionWal {
+public:
+    enum class RecordType : std::uint8_t {
+        SessionStart = 1,  // Payload: SessionStartRecord
+        AddTrade = 2,      // Payload: TradeEventRecord
+        UpdateTrade = 3    // Payload: TradeEventRecord (replaces the trade with the same id)
+    };
+
+    struct Options {
+        std::size_t syncEveryRecords = 32;            // fsync after this many records...
+        std::chrono::milliseconds syncInterval{200};  // ...or once this much time has passed
+        std::size_t compactAfterRecords = 4096;       // needsCompaction() past this log length
+    };
+
+    explicit SessionWal(const std::string& sessionFile);
+    SessionWal(const std::string& sessionFile, const Options& options);
+    ~SessionWal();
+
+    SessionWal(const SessionWal&) = delete;
+    SessionWal& operator=(const SessionWal&) = delete;
+
+    // Continue the existing log (dropping a torn tail), or create an empty one
+    bool open();
+
+    // Discard the snapshot and log and begin a new session
+    bool startSession(const std::string& sessionId, double initialBalance);
+
+    // Log a trade added to the session, or a change to one already in it
+    bool appendTrade(const TradeRecord& trade, double currentBalance);
+    bool appendUpdate(const TradeRecord& trade, double currentBalance);
+
+    // Force everything written so far to stable storage
+    bool sync();
+
+    // Write the full session as a snapshot and start an empty log
+    bool compact(const SessionSnapshot& snapshot);
+
+    bool needsCompaction() const { return m_logRecords >= m_options.compactAfterRecords; }
+    bool isOpen() const { return m_fd >= 0; }
+    std::size_t getLogRecordCount() const { return m_logRecords; }
+
+    const std::string& getLogPath() const { return m_logPath; }
+    const std::string& getSnapshotPath() const { return m_snapshotPath; }
+
+    // True if a snapshot or log exists for the session file
+    static bool exists(const std::string& sessionFile);
+
+    // True if a snapshot or log exists and is no older than the session file
+    // itself, i.e. nothing was saved to the session file after the last write
+    static bool isCurrent(const std::string& sessionFile);
+
+    // Delete the snapshot and log of a session that ended cleanly
+    static void remove(const std::string& sessionFile);
+
+    // Rebuild the session from snapshot + log; false if neither holds a session
+    static bool replay(const std::string& sessionFile, SessionSnapshot& snapshot);
+
+private:
+    struct LogScan {
+        std::uint64_t validBytes = 0;    // Length of the intact prefix
+        std::uint64_t lastSequence = 0;
+        std::size_t records = 0;
+        bool headerValid = false;
+    };
+
+    bool append(RecordType type, const void* payload, std::uint32_t size);
+    bool createLog();
+    void closeLog();
+
+    static LogScan scanLog(const std::string& path, SessionSnapshot* snapshot, std::uint64_t afterSequence);
+    static bool readSnapshot(const std::string& path, SessionSnapshot& snapshot, std::uint64_t& lastSequence);
+
+    std::string m_logPath;
+    std::string m_snapshotPath;
+    Options m_options;
+
+    int m_fd = -1;
+    std::uint64_t m_nextSequence = 1;
+    std::size_t m_logRecords = 0;
+    std::size_t m_unsyncedRecords = 0;
+    std::chrono::steady_clock::time_point m_lastSync;
+};
+
+#endif // SESSION_WAL_H
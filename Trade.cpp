@@ -1,18 +1,26 @@
 #include "Trade.h"
 #include "TradeCalculator.h"
 #include "Utils.h"
+#include "Utils/IdGenerator.h"
 #include <sstream>
 #include <iomanip>
-#include <random>
 #include <chrono>
 #include <ctime>
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <fstream>
 #include <iostream>
 
+namespace {
+    // Trades use the default settings, so they all share one stateless calculator
+    const TradeCalculator& sharedCalculator() {
+        static const TradeCalculator calculator;
+        return calculator;
+    }
+}
+
 Trade::Trade() : m_outcome(TradeOutcome::Pending) {
-    m_calculator = std::make_unique<TradeCalculator>();
     m_params = std::make_unique<TradeParameters>();
     m_results = std::make_unique<TradeResults>();
     generateId();
@@ -135,7 +143,7 @@ void Trade::setContractSize(double size) {
 
 bool Trade::calculate() {
     try {
-        *m_results = m_calculator->calculateTrade(*m_params);
+        *m_results = sharedCalculator().calculateTrade(*m_params);
         return true;
     } catch (const std::exception& e) {
         Utils::printError("Calculation error: " + std::string(e.what()));
@@ -145,7 +153,7 @@ bool Trade::calculate() {
 
 bool Trade::calculateWithMultipleTargets() {
     try {
-        *m_results = m_calculator->calculateMultipleTargets(*m_params, m_tp1Percentage, m_tp2Percentage);
+        *m_results = sharedCalculator().calculateMultipleTargets(*m_params, m_tp1Percentage, m_tp2Percentage);
         return true;
     } catch (const std::exception& e) {
         Utils::printError("Calculation error: " + std::string(e.what()));
@@ -154,32 +162,27 @@ bool Trade::calculateWithMultipleTargets() {
 }
 
 void Trade::simulateOutcome(TradeOutcome outcome) {
+    // Replaces any earlier outcome rather than adding to it
     m_outcome = outcome;
-    double profitLoss = 0.0;
-    
+    m_profitLoss = profitLossFor(outcome);
+}
+
+double Trade::profitLossFor(TradeOutcome outcome) const {
     switch (outcome) {
         case TradeOutcome::LossAtSL:
-            profitLoss = -m_results->riskAmount;
-            break;
+            return -m_results->riskAmount;
         case TradeOutcome::WinAtTP1:
-            profitLoss = m_results->tp1Amount;
-            break;
+            return m_results->tp1Amount;
         case TradeOutcome::WinAtTP2:
-            profitLoss = m_results->tp2Amount;
-            break;
+            return m_results->tp2Amount;
         case TradeOutcome::BreakEven:
-            profitLoss = 0.0;
-            break;
         default:
-            profitLoss = 0.0;
-            break;
+            return 0.0;
     }
-    
-    m_params->accountBalance += profitLoss;
 }
 
 double Trade::getUpdatedAccountBalance() const {
-    return m_params->accountBalance;
+    return m_params->accountBalance + m_profitLoss;
 }
 
 TradeParameters Trade::getParameters() const {
@@ -190,6 +193,10 @@ TradeResults Trade::getResults() const {
     return *m_results;
 }
 
+const TradeResults& Trade::getResultsRef() const {
+    return *m_results;
+}
+
 TradeOutcome Trade::getOutcome() const {
     return m_outcome;
 }
@@ -313,6 +320,7 @@ void Trade::reset() {
     m_params = std::make_unique<TradeParameters>();
     m_results = std::make_unique<TradeResults>();
     m_outcome = TradeOutcome::Pending;
+    m_profitLoss = 0.0;
     generateId();
     m_timestamp = std::time(nullptr);
 }
@@ -329,19 +337,115 @@ std::string Trade::getId() const {
     return m_id;
 }
 
-void Trade::generateId() {
-    auto now = std::chrono::system_clock::now();
-    auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()
-    );
+TradeRecord Trade::toRecord() const {
+    TradeRecord record{};
+    std::size_t idLength = std::min(m_id.size(), sizeof(record.id) - 1);
+    std::memcpy(record.id, m_id.data(), idLength);
+    record.timestamp = static_cast<std::int64_t>(m_timestamp);
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 9999);
+    record.accountBalance = m_params->accountBalance;
+    record.riskPercent = m_params->riskPercent;
+    record.stopLossInPips = m_params->stopLossInPips;
+    record.takeProfitInPips = m_params->takeProfitInPips;
+    record.targetRiskRewardRatio = m_params->riskRewardRatio;
+    record.entryPrice = m_params->entryPrice;
+    record.stopLossPrice = m_params->stopLossPrice;
+    record.parameterTakeProfitPrice = m_params->takeProfitPrice;
+    record.contractSize = m_params->contractSize;
+    record.parameterTimestamp = static_cast<std::int64_t>(m_params->timestamp);
     
-    std::stringstream ss;
-    ss << "TRADE_" << now_ms.count() << "_" << std::setfill('0') << std::setw(4) << dis(gen);
-    m_id = ss.str();
+    record.riskAmount = m_results->riskAmount;
+    record.rewardAmount = m_results->rewardAmount;
+    record.positionSize = m_results->positionSize;
+    record.resultStopLossPrice = m_results->stopLossPrice;
+    record.takeProfitPrice = m_results->takeProfitPrice;
+    record.riskRewardRatio = m_results->riskRewardRatio;
+    record.pipValue = m_results->pipValue;
+    record.breakEvenPrice = m_results->breakEvenPrice;
+    record.breakEvenPips = m_results->breakEvenPips;
+    record.tp1Price = m_results->tp1Price;
+    record.tp2Price = m_results->tp2Price;
+    record.tp1Amount = m_results->tp1Amount;
+    record.tp2Amount = m_results->tp2Amount;
+    
+    record.tp1Percentage = m_tp1Percentage;
+    record.tp2Percentage = m_tp2Percentage;
+    
+    record.instrumentType = static_cast<std::uint8_t>(m_params->instrumentType);
+    record.lotSizeType = static_cast<std::uint8_t>(m_params->lotSizeType);
+    record.outcome = static_cast<std::uint8_t>(m_outcome);
+    record.slInputType = static_cast<std::uint8_t>(m_slInputType);
+    record.tpInputType = static_cast<std::uint8_t>(m_tpInputType);
+    record.isStopLossPriceOverride = m_params->isStopLossPriceOverride ? 1 : 0;
+    record.hasBreakEvenInfo = m_results->hasBreakEvenInfo ? 1 : 0;
+    record.hasMultipleTargets = m_results->hasMultipleTargets ? 1 : 0;
+    return record;
+}
+
+std::shared_ptr<Trade> Trade::fromRecord(const TradeRecord& record) {
+    auto trade = std::make_shared<Trade>();
+    trade->m_id.assign(record.id, strnlen(record.id, sizeof(record.id)));
+    trade->m_timestamp = static_cast<std::time_t>(record.timestamp);
+    
+    TradeParameters& params = *trade->m_params;
+    params.accountBalance = record.accountBalance;
+    params.riskPercent = record.riskPercent;
+    params.stopLossInPips = record.stopLossInPips;
+    params.takeProfitInPips = record.takeProfitInPips;
+    params.riskRewardRatio = record.targetRiskRewardRatio;
+    params.entryPrice = record.entryPrice;
+    params.stopLossPrice = record.stopLossPrice;
+    params.takeProfitPrice = record.parameterTakeProfitPrice;
+    params.contractSize = record.contractSize;
+    params.timestamp = static_cast<std::time_t>(record.parameterTimestamp);
+    params.instrumentType = static_cast<InstrumentType>(record.instrumentType);
+    params.lotSizeType = static_cast<LotSizeType>(record.lotSizeType);
+    params.isStopLossPriceOverride = record.isStopLossPriceOverride != 0;
+    
+    TradeResults& results = *trade->m_results;
+    results.riskAmount = record.riskAmount;
+    results.rewardAmount = record.rewardAmount;
+    results.positionSize = record.positionSize;
+    results.stopLossPrice = record.resultStopLossPrice;
+    results.takeProfitPrice = record.takeProfitPrice;
+    results.riskRewardRatio = record.riskRewardRatio;
+    results.pipValue = record.pipValue;
+    results.hasBreakEvenInfo = record.hasBreakEvenInfo != 0;
+    results.breakEvenPrice = record.breakEvenPrice;
+    results.breakEvenPips = record.breakEvenPips;
+    results.hasMultipleTargets = record.hasMultipleTargets != 0;
+    results.tp1Price = record.tp1Price;
+    results.tp2Price = record.tp2Price;
+    results.tp1Amount = record.tp1Amount;
+    results.tp2Amount = record.tp2Amount;
+    
+    trade->m_tp1Percentage = record.tp1Percentage;
+    trade->m_tp2Percentage = record.tp2Percentage;
+    trade->m_outcome = static_cast<TradeOutcome>(record.outcome);
+    trade->m_profitLoss = trade->profitLossFor(trade->m_outcome);
+    trade->m_slInputType = static_cast<InputType>(record.slInputType);
+    trade->m_tpInputType = static_cast<InputType>(record.tpInputType);
+    return trade;
+}
+
+void Trade::generateId() {
+    std::string previousId = std::move(m_id);
+    m_id = Utils::makeId("TRADE");
+    for (const auto& handler : m_idChangedHandlers) {
+        handler.second(*this, previousId);
+    }
+}
+
+void Trade::addIdChangedHandler(const void* owner, IdChangedHandler handler) {
+    removeIdChangedHandler(owner);
+    m_idChangedHandlers.emplace_back(owner, std::move(handler));
+}
+
+void Trade::removeIdChangedHandler(const void* owner) {
+    m_idChangedHandlers.erase(
+        std::remove_if(m_idChangedHandlers.begin(), m_idChangedHandlers.end(),
+            [owner](const auto& handler) { return handler.first == owner; }),
+        m_idChangedHandlers.end());
 }
 
 double Trade::convertPriceToPoints(double entryPrice, double targetPrice) const {
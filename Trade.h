@@ -4,11 +4,14 @@
 #include <string>
 #include <vector>
 #include <ctime>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 // Forward declarations
-class TradeCalculator;
 struct TradeParameters;
 struct TradeResults;
 
@@ -25,6 +28,54 @@ enum class InputType {
     Price
 };
 
+// Fixed-layout copy of a trade for binary persistence (see SessionWal)
+struct TradeRecord {
+    char id[48];                  // NUL-terminated
+    std::int64_t timestamp;
+    
+    // TradeParameters
+    double accountBalance;
+    double riskPercent;
+    double stopLossInPips;
+    double takeProfitInPips;
+    double targetRiskRewardRatio;
+    double entryPrice;
+    double stopLossPrice;
+    double parameterTakeProfitPrice;
+    double contractSize;
+    std::int64_t parameterTimestamp;
+    
+    // TradeResults
+    double riskAmount;
+    double rewardAmount;
+    double positionSize;
+    double resultStopLossPrice;
+    double takeProfitPrice;
+    double riskRewardRatio;
+    double pipValue;
+    double breakEvenPrice;
+    double breakEvenPips;
+    double tp1Price;
+    double tp2Price;
+    double tp1Amount;
+    double tp2Amount;
+    
+    double tp1Percentage;
+    double tp2Percentage;
+    
+    std::uint8_t instrumentType;
+    std::uint8_t lotSizeType;
+    std::uint8_t outcome;
+    std::uint8_t slInputType;
+    std::uint8_t tpInputType;
+    std::uint8_t isStopLossPriceOverride;
+    std::uint8_t hasBreakEvenInfo;
+    std::uint8_t hasMultipleTargets;
+};
+
+static_assert(std::is_trivially_copyable<TradeRecord>::value, "TradeRecord is written with memcpy");
+static_assert(sizeof(TradeRecord) == 264, "TradeRecord layout is part of the WAL format");
+
 class TradeError : public std::runtime_error {
 public:
     explicit TradeError(const std::string& message) : std::runtime_error(message) {}
@@ -61,6 +112,7 @@ public:
     // Access methods
     TradeParameters getParameters() const;
     TradeResults getResults() const;
+    const TradeResults& getResultsRef() const;  // No copy; valid while the trade lives
     TradeOutcome getOutcome() const;
     std::string getOutcomeAsString() const;
     
@@ -75,25 +127,39 @@ public:
     void setTimestamp(std::time_t timestamp);
     std::string getId() const;
     
+    // Called after reset() gives the trade a new ID, with the old one. Each
+    // SessionManager holding the trade registers one under its own address
+    // to keep its ID index current; adding again for an owner replaces it.
+    using IdChangedHandler = std::function<void(const Trade& trade, const std::string& previousId)>;
+    void addIdChangedHandler(const void* owner, IdChangedHandler handler);
+    void removeIdChangedHandler(const void* owner);
+    
+    // Binary persistence
+    TradeRecord toRecord() const;
+    static std::shared_ptr<Trade> fromRecord(const TradeRecord& record);
+    
 private:
     std::string m_id;
     std::time_t m_timestamp;
-    std::unique_ptr<TradeCalculator> m_calculator;
     std::unique_ptr<TradeParameters> m_params;
     std::unique_ptr<TradeResults> m_results;
     TradeOutcome m_outcome;
+    double m_profitLoss = 0.0;  // Of m_outcome; accountBalance stays the opening balance
     
     // Multiple targets
-    double m_tp1Percentage;
-    double m_tp2Percentage;
+    double m_tp1Percentage = 60.0;
+    double m_tp2Percentage = 40.0;
     
     // Input types tracking
-    InputType m_slInputType;
-    InputType m_tpInputType;
+    InputType m_slInputType = InputType::Pips;
+    InputType m_tpInputType = InputType::Pips;
+    
+    std::vector<std::pair<const void*, IdChangedHandler>> m_idChangedHandlers;
     
     // Helper methods
     double convertPriceToPoints(double entryPrice, double targetPrice) const;
     double convertPipsToPrice(double entryPrice, double pips) const;
+    double profitLossFor(TradeOutcome outcome) const;
     void generateId();
     
     // Validation methods
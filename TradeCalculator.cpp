@@ -1,8 +1,105 @@
 #include "TradeCalculator.h"
+#include "Utils/CpuFeatures.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <stdexcept>
-#include <mutex>
+
+namespace {
+    constexpr int INSTRUMENT_TYPE_COUNT = 3;
+    constexpr int LOT_SIZE_TYPE_COUNT = 3;
+    
+    // Units per lot, indexed by LotSizeType
+    constexpr double LOT_SIZES[LOT_SIZE_TYPE_COUNT] = {100000.0, 10000.0, 1000.0};
+    
+    // Price of one pip, indexed by InstrumentType
+    constexpr double INSTRUMENT_PIP_SIZES[INSTRUMENT_TYPE_COUNT] = {0.0001, 0.01, 1.0};
+    
+    struct PipValueTable {
+        double values[INSTRUMENT_TYPE_COUNT][LOT_SIZE_TYPE_COUNT] = {};
+    };
+    
+    constexpr PipValueTable makePipValueTable() {
+        PipValueTable table;
+        for (int instrument = 0; instrument < INSTRUMENT_TYPE_COUNT; ++instrument) {
+            for (int lot = 0; lot < LOT_SIZE_TYPE_COUNT; ++lot) {
+                table.values[instrument][lot] = INSTRUMENT_PIP_SIZES[instrument] * LOT_SIZES[lot];
+            }
+        }
+        return table;
+    }
+    
+    // Every built-in instrument/lot combination, computed at compile time
+    constexpr PipValueTable PIP_VALUES = makePipValueTable();
+    
+    static_assert(PIP_VALUES.values[static_cast<int>(InstrumentType::Forex)][static_cast<int>(LotSizeType::Standard)] == 10.0,
+                  "Forex standard lot pip value");
+    static_assert(PIP_VALUES.values[static_cast<int>(InstrumentType::Gold)][static_cast<int>(LotSizeType::Micro)] == 10.0,
+                  "Gold micro lot pip value");
+    
+    static_assert(sizeof(BatchStatus) == sizeof(std::uint8_t), "BatchStatus is stored as bytes");
+    
+    // Values shared by every row of a batch
+    struct BatchConstants {
+        double pipValue = 0.0;
+        double riskAmountInCurrency = 0.0;
+        double feePercentage = 0.0;  // 0 when fees are off
+        double spreadAmount = 0.0;   // 0 when the spread is off
+    };
+    
+    // Size every row and return how many were rejected. The body has no
+    // branches (quiet ==/!= comparisons, non-short-circuit logic, unconditional
+    // stores) so the compiler vectorizes it; the arithmetic and its order follow
+    // calculateTrade, so accepted rows match it exactly.
+    inline std::size_t sizeRows(const double* __restrict entryPrices,
+                                const double* __restrict stopLossPrices,
+                                const double* __restrict takeProfitPrices, std::size_t count,
+                                const BatchConstants& constants,
+                                double* __restrict riskOut, double* __restrict rewardOut,
+                                double* __restrict sizeOut, double* __restrict ratioOut,
+                                std::uint8_t* __restrict statusOut) {
+        std::size_t rejected = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const double entry = entryPrices[i];
+            const double stopLoss = stopLossPrices[i];
+            const double takeProfit = takeProfitPrices[i];
+            
+            double risk = std::abs(entry - stopLoss) * constants.pipValue;
+            double reward = std::abs(takeProfit - entry) * constants.pipValue;
+            double size = constants.riskAmountInCurrency / risk;
+            
+            riskOut[i] = risk + size * constants.feePercentage / 100.0 + constants.spreadAmount;
+            rewardOut[i] = reward - size * constants.feePercentage / 100.0 - constants.spreadAmount;
+            sizeOut[i] = size;
+            ratioOut[i] = reward / risk;
+            
+            // x - x is 0 for finite x and NaN otherwise
+            bool finite = ((entry - entry) == 0.0) & ((stopLoss - stopLoss) == 0.0) &
+                          ((takeProfit - takeProfit) == 0.0);
+            bool hasRisk = entry != stopLoss;
+            std::uint8_t status = static_cast<std::uint8_t>(
+                static_cast<std::uint8_t>(!finite) * static_cast<std::uint8_t>(BatchStatus::NonFiniteInput) +
+                static_cast<std::uint8_t>(finite & !hasRisk) * static_cast<std::uint8_t>(BatchStatus::ZeroRisk));
+            statusOut[i] = status;
+            rejected += (status != 0);
+        }
+        return rejected;
+    }
+    
+    // Same loop compiled for AVX2; baseline x86-64 cannot vectorize it because
+    // the byte-sized status lanes do not fit two-lane double vectors
+#if UTILS_HAS_X86_SIMD
+    UTILS_TARGET_AVX2
+#endif
+    std::size_t sizeRowsAvx2(const double* entryPrices, const double* stopLossPrices,
+                             const double* takeProfitPrices, std::size_t count,
+                             const BatchConstants& constants,
+                             double* riskOut, double* rewardOut, double* sizeOut,
+                             double* ratioOut, std::uint8_t* statusOut) {
+        return sizeRows(entryPrices, stopLossPrices, takeProfitPrices, count, constants,
+                        riskOut, rewardOut, sizeOut, ratioOut, statusOut);
+    }
+}
 
 TradeCalculator::TradeCalculator() {
     // Constructor
@@ -10,12 +107,6 @@ TradeCalculator::TradeCalculator() {
 
 TradeCalculator::~TradeCalculator() {
     // Destructor
-    clearCache();
-}
-
-void TradeCalculator::clearCache() {
-    std::lock_guard<std::mutex> lock(m_cacheMutex);
-    m_pipValueCache.clear();
 }
 
 void TradeCalculator::setFeePercentage(double feePercent) {
@@ -32,7 +123,7 @@ void TradeCalculator::setFixedSpreadPips(double spreadPips) {
     m_spreadPips = spreadPips;
 }
 
-TradeResults TradeCalculator::calculateTrade(const TradeParameters& params) {
+TradeResults TradeCalculator::calculateTrade(const TradeParameters& params) const {
     TradeResults results;
     
     try {
@@ -90,7 +181,7 @@ TradeResults TradeCalculator::calculateTrade(const TradeParameters& params) {
 }
 
 TradeResults TradeCalculator::calculateMultipleTargets(const TradeParameters& params, 
-                                                      double tp1Percent, double tp2Percent) {
+                                                      double tp1Percent, double tp2Percent) const {
     TradeResults results = calculateTrade(params);
     results.hasMultipleTargets = true;
     
@@ -115,75 +206,83 @@ TradeResults TradeCalculator::calculateMultipleTargets(const TradeParameters& pa
     return results;
 }
 
-double TradeCalculator::calculatePipValue(const TradeParameters& params) {
-    CacheKey key{params.instrumentType, params.lotSizeType, params.contractSize};
+void TradeCalculator::calculateBatch(const TradeParameters& common,
+                                     const double* entryPrices, const double* stopLossPrices,
+                                     const double* takeProfitPrices, std::size_t count,
+                                     BatchResults& results) const {
+    results.riskAmount.resize(count);
+    results.rewardAmount.resize(count);
+    results.positionSize.resize(count);
+    results.riskRewardRatio.resize(count);
+    results.status.resize(count);
     
-    {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
-        auto it = m_pipValueCache.find(key);
-        if (it != m_pipValueCache.end()) {
-            return it->second;
-        }
+    int instrument = static_cast<int>(common.instrumentType);
+    int lot = static_cast<int>(common.lotSizeType);
+    if (instrument < 0 || instrument >= INSTRUMENT_TYPE_COUNT || lot < 0 || lot >= LOT_SIZE_TYPE_COUNT) {
+        std::fill(results.riskAmount.begin(), results.riskAmount.end(), 0.0);
+        std::fill(results.rewardAmount.begin(), results.rewardAmount.end(), 0.0);
+        std::fill(results.positionSize.begin(), results.positionSize.end(), 0.0);
+        std::fill(results.riskRewardRatio.begin(), results.riskRewardRatio.end(), 0.0);
+        std::fill(results.status.begin(), results.status.end(), BatchStatus::InvalidParameters);
+        return;
     }
     
-    double pipValue;
-    double lotSize;
-    
-    // Determine lot size
-    switch (params.lotSizeType) {
-        case LotSizeType::Standard:
-            lotSize = 100000.0;
-            break;
-        case LotSizeType::Mini:
-            lotSize = 10000.0;
-            break;
-        case LotSizeType::Micro:
-            lotSize = 1000.0;
-            break;
-        default:
-            throw std::invalid_argument("Invalid lot size type");
-    }
+    // Everything but the prices is shared by the whole batch
+    BatchConstants constants;
+    constants.pipValue = calculatePipValue(common);
+    constants.riskAmountInCurrency = common.accountBalance * (common.riskPercent / 100.0);
+    constants.feePercentage = m_feePercentage > 0.0 ? m_feePercentage : 0.0;
+    constants.spreadAmount = m_spreadPips > 0.0 ? m_spreadPips * constants.pipValue : 0.0;
+    
+    auto sizeBatch = (UTILS_HAS_X86_SIMD && Utils::cpuSupportsAvx2()) ? sizeRowsAvx2 : sizeRows;
+    std::size_t rejected = sizeBatch(entryPrices, stopLossPrices, takeProfitPrices, count, constants,
+                                     results.riskAmount.data(), results.rewardAmount.data(),
+                                     results.positionSize.data(), results.riskRewardRatio.data(),
+                                     reinterpret_cast<std::uint8_t*>(results.status.data()));
     
-    // Calculate pip value based on instrument type
-    switch (params.instrumentType) {
-        case InstrumentType::Forex:
-            pipValue = DEFAULT_PIP_VALUE * lotSize;
-            break;
-        case InstrumentType::Gold:
-            pipValue = GOLD_PIP_VALUE * lotSize;
-            break;
-        case InstrumentType::Indices:
-            pipValue = INDICES_PIP_VALUE * lotSize;
-            break;
-        default:
-            throw std::invalid_argument("Invalid instrument type");
+    // Rare: clear the values of rejected rows
+    if (rejected > 0) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if (results.status[i] != BatchStatus::Ok) {
+                results.riskAmount[i] = 0.0;
+                results.rewardAmount[i] = 0.0;
+                results.positionSize[i] = 0.0;
+                results.riskRewardRatio[i] = 0.0;
+            }
+        }
     }
+}
+
+double TradeCalculator::calculatePipValue(const TradeParameters& params) {
+    int instrument = static_cast<int>(params.instrumentType);
+    int lot = static_cast<int>(params.lotSizeType);
     
-    // Apply custom contract size if specified
-    if (params.contractSize > 0.0) {
-        pipValue *= (params.contractSize / lotSize);
+    if (lot < 0 || lot >= LOT_SIZE_TYPE_COUNT) {
+        throw std::invalid_argument("Invalid lot size type");
+    }
+    if (instrument < 0 || instrument >= INSTRUMENT_TYPE_COUNT) {
+        throw std::invalid_argument("Invalid instrument type");
     }
     
-    // Cache the result
-    {
-        std::lock_guard<std::mutex> lock(m_cacheMutex);
-        m_pipValueCache[key] = pipValue;
+    // A custom contract size replaces the lot size
+    if (params.contractSize > 0.0) {
+        return PIP_VALUES.values[instrument][lot] * (params.contractSize / LOT_SIZES[lot]);
     }
     
-    return pipValue;
+    return PIP_VALUES.values[instrument][lot];
 }
 
-double TradeCalculator::calculateStopLossPrice(const TradeParameters& params) {
+double TradeCalculator::calculateStopLossPrice(const TradeParameters& params) const {
     if (params.isStopLossPriceOverride) {
         return params.stopLossPrice;
     }
     return params.entryPrice - (params.stopLossInPips * DEFAULT_PIP_VALUE);
 }
 
-double TradeCalculator::calculateTakeProfitPrice(const TradeParameters& params) {
+double TradeCalculator::calculateTakeProfitPrice(const TradeParameters& params) const {
     return params.entryPrice + (params.takeProfitInPips * DEFAULT_PIP_VALUE);
 }
 
-double TradeCalculator::calculateBreakEvenPoint(const TradeParameters& params) {
+double TradeCalculator::calculateBreakEvenPoint(const TradeParameters& params) const {
     return params.entryPrice + (params.stopLossInPips * DEFAULT_PIP_VALUE * 0.5);
 } 
\ No newline at end of file
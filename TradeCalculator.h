@@ -3,8 +3,9 @@
 
 #include <string>
 #include <ctime>
-#include <unordered_map>
-#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 // Enums for instrument and lot size types
 enum class InstrumentType {
@@ -28,6 +29,7 @@ struct TradeParameters {
     double riskRewardRatio = 0.0;
     double entryPrice = 0.0;
     double stopLossPrice = 0.0;
+    double takeProfitPrice = 0.0;  // When the take profit was entered as a price
     bool isStopLossPriceOverride = false;
     InstrumentType instrumentType = InstrumentType::Forex;
     LotSizeType lotSizeType = LotSizeType::Standard;
@@ -58,13 +60,35 @@ struct TradeResults {
     double tp2Amount = 0.0;
 };
 
+// Per-row outcome of TradeCalculator::calculateBatch
+enum class BatchStatus : std::uint8_t {
+    Ok = 0,
+    NonFiniteInput,     // Entry, stop loss or take profit is NaN or infinite
+    ZeroRisk,           // Stop loss equals entry, so no position size exists
+    InvalidParameters   // Shared instrument/lot settings are invalid
+};
+
+// Results of TradeCalculator::calculateBatch, one array per field. Rows whose
+// status is not Ok hold zeros.
+struct BatchResults {
+    std::vector<double> riskAmount;
+    std::vector<double> rewardAmount;
+    std::vector<double> positionSize;
+    std::vector<double> riskRewardRatio;
+    std::vector<BatchStatus> status;
+    
+    std::size_t size() const { return status.size(); }
+};
+
+// Holds only the fee/spread settings, so one instance can be shared by any
+// number of trades and threads once configured
 class TradeCalculator {
 public:
     TradeCalculator();
     ~TradeCalculator();
     
     // Main calculation method
-    TradeResults calculateTrade(const TradeParameters& params);
+    TradeResults calculateTrade(const TradeParameters& params) const;
     
     // Set fee/spread information
     void setFeePercentage(double feePercent);
@@ -72,41 +96,28 @@ public:
     
     // Enable multiple targets
     TradeResults calculateMultipleTargets(const TradeParameters& params, 
-                                         double tp1Percent, double tp2Percent);
+                                         double tp1Percent, double tp2Percent) const;
     
-    // Clear cache
-    void clearCache();
+    // Size many orders at once. Account balance, risk, instrument, lot size and
+    // contract size come from common; its price fields are ignored. Row i is
+    // entryPrices[i] with stopLossPrices[i] and takeProfitPrices[i] (prices, not
+    // pips). Per row this matches calculateTrade with a stop loss price override,
+    // but never throws: problems are reported in results.status. results is
+    // resized to count, so reusing it across calls avoids reallocation.
+    void calculateBatch(const TradeParameters& common,
+                        const double* entryPrices, const double* stopLossPrices,
+                        const double* takeProfitPrices, std::size_t count,
+                        BatchResults& results) const;
+    
+    // Pip value for the instrument, lot size and (optional) custom contract size.
+    // Built-in combinations come from a compile-time table.
+    static double calculatePipValue(const TradeParameters& params);
     
 private:
     // Helper methods
-    double calculatePipValue(const TradeParameters& params);
-    double calculateStopLossPrice(const TradeParameters& params);
-    double calculateTakeProfitPrice(const TradeParameters& params);
-    double calculateBreakEvenPoint(const TradeParameters& params);
-    
-    // Caching
-    struct CacheKey {
-        InstrumentType instrumentType;
-        LotSizeType lotSizeType;
-        double contractSize;
-        
-        bool operator==(const CacheKey& other) const {
-            return instrumentType == other.instrumentType &&
-                   lotSizeType == other.lotSizeType &&
-                   contractSize == other.contractSize;
-        }
-    };
-    
-    struct CacheKeyHash {
-        std::size_t operator()(const CacheKey& key) const {
-            return std::hash<int>()(static_cast<int>(key.instrumentType)) ^
-                   (std::hash<int>()(static_cast<int>(key.lotSizeType)) << 1) ^
-                   (std::hash<double>()(key.contractSize) << 2);
-        }
-    };
-    
-    std::unordered_map<CacheKey, double, CacheKeyHash> m_pipValueCache;
-    std::mutex m_cacheMutex;
+    double calculateStopLossPrice(const TradeParameters& params) const;
+    double calculateTakeProfitPrice(const TradeParameters& params) const;
+    double calculateBreakEvenPoint(const TradeParameters& params) const;
     
     // Default fee/spread settings
     double m_feePercentage = 0.0;
@@ -114,8 +125,6 @@ private:
     
     // Constants
     static constexpr double DEFAULT_PIP_VALUE = 0.0001;
-    static constexpr double GOLD_PIP_VALUE = 0.01;
-    static constexpr double INDICES_PIP_VALUE = 1.0;
 };
 
 #endif // TRADE_CALCULATOR_H 
\ No newline at end of file
@@ -1,11 +1,20 @@
 #include "Utils.h"
+#include "Utils/Downsampler.h"
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <iostream>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <functional>
+#include <thread>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
 
 namespace Utils {
 
@@ -266,6 +275,18 @@ std::string replaceExtension(const std::string& filename, const std::string& new
     return filename.substr(0, lastDot) + newExtension;
 }
 
+std::string uniqueTempPath(const std::string& filename) {
+    static std::atomic<unsigned long long> counter{0};
+#ifdef _WIN32
+    long long pid = _getpid();
+#else
+    long long pid = getpid();
+#endif
+    return filename + ".tmp" + std::to_string(pid) + "-" +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + "-" +
+        std::to_string(counter.fetch_add(1, std::memory_order_relaxed));
+}
+
 void clearScreen() {
 #ifdef _WIN32
     system("cls");
@@ -348,15 +369,22 @@ std::string generateASCIIChart(const std::vector<double>& values, int width, int
     ss << std::fixed << std::setprecision(0);
     ss << max_val << " ┐" << std::string(width - ss.str().length(), ' ') << std::endl;
     
+    // One column per value, or each column's range when there are more values than columns
+    ColumnEnvelope columns = columnEnvelope(values, static_cast<size_t>(std::max(width, 0)));
+    auto toRow = [&](double value) {
+        double normalized_value = (value - min_val) / (max_val - min_val);
+        return chart_height - 1 - static_cast<int>(normalized_value * chart_height);
+    };
+    
     // Draw chart
     for (int y = 0; y < chart_height; y++) {
-        for (int x = 0; x < std::min(width, static_cast<int>(values.size())); x++) {
-            double normalized_value = (values[x] - min_val) / (max_val - min_val);
-            int chart_y = chart_height - 1 - static_cast<int>(normalized_value * chart_height);
+        for (int x = 0; x < static_cast<int>(columns.high.size()); x++) {
+            int top_y = toRow(columns.high[x]);
+            int bottom_y = toRow(columns.low[x]);
             
-            if (chart_y == y) {
+            if (y >= top_y && y <= bottom_y) {
                 chart[y][x] = 'o';
-            } else if (chart_y < y) {
+            } else if (bottom_y < y) {
                 chart[y][x] = '│';
             }
         }
@@ -27,6 +27,9 @@ namespace Utils {
     std::vector<std::string> parseCSVLine(const std::string& line);
     std::vector<std::vector<std::string>> parseCSV(const std::string& filename);
     std::string replaceExtension(const std::string& filename, const std::string& newExtension);
+    // Name for a temporary file next to filename that no other process or
+    // thread writing the same file will use
+    std::string uniqueTempPath(const std::string& filename);
     
     // Console UI utilities
     void clearScreen();
@@ -0,0 +1,40 @@
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && UTILS_HAS_X86_SIMD
+#include <intrin.h>
+#endif
+
+namespace Utils {
+    namespace {
+        bool detectAvx2() {
+#if UTILS_HAS_X86_SIMD && (defined(__GNUC__) || defined(__clang__))
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#elif UTILS_HAS_X86_SIMD && defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+
+            // OSXSAVE and AVX, then check the OS saves YMM state
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return false;
+#endif
+        }
+    }
+
+    bool cpuSupportsAvx2() {
+        static const bool supported = detectAvx2();
+        return supported;
+    }
+}
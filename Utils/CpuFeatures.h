@@ -0,0 +1,27 @@
+#ifndef UTILS_CPU_FEATURES_H
+#define UTILS_CPU_FEATURES_H
+
+// x86 SIMD kernels are compiled for AVX2 per function and selected at runtime,
+// so the rest of the build keeps the baseline instruction set.
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define UTILS_HAS_X86_SIMD 1
+#include <immintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define UTILS_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define UTILS_TARGET_AVX2
+#endif
+#else
+#define UTILS_HAS_X86_SIMD 0
+#define UTILS_TARGET_AVX2
+#endif
+
+namespace Utils {
+    /**
+     * Check whether the running CPU and OS support AVX2
+     * @return True if AVX2 kernels may be executed
+     */
+    bool cpuSupportsAvx2();
+}
+
+#endif // UTILS_CPU_FEATURES_H
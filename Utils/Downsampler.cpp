@@ -0,0 +1,134 @@
+#include "Downsampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Utils {
+    namespace {
+        CurvePoints allPoints(const std::vector<double>& values) {
+            CurvePoints points;
+            points.x.resize(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i) {
+                points.x[i] = static_cast<double>(i);
+            }
+            points.y = values;
+            return points;
+        }
+
+        void addPoint(CurvePoints& points, std::size_t index, double value) {
+            points.x.push_back(static_cast<double>(index));
+            points.y.push_back(value);
+        }
+
+        // Bucket b of count values split into buckets parts: [begin, end)
+        std::size_t bucketStart(std::size_t b, std::size_t count, std::size_t buckets) {
+            return b * count / buckets;
+        }
+    }
+
+    CurvePoints downsampleLTTB(const std::vector<double>& values, std::size_t threshold) {
+        std::size_t count = values.size();
+        if (threshold < 3 || count <= threshold) {
+            return allPoints(values);
+        }
+
+        CurvePoints points;
+        points.x.reserve(threshold);
+        points.y.reserve(threshold);
+
+        // First and last points are always kept; the rest fill threshold - 2 buckets
+        std::size_t buckets = threshold - 2;
+        std::size_t inner = count - 2;
+        std::size_t selected = 0;
+        addPoint(points, 0, values[0]);
+
+        for (std::size_t b = 0; b < buckets; ++b) {
+            std::size_t begin = 1 + bucketStart(b, inner, buckets);
+            std::size_t end = 1 + bucketStart(b + 1, inner, buckets);
+
+            // Average of the next bucket (or the last point) is the third vertex
+            std::size_t nextBegin = end;
+            std::size_t nextEnd = (b + 1 < buckets) ? 1 + bucketStart(b + 2, inner, buckets) : count;
+            double avgX = 0.0;
+            double avgY = 0.0;
+            for (std::size_t i = nextBegin; i < nextEnd; ++i) {
+                avgX += static_cast<double>(i);
+                avgY += values[i];
+            }
+            double nextCount = static_cast<double>(nextEnd - nextBegin);
+            avgX /= nextCount;
+            avgY /= nextCount;
+
+            double ax = static_cast<double>(selected);
+            double ay = values[selected];
+            double bestArea = -1.0;
+            std::size_t best = begin;
+            for (std::size_t i = begin; i < end; ++i) {
+                // Twice the triangle area; the factor does not change the ranking
+                double area = std::fabs((ax - avgX) * (values[i] - ay) -
+                                        (ax - static_cast<double>(i)) * (avgY - ay));
+                if (area > bestArea) {
+                    bestArea = area;
+                    best = i;
+                }
+            }
+
+            addPoint(points, best, values[best]);
+            selected = best;
+        }
+
+        addPoint(points, count - 1, values[count - 1]);
+        return points;
+    }
+
+    CurvePoints downsampleMinMax(const std::vector<double>& values, std::size_t buckets) {
+        std::size_t count = values.size();
+        if (buckets == 0 || count <= 2 * buckets) {
+            return allPoints(values);
+        }
+
+        CurvePoints points;
+        points.x.reserve(2 * buckets);
+        points.y.reserve(2 * buckets);
+
+        for (std::size_t b = 0; b < buckets; ++b) {
+            std::size_t begin = bucketStart(b, count, buckets);
+            std::size_t end = bucketStart(b + 1, count, buckets);
+            auto range = std::minmax_element(values.begin() + begin, values.begin() + end);
+            std::size_t low = static_cast<std::size_t>(range.first - values.begin());
+            std::size_t high = static_cast<std::size_t>(range.second - values.begin());
+
+            std::size_t first = std::min(low, high);
+            std::size_t second = std::max(low, high);
+            addPoint(points, first, values[first]);
+            if (second != first) {
+                addPoint(points, second, values[second]);
+            }
+        }
+        return points;
+    }
+
+    ColumnEnvelope columnEnvelope(const std::vector<double>& values, std::size_t columns) {
+        ColumnEnvelope envelope;
+        std::size_t count = values.size();
+        if (count == 0 || columns == 0) {
+            return envelope;
+        }
+
+        if (count <= columns) {
+            envelope.low = values;
+            envelope.high = values;
+            return envelope;
+        }
+
+        envelope.low.resize(columns);
+        envelope.high.resize(columns);
+        for (std::size_t c = 0; c < columns; ++c) {
+            std::size_t begin = bucketStart(c, count, columns);
+            std::size_t end = bucketStart(c + 1, count, columns);
+            auto range = std::minmax_element(values.begin() + begin, values.begin() + end);
+            envelope.low[c] = *range.first;
+            envelope.high[c] = *range.second;
+        }
+        return envelope;
+    }
+}
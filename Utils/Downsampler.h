@@ -0,0 +1,54 @@
+#ifndef UTILS_DOWNSAMPLER_H
+#define UTILS_DOWNSAMPLER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Utils {
+    /**
+     * Points kept from a curve; x holds the original index of each point
+     */
+    struct CurvePoints {
+        std::vector<double> x;
+        std::vector<double> y;
+    };
+
+    /**
+     * Low/high value per output column
+     */
+    struct ColumnEnvelope {
+        std::vector<double> low;
+        std::vector<double> high;
+    };
+
+    /**
+     * Largest-Triangle-Three-Buckets: keep the first and last point and, per
+     * bucket in between, the point forming the largest triangle with its
+     * neighbours. Peaks and troughs form large triangles, so the shape of the
+     * curve survives. Curves no longer than threshold are returned whole.
+     * @param values Curve to reduce
+     * @param threshold Number of points to keep (e.g. chart width in pixels, >= 3)
+     * @return Kept points in index order
+     */
+    CurvePoints downsampleLTTB(const std::vector<double>& values, std::size_t threshold);
+
+    /**
+     * Keep the minimum and maximum of each bucket, in index order, so every
+     * peak and trough is still visible at bucket resolution.
+     * @param values Curve to reduce
+     * @param buckets Number of buckets; at most 2 * buckets points are kept
+     * @return Kept points in index order
+     */
+    CurvePoints downsampleMinMax(const std::vector<double>& values, std::size_t buckets);
+
+    /**
+     * Split the curve into columns and report each column's range. With no
+     * more values than columns, each value gets its own column.
+     * @param values Curve to reduce
+     * @param columns Maximum number of columns
+     * @return One low/high pair per column
+     */
+    ColumnEnvelope columnEnvelope(const std::vector<double>& values, std::size_t columns);
+}
+
+#endif // UTILS_DOWNSAMPLER_H
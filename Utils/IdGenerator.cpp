@@ -0,0 +1,44 @@
+#include "IdGenerator.h"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+
+namespace Utils {
+    namespace {
+        std::uint64_t processEpoch() {
+            static const std::uint64_t epoch = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count());
+            return epoch;
+        }
+
+        std::atomic<std::uint32_t> g_nextThread{0};
+
+        struct ThreadIdState {
+            std::uint32_t thread = g_nextThread.fetch_add(1, std::memory_order_relaxed);
+            std::uint64_t sequence = 0;
+        };
+
+        thread_local ThreadIdState t_state;
+
+        char* appendHex(char* first, char* last, std::uint64_t value) {
+            *first++ = '_';
+            return std::to_chars(first, last, value, 16).ptr;
+        }
+    }
+
+    std::string makeId(const std::string& prefix) {
+        char suffix[kMaxIdSuffixLength];
+        char* end = suffix + sizeof(suffix);
+
+        char* pos = appendHex(suffix, end, processEpoch());
+        pos = appendHex(pos, end, t_state.thread);
+        pos = appendHex(pos, end, t_state.sequence++);
+
+        std::string id;
+        id.reserve(prefix.size() + static_cast<std::size_t>(pos - suffix));
+        id.append(prefix).append(suffix, pos);
+        return id;
+    }
+}
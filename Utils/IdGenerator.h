@@ -0,0 +1,30 @@
+#ifndef UTILS_ID_GENERATOR_H
+#define UTILS_ID_GENERATOR_H
+
+#include <cstddef>
+#include <string>
+
+namespace Utils {
+    /**
+     * Longest ID makeId() can produce, not counting the prefix
+     */
+    constexpr std::size_t kMaxIdSuffixLength = 1 + 16 + 1 + 8 + 1 + 16;
+
+    /**
+     * Build an ID of the form <prefix>_<epoch>_<thread>_<sequence>, all
+     * fields in lower-case hex:
+     *   epoch    - microseconds since 1970 when the process made its first ID
+     *   thread   - number given to each thread when it makes its first ID
+     *   sequence - per-thread counter, starting at 0
+     *
+     * Every thread owns its (thread, sequence) pair, so IDs are unique within
+     * the process with no locking, and the epoch keeps them apart from IDs of
+     * earlier runs. Nothing after the first call needs a system call or a
+     * stream.
+     * @param prefix Leading text, e.g. "TRADE"
+     * @return The new ID
+     */
+    std::string makeId(const std::string& prefix);
+}
+
+#endif // UTILS_ID_GENERATOR_H
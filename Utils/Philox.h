@@ -0,0 +1,92 @@
+#ifndef UTILS_PHILOX_H
+#define UTILS_PHILOX_H
+
+#include <array>
+#include <cstdint>
+
+namespace Utils {
+    /**
+     * Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+     * Numbers: As Easy as 1, 2, 3"). Each (key, counter) pair maps to four
+     * independent 32-bit words, so any stream can be started at any position
+     * without generating what comes before it.
+     */
+    class Philox4x32 {
+    public:
+        using Counter = std::array<std::uint32_t, 4>;
+        using Key = std::array<std::uint32_t, 2>;
+
+        static Counter generate(Counter counter, Key key) {
+            for (int round = 0; round < 10; ++round) {
+                if (round > 0) {
+                    key[0] += 0x9E3779B9u;
+                    key[1] += 0xBB67AE85u;
+                }
+                counter = mixRound(counter, key);
+            }
+            return counter;
+        }
+
+    private:
+        static Counter mixRound(const Counter& counter, const Key& key) {
+            std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53u) * counter[0];
+            std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57u) * counter[2];
+            auto hi0 = static_cast<std::uint32_t>(product0 >> 32);
+            auto lo0 = static_cast<std::uint32_t>(product0);
+            auto hi1 = static_cast<std::uint32_t>(product1 >> 32);
+            auto lo1 = static_cast<std::uint32_t>(product1);
+            return {hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0};
+        }
+    };
+
+    /**
+     * Sequential draws from one Philox stream. The seed is the key and the
+     * stream number fills the upper counter words, so stream s of seed k
+     * yields the same numbers no matter which thread reads it or when. Giving
+     * each work item its own stream (e.g. the path or sample index) makes a
+     * seeded run reproduce exactly on any thread count.
+     */
+    class PhiloxStream {
+    public:
+        PhiloxStream(std::uint64_t seed, std::uint64_t stream)
+            : m_key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+              m_stream(stream) {}
+
+        /**
+         * @return Next 32 random bits
+         */
+        std::uint32_t nextUInt32() {
+            if (m_used == 4) {
+                refill();
+            }
+            return m_block[m_used++];
+        }
+
+        /**
+         * @return Uniform double in [0, 1) with 53 random bits
+         */
+        double nextUniform() {
+            std::uint64_t high = nextUInt32() >> 5;  // 27 bits
+            std::uint64_t low = nextUInt32() >> 6;   // 26 bits
+            return static_cast<double>((high << 26) | low) * (1.0 / 9007199254740992.0);
+        }
+
+    private:
+        void refill() {
+            Philox4x32::Counter counter = {
+                static_cast<std::uint32_t>(m_blockIndex), static_cast<std::uint32_t>(m_blockIndex >> 32),
+                static_cast<std::uint32_t>(m_stream), static_cast<std::uint32_t>(m_stream >> 32)};
+            m_block = Philox4x32::generate(counter, m_key);
+            ++m_blockIndex;
+            m_used = 0;
+        }
+
+        Philox4x32::Key m_key;
+        std::uint64_t m_stream;
+        std::uint64_t m_blockIndex = 0;
+        Philox4x32::Counter m_block{};
+        int m_used = 4;
+    };
+}
+
+#endif // UTILS_PHILOX_H
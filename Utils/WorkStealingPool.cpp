@@ -0,0 +1,245 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace Utils {
+    namespace {
+        // Identifies the pool and worker the current thread belongs to
+        thread_local const WorkStealingPool* t_pool = nullptr;
+        thread_local unsigned int t_workerIndex = 0;
+    }
+
+    WorkStealingPool::WorkStealingPool(unsigned int threadCount, std::size_t queueCapacity)
+        : m_queueCapacity(queueCapacity) {
+        if (threadCount == 0) {
+            threadCount = std::thread::hardware_concurrency();
+            if (threadCount == 0) threadCount = 4; // Fallback if hardware_concurrency fails
+        }
+
+        m_queues.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i) {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        m_threads.reserve(threadCount);
+        for (unsigned int i = 0; i < threadCount; ++i) {
+            m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+        }
+    }
+
+    WorkStealingPool::~WorkStealingPool() {
+        {
+            std::unique_lock<std::mutex> lock(m_stateMutex);
+            m_idle.wait(lock, [this] { return m_unfinished == 0; });
+            m_stopping = true;
+        }
+        m_workAvailable.notify_all();
+
+        for (auto& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void WorkStealingPool::submit(Task task) {
+        bool fromWorker = (t_pool == this);
+        WorkerQueue& target = fromWorker ? *m_queues[t_workerIndex] : m_submitted;
+
+        {
+            // Reserve queue space first so a blocked submitter holds no deque lock
+            std::unique_lock<std::mutex> lock(m_stateMutex);
+            if (!fromWorker) {
+                m_spaceAvailable.wait(lock, [this] {
+                    return m_queueCapacity == 0 || m_queued < m_queueCapacity;
+                });
+            }
+            ++m_queued;
+            ++m_unfinished;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(target.mutex);
+            target.tasks.push_back(std::move(task));
+        }
+
+        // Notify under the state lock so a worker checking for work cannot miss it
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_workAvailable.notify_one();
+    }
+
+    void WorkStealingPool::waitIdle() {
+        if (t_pool == this) {
+            throw std::logic_error("WorkStealingPool::waitIdle called from one of its own workers");
+        }
+
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        m_idle.wait(lock, [this] { return m_unfinished == 0; });
+
+        if (m_firstError) {
+            std::exception_ptr error = m_firstError;
+            m_firstError = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+    void WorkStealingPool::setQueueCapacity(std::size_t queueCapacity) {
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_queueCapacity = queueCapacity;
+        }
+        m_spaceAvailable.notify_all();
+    }
+
+    bool WorkStealingPool::tryTake(unsigned int index, Task& task) {
+        // Newest task of our own first: it is the one most likely still in cache
+        {
+            WorkerQueue& own = *m_queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        // Then outside submissions in order, then the oldest task of another worker
+        std::size_t count = m_queues.size();
+        for (std::size_t offset = 0; offset < count; ++offset) {
+            WorkerQueue& queue = offset == 0 ? m_submitted : *m_queues[(index + offset) % count];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WorkStealingPool::runTask(Task& task) {
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            --m_queued;
+        }
+        m_spaceAvailable.notify_one();
+
+        std::exception_ptr error;
+        try {
+            task();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        task = nullptr;
+
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        if (error && !m_firstError) {
+            m_firstError = error;
+        }
+        if (--m_unfinished == 0) {
+            m_idle.notify_all();
+        }
+    }
+
+    void WorkStealingPool::workerLoop(unsigned int index) {
+        t_pool = this;
+        t_workerIndex = index;
+
+        Task task;
+        while (true) {
+            if (tryTake(index, task)) {
+                runTask(task);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_stateMutex);
+            if (m_queued > 0) {
+                continue; // A task was pushed after our scan; look again
+            }
+            if (m_stopping) {
+                return;
+            }
+            m_workAvailable.wait(lock, [this] { return m_queued > 0 || m_stopping; });
+        }
+    }
+
+    void WorkStealingPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body,
+                                       std::size_t grainSize) {
+        if (count == 0) {
+            return;
+        }
+        grainSize = std::max<std::size_t>(grainSize, 1);
+
+        struct SharedState {
+            std::atomic<std::size_t> next{0};
+            std::mutex mutex;
+            std::condition_variable done;
+            std::size_t activeHelpers = 0;
+            std::exception_ptr error;
+        };
+        auto state = std::make_shared<SharedState>();
+
+        auto drain = [state, count, grainSize, &body]() {
+            while (true) {
+                std::size_t begin = state->next.fetch_add(grainSize, std::memory_order_relaxed);
+                if (begin >= count) {
+                    return;
+                }
+                std::size_t end = std::min(begin + grainSize, count);
+                try {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        body(i);
+                    }
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->error) {
+                        state->error = std::current_exception();
+                    }
+                    state->next.store(count, std::memory_order_relaxed); // Stop handing out work
+                    return;
+                }
+            }
+        };
+
+        // One helper per other worker; each claims chunks until none are left
+        std::size_t chunks = (count + grainSize - 1) / grainSize;
+        std::size_t helpers = std::min<std::size_t>(size(), chunks) - (t_pool == this ? 1 : 0);
+        if (chunks > 1 && helpers > 0) {
+            state->activeHelpers = helpers;
+            for (std::size_t h = 0; h < helpers; ++h) {
+                submit([state, drain]() {
+                    drain();
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (--state->activeHelpers == 0) {
+                        state->done.notify_all();
+                    }
+                });
+            }
+        }
+
+        drain();
+
+        // Helpers that have not started yet find no work left and finish at once.
+        // A worker keeps running queued tasks while it waits, so nested calls
+        // cannot leave every worker blocked on helpers nobody is free to run.
+        std::unique_lock<std::mutex> lock(state->mutex);
+        while (state->activeHelpers > 0) {
+            if (t_pool != this) {
+                state->done.wait(lock);
+                continue;
+            }
+
+            lock.unlock();
+            Task task;
+            if (tryTake(t_workerIndex, task)) {
+                runTask(task);
+                lock.lock();
+            } else {
+                lock.lock();
+                state->done.wait_for(lock, std::chrono::milliseconds(1));
+            }
+        }
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+}
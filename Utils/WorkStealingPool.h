@@ -0,0 +1,162 @@
+#ifndef UTILS_WORK_STEALING_POOL_H
+#define UTILS_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils {
+    /**
+     * Persistent thread pool with one task deque per worker.
+     *
+     * Tasks submitted from inside a task go to the back of the submitting
+     * worker's deque, and the owner takes its newest task first. Idle workers
+     * steal the oldest task from the front of another worker's deque.
+     * External submissions go to a shared queue that is served oldest first,
+     * so they start in submission order (callers that sort work
+     * longest-first rely on this).
+     */
+    class WorkStealingPool {
+    public:
+        using Task = std::function<void()>;
+
+        /**
+         * Start the worker threads
+         * @param threadCount Number of workers (0 = hardware concurrency)
+         * @param queueCapacity Maximum number of queued, not yet started tasks
+         *        before submit() blocks (0 = unbounded)
+         */
+        explicit WorkStealingPool(unsigned int threadCount = 0, std::size_t queueCapacity = 0);
+
+        /**
+         * Finish all queued tasks and join the workers
+         */
+        ~WorkStealingPool();
+
+        WorkStealingPool(const WorkStealingPool&) = delete;
+        WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+        /**
+         * Queue a task. Blocks while the queue is at capacity, unless called
+         * from one of the pool's own workers.
+         * @param task The task to run
+         */
+        void submit(Task task);
+
+        /**
+         * Block until every submitted task has finished. Must not be called
+         * from one of the pool's workers: the calling task itself would never
+         * finish. Use parallelFor for nested work instead.
+         * @throws std::logic_error If called from one of the pool's workers
+         * @throws The first exception that escaped a task since the last call
+         */
+        void waitIdle();
+
+        /**
+         * Run body(i) for every i in [0, count) on the pool. The calling thread
+         * takes part, so this may also be used from inside a task. Indices run
+         * in no fixed order: have body(i) write to slot i and combine the
+         * slots in index order afterwards, so floating-point sums do not
+         * depend on scheduling.
+         * @param count Number of iterations
+         * @param body Function called once per index
+         * @param grainSize Indices claimed at a time
+         * @throws The first exception thrown by body
+         */
+        void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body,
+                         std::size_t grainSize = 1);
+
+        /**
+         * Change the submit() bound for future submissions
+         * @param queueCapacity Maximum number of queued tasks (0 = unbounded)
+         */
+        void setQueueCapacity(std::size_t queueCapacity);
+
+        /**
+         * @return Number of worker threads
+         */
+        unsigned int size() const { return static_cast<unsigned int>(m_threads.size()); }
+
+    private:
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void workerLoop(unsigned int index);
+        bool tryTake(unsigned int index, Task& task);
+        void runTask(Task& task);
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;  // One per worker
+        WorkerQueue m_submitted;                            // Submissions from outside the pool
+        std::vector<std::thread> m_threads;
+
+        std::mutex m_stateMutex;
+        std::condition_variable m_workAvailable;
+        std::condition_variable m_spaceAvailable;
+        std::condition_variable m_idle;
+
+        std::size_t m_queued = 0;      // Submitted, not yet started (guarded by m_stateMutex)
+        std::size_t m_unfinished = 0;  // Submitted, not yet finished (guarded by m_stateMutex)
+        std::size_t m_queueCapacity = 0;
+        bool m_stopping = false;
+        std::exception_ptr m_firstError;
+    };
+
+    /**
+     * Fixed-size, lock-free hand-off of results from pool tasks to a consumer.
+     * Each producer owns one slot (usually the task's index), so publishing
+     * never contends; the consumer reads slots in index order, which keeps
+     * merged results deterministic regardless of completion order.
+     */
+    template<typename T>
+    class CompletionChannel {
+    public:
+        explicit CompletionChannel(std::size_t slots)
+            : m_values(slots), m_ready(new std::atomic<bool>[slots]), m_slots(slots) {
+            for (std::size_t i = 0; i < slots; ++i) {
+                m_ready[i].store(false, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Store the result for a slot. Each slot may be published once.
+         * @return Number of slots published so far, including this one
+         */
+        std::size_t publish(std::size_t slot, T value) {
+            m_values[slot] = std::move(value);
+            m_ready[slot].store(true, std::memory_order_release);
+            return m_published.fetch_add(1, std::memory_order_acq_rel) + 1;
+        }
+
+        /**
+         * @return True if the slot has been published
+         */
+        bool ready(std::size_t slot) const {
+            return m_ready[slot].load(std::memory_order_acquire);
+        }
+
+        /**
+         * Access a published slot (check ready() first)
+         */
+        T& get(std::size_t slot) { return m_values[slot]; }
+
+        std::size_t published() const { return m_published.load(std::memory_order_acquire); }
+        std::size_t slots() const { return m_slots; }
+
+    private:
+        std::vector<T> m_values;
+        std::unique_ptr<std::atomic<bool>[]> m_ready;
+        std::size_t m_slots;
+        std::atomic<std::size_t> m_published{0};
+    };
+}
+
+#endif // UTILS_WORK_STEALING_POOL_H
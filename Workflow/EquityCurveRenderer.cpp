@@ -15,7 +15,7 @@ namespace Workflow {
         UI::displayHeader("EQUITY CURVE");
         
         // Get all trades
-        auto trades = m_sessionManager.getAllTrades();
+        const auto& trades = m_sessionManager.getTradesView();
         
         if (trades.empty()) {
             std::cout << "No trades available to display equity curve.\n";
@@ -24,24 +24,11 @@ namespace Workflow {
         
         // Generate equity curve data
         double initialBalance = m_sessionManager.getCurrentBalance();
-        std::vector<double> equityCurve;
-        equityCurve.push_back(initialBalance);
-        
-        double currentBalance = initialBalance;
-        for (const auto& trade : trades) {
-            auto outcome = trade->getOutcome();
-            
-            if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                currentBalance += trade->getResults().rewardAmount;
-            } else if (outcome == TradeOutcome::LossAtSL) {
-                currentBalance -= trade->getResults().riskAmount;
-            }
-            
-            equityCurve.push_back(currentBalance);
-        }
+        std::vector<double> equityCurve = buildEquityCurve(trades, initialBalance);
+        double currentBalance = equityCurve.back();
         
-        // Display ASCII chart
-        std::cout << generateASCIIChart(width, height) << "\n\n";
+        // Display ASCII chart (columns summarize the curve, so long histories stay cheap)
+        std::cout << Utils::generateASCIIChart(equityCurve, width, height) << "\n\n";
         
         // Display basic statistics
         std::cout << "Starting Balance: $" << std::fixed << std::setprecision(2) 
@@ -90,7 +77,7 @@ namespace Workflow {
         
         // Use Analytics to calculate extended stats
         Analytics::EquityAnalyzer analyzer;
-        auto trades = m_sessionManager.getAllTrades();
+        const auto& trades = m_sessionManager.getTradesView();
         auto stats = analyzer.calculateStats(trades, m_sessionManager.getCurrentBalance());
         
         // Display extended stats report
@@ -110,15 +97,20 @@ namespace Workflow {
     }
     
     std::string EquityCurveRenderer::generateASCIIChart(int width, int height) const {
-        auto trades = m_sessionManager.getAllTrades();
+        const auto& trades = m_sessionManager.getTradesView();
         
         if (trades.empty()) {
             return "No data to display.";
         }
         
-        // Generate equity curve data
-        double initialBalance = m_sessionManager.getCurrentBalance();
+        std::vector<double> equityCurve = buildEquityCurve(trades, m_sessionManager.getCurrentBalance());
+        return Utils::generateASCIIChart(equityCurve, width, height);
+    }
+    
+    std::vector<double> EquityCurveRenderer::buildEquityCurve(const std::vector<std::shared_ptr<Trade>>& trades,
+                                                              double initialBalance) {
         std::vector<double> equityCurve;
+        equityCurve.reserve(trades.size() + 1);
         equityCurve.push_back(initialBalance);
         
         double currentBalance = initialBalance;
@@ -126,15 +118,14 @@ namespace Workflow {
             auto outcome = trade->getOutcome();
             
             if (outcome == TradeOutcome::WinAtTP1 || outcome == TradeOutcome::WinAtTP2) {
-                currentBalance += trade->getResults().rewardAmount;
+                currentBalance += trade->getResultsRef().rewardAmount;
             } else if (outcome == TradeOutcome::LossAtSL) {
-                currentBalance -= trade->getResults().riskAmount;
+                currentBalance -= trade->getResultsRef().riskAmount;
             }
             
             equityCurve.push_back(currentBalance);
         }
-        
-        return Utils::generateASCIIChart(equityCurve, width, height);
+        return equityCurve;
     }
     
     // Function wrapper for backward compatibility
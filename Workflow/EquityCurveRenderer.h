@@ -1,7 +1,9 @@
 #ifndef WORKFLOW_EQUITY_CURVE_RENDERER_H
 #define WORKFLOW_EQUITY_CURVE_RENDERER_H
 
+#include <memory>
 #include <string>
+#include <vector>
 #include "../SessionManager.h"
 #include "../Analytics/EquityStats.h"
 
@@ -28,6 +30,8 @@ namespace Workflow {
         
         // Helper methods
         std::string generateASCIIChart(int width, int height) const;
+        static std::vector<double> buildEquityCurve(const std::vector<std::shared_ptr<Trade>>& trades,
+                                                    double initialBalance);
     };
     
     // Function wrapper for backward compatibility
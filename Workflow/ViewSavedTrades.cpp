@@ -9,7 +9,7 @@ namespace Workflow {
     void viewSavedTrades(SessionManager& sessionManager) {
         Utils::printHeader("SAVED TRADES");
         
-        auto trades = sessionManager.getAllTrades();
+        const auto& trades = sessionManager.getTradesView();
         if (trades.empty()) {
             Utils::printInfo("No trades found in the current session.");
             return;
@@ -21,7 +21,7 @@ namespace Workflow {
             Utils::printColorText("Trade: " + trade->getId() + "\n", Utils::COLOR_CYAN);
             
             auto params = trade->getParameters();
-            auto results = trade->getResults();
+            const auto& results = trade->getResultsRef();
             std::string outcome = trade->getOutcomeAsString();
             
             std::cout << std::fixed << std::setprecision(2);
@@ -84,7 +84,7 @@ namespace Workflow {
             Utils::clearScreen();
             Utils::printHeader("TRADE DETAILS");
             
-            auto selectedTrade = trades[tradeIndex - 1];
+            const auto& selectedTrade = trades[tradeIndex - 1];
             std::cout << selectedTrade->getSummary() << std::endl;
         }
     }
@@ -0,0 +1,194 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/ExitResolver.h"
+#include "../Backtest/BacktestTrade.h"
+#include "../Backtest/SignalScanner.h"
+#include "../Utils/CpuFeatures.h"
+#include "../Analytics/EquityStats.h"
+#include "test_helpers.h"
+#include <cmath>
+#include <random>
+
+using Backtest::CandleSeries;
+using Backtest::ExitResolution;
+using Backtest::ExitResolver;
+using Backtest::SignalScanner;
+using TestHelpers::makeRandomWalk;
+
+namespace {
+    void requireSameExit(const ExitResolution& fast, const ExitResolution& reference) {
+        REQUIRE(fast.finished == reference.finished);
+        REQUIRE(fast.outcome == reference.outcome);
+        if (reference.finished) {
+            REQUIRE(fast.exitIndex == reference.exitIndex);
+        }
+    }
+
+    std::shared_ptr<CandleSeries> makeFlatSeries(std::size_t count, double price) {
+        auto series = std::make_shared<CandleSeries>();
+        for (std::size_t i = 0; i < count; ++i) {
+            series->push_back({static_cast<std::time_t>(i * 60), price, price, price, price});
+        }
+        return series;
+    }
+}
+
+TEST_CASE("ExitResolver matches the bar-by-bar scan", "[backtest][exit]") {
+    for (std::uint32_t seed : {1u, 2u, 3u}) {
+        auto series = makeRandomWalk(5000, seed, true);
+        ExitResolver resolver(series);
+
+        std::mt19937 rng(seed * 7919u);
+        std::uniform_int_distribution<std::size_t> entryDist(0, series->size() - 1);
+        std::uniform_real_distribution<double> distance(0.0, 0.0080);
+
+        for (int trial = 0; trial < 20000; ++trial) {
+            std::size_t entry = entryDist(rng);
+            bool isLong = (trial & 1) == 0;
+            double entryPrice = series->close()[entry];
+            double slDistance = distance(rng);
+            double tpDistance = (trial % 5 == 0) ? slDistance : distance(rng);
+            double stopLoss = isLong ? entryPrice - slDistance : entryPrice + slDistance;
+            double takeProfit = isLong ? entryPrice + tpDistance : entryPrice - tpDistance;
+
+            requireSameExit(resolver.resolve(entry, isLong, stopLoss, takeProfit),
+                            ExitResolver::resolveScalar(*series, entry, isLong, stopLoss, takeProfit));
+        }
+    }
+}
+
+TEST_CASE("ExitResolver handles short series", "[backtest][exit]") {
+    for (std::size_t count = 1; count < 140; ++count) {
+        auto series = makeRandomWalk(count, static_cast<std::uint32_t>(count), true);
+        ExitResolver resolver(series);
+        for (std::size_t entry = 0; entry < count; ++entry) {
+            double entryPrice = series->close()[entry];
+            for (bool isLong : {true, false}) {
+                double stopLoss = isLong ? entryPrice - 0.0015 : entryPrice + 0.0015;
+                double takeProfit = isLong ? entryPrice + 0.0030 : entryPrice - 0.0030;
+                requireSameExit(resolver.resolve(entry, isLong, stopLoss, takeProfit),
+                                ExitResolver::resolveScalar(*series, entry, isLong, stopLoss, takeProfit));
+            }
+        }
+    }
+}
+
+TEST_CASE("ExitResolver keeps the original exit rules", "[backtest][exit]") {
+    SECTION("stop loss wins when both levels are hit on the same bar") {
+        auto series = makeFlatSeries(10, 1.0);
+        series->high()[3] = 1.2;
+        series->low()[3] = 0.8;
+        ExitResolution exit = ExitResolver(series).resolve(0, true, 0.9, 1.1);
+        REQUIRE(exit.finished);
+        REQUIRE(exit.outcome == TradeOutcome::LossAtSL);
+        REQUIRE(exit.exitIndex == 3);
+    }
+
+    SECTION("the holding limit overrides a hit on the last bar") {
+        auto series = makeFlatSeries(ExitResolver::MAX_HOLDING_BARS + 10, 1.0);
+        std::size_t timeoutBar = ExitResolver::MAX_HOLDING_BARS;
+        series->low()[timeoutBar] = 0.5;
+        series->close()[timeoutBar] = 1.05;
+        ExitResolution exit = ExitResolver(series).resolve(0, true, 0.9, 1.1);
+        REQUIRE(exit.finished);
+        REQUIRE(exit.outcome == TradeOutcome::WinAtTP1);
+        REQUIRE(exit.exitIndex == timeoutBar);
+    }
+
+    SECTION("trades stay pending when the data ends first") {
+        auto series = makeFlatSeries(50, 1.0);
+        ExitResolution exit = ExitResolver(series).resolve(10, false, 1.1, 0.9);
+        REQUIRE_FALSE(exit.finished);
+        REQUIRE(exit.outcome == TradeOutcome::Pending);
+    }
+}
+
+TEST_CASE("SignalScanner AVX2 kernel matches the scalar kernel", "[backtest][signals]") {
+    if (!Utils::cpuSupportsAvx2()) {
+        SKIP("CPU has no AVX2");
+    }
+
+    // Lengths around the 4-lane blocks, including ones the kernel cannot divide
+    for (std::size_t count : {3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 13u, 64u, 1001u, 4099u}) {
+        auto series = makeRandomWalk(count, static_cast<std::uint32_t>(count) * 7u, true);
+
+        // The scanner reads open and close, so put NaN and flat bars there too
+        std::mt19937 rng(static_cast<std::uint32_t>(count));
+        std::uniform_int_distribution<int> special(0, 19);
+        double* open = series->open();
+        double* close = series->close();
+        for (std::size_t i = 0; i < count; ++i) {
+            int kind = special(rng);
+            if (kind == 0) {
+                close[i] = std::nan("");
+            } else if (kind == 1) {
+                open[i] = std::nan("");
+            } else if (kind == 2) {
+                open[i] = close[i];
+            } else if (kind == 3 && i > 0) {
+                close[i] = close[i - 1];
+            }
+        }
+
+        std::vector<std::uint8_t> scalar(count, 0xFF);
+        std::vector<std::uint8_t> avx2(count, 0xFF);
+        SignalScanner::scanScalar(*series, scalar.data());
+        SignalScanner::scanAvx2(*series, avx2.data());
+        INFO("count " << count);
+        REQUIRE(avx2 == scalar);
+    }
+}
+
+TEST_CASE("EquityAccumulator computes stats in one pass", "[backtest][stats]") {
+    auto makeTrade = [](TradeOutcome outcome, double risk, double reward, double rr) {
+        Backtest::BacktestTrade trade{};
+        trade.outcome = outcome;
+        trade.riskAmount = risk;
+        trade.rewardAmount = reward;
+        trade.riskRewardRatio = rr;
+        return trade;
+    };
+
+    std::vector<Backtest::BacktestTrade> trades = {
+        makeTrade(TradeOutcome::WinAtTP1, 100.0, 200.0, 2.0),
+        makeTrade(TradeOutcome::LossAtSL, 100.0, 200.0, 2.0),
+        makeTrade(TradeOutcome::Pending, 100.0, 200.0, 2.0),
+        makeTrade(TradeOutcome::LossAtSL, 100.0, 200.0, 2.0),
+    };
+
+    Analytics::EquityAccumulator accumulator(10000.0);
+    REQUIRE(accumulator.push(trades[0]) == 0.0);
+    REQUIRE(accumulator.push(trades[1]) == Catch::Approx(100.0 / 10200.0 * 100.0));
+    accumulator.push(trades[2]);
+    accumulator.push(trades[3]);
+
+    Analytics::EquityStats stats = accumulator.snapshot();
+    REQUIRE(stats.totalTrades == 4);
+    REQUIRE(stats.finalBalance == 10000.0);
+    REQUIRE(stats.totalPnL == 0.0);
+    REQUIRE(stats.winRate == 25.0);
+    REQUIRE(stats.profitFactor == 1.0);
+    REQUIRE(stats.maxDrawdown == 200.0);
+    REQUIRE(stats.drawdownDuration == 3);
+    REQUIRE(stats.longestWinStreak == 1);
+    REQUIRE(stats.longestLoseStreak == 1);
+    REQUIRE(stats.currentStreak == -1);
+    REQUIRE(stats.avgWin == 200.0);
+    REQUIRE(stats.avgLoss == Catch::Approx(200.0 / 3.0));
+    REQUIRE(stats.avgRMultiple == 0.0);
+    REQUIRE(accumulator.getWinningTrades() == 1);
+    REQUIRE(accumulator.getLosingTrades() == 2);
+
+    // Population standard deviation of the four per-trade returns
+    std::vector<double> returns = {200.0 / 10000.0, -100.0 / 10200.0, 0.0, -100.0 / 10100.0};
+    double mean = (returns[0] + returns[1] + returns[2] + returns[3]) / 4.0;
+    double variance = 0.0;
+    for (double r : returns) {
+        variance += (r - mean) * (r - mean) / 4.0;
+    }
+    REQUIRE(stats.sharpeRatio == Catch::Approx(mean / std::sqrt(variance) * std::sqrt(252.0)));
+
+    // The batch entry point gives the same result
+    Analytics::EquityStats batch = Analytics::EquityAnalyzer().calculateStats(trades, 10000.0);
+    REQUIRE(batch.sharpeRatio == stats.sharpeRatio);
+    REQUIRE(batch.maxDrawdownPercent == stats.maxDrawdownPercent);
+}
@@ -1,7 +1,11 @@
 #include <catch2/catch_all.hpp>
 #include "../Backtest/BatchBacktester.h"
+#include "../Backtest/ChartRenderQueue.h"
 #include <filesystem>
 #include <fstream>
+#include <set>
+#include <thread>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -143,6 +147,56 @@ TEST_CASE_METHOD(BatchBacktesterFixture, "BatchBacktester generates equity curve
     // we'll leave this as a placeholder
 }
 
+TEST_CASE("ChartRenderQueue renders every job on a single thread", "[batch][charts]") {
+    std::set<std::thread::id> renderThreads;
+    size_t curvePoints = 0;
+    size_t jobsWithTrades = 0;  // Assertions stay on the test thread
+    
+    // Capacity 1 makes producers block on a slow renderer
+    Backtest::ChartRenderQueue queue(
+        [&](const std::string& name, const Backtest::BacktestResult& curves) {
+            renderThreads.insert(std::this_thread::get_id());
+            curvePoints += curves.equityCurve.size();
+            if (!curves.trades.empty()) {
+                jobsWithTrades++;
+            }
+            return name == "fails" ? std::string() : "charts/" + name + ".png";
+        },
+        1);
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < 25; ++i) {
+                Backtest::BacktestResult result;
+                result.equityCurve.assign(10, 1.0);
+                result.trades.resize(3);
+                queue.push("s" + std::to_string(p) + "_" + std::to_string(i), result);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    queue.push("fails", Backtest::BacktestResult());
+    
+    auto images = queue.finish();
+    REQUIRE(images.size() == 100);
+    REQUIRE(images["s3_24"] == "charts/s3_24.png");
+    REQUIRE(images.find("fails") == images.end());
+    REQUIRE(renderThreads.size() == 1);
+    REQUIRE(renderThreads.count(std::this_thread::get_id()) == 0);
+    REQUIRE(curvePoints == 1000);
+    REQUIRE(jobsWithTrades == 0);  // Only the curves are queued
+    
+    // A job pushed after finish() is dropped, so its budget charge is returned
+    Backtest::BacktestResult late;
+    late.equityCurve.assign(10, 1.0);
+    late.drawdownCurve.assign(10, 0.0);
+    REQUIRE(Backtest::ChartRenderQueue::chartBytes(late) == 20 * sizeof(double));
+    REQUIRE_FALSE(queue.push("late", late));
+}
+
 TEST_CASE_METHOD(BatchBacktesterFixture, "BatchBacktester handles parallel execution", "[batch][parallel]") {
     // Add all test files
     m_backtester.addStrategyDirectory("test_data");
@@ -0,0 +1,182 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/CandleCache.h"
+#include "../Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+using Backtest::CandleCache;
+using Backtest::CandleCacheHeader;
+using Backtest::CandleData;
+using Backtest::CandleSeries;
+using Backtest::LoaderMode;
+using Backtest::LoaderStats;
+using Backtest::SourceSignature;
+
+namespace {
+    CandleSeries makeSeries(std::size_t count) {
+        std::mt19937 rng(11);
+        std::normal_distribution<double> step(0.0, 0.0005);
+        CandleSeries series;
+        double price = 1.1000;
+        for (std::size_t i = 0; i < count; ++i) {
+            CandleData candle;
+            candle.timestamp = static_cast<std::time_t>(1700000000 + 60 * i);
+            candle.open = price;
+            price += step(rng);
+            candle.close = price;
+            candle.high = std::max(candle.open, candle.close) + 0.0002;
+            candle.low = std::min(candle.open, candle.close) - 0.0002;
+            candle.volume = static_cast<double>(i % 97);
+            series.push_back(candle);
+        }
+        return series;
+    }
+
+    // The cache only checks the CSV's size and mtime, so any content will do
+    std::string writeSource(const std::string& name, const std::string& contents) {
+        std::string csv = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream file(csv, std::ios::binary | std::ios::trunc);
+        file << contents;
+        return csv;
+    }
+
+    SourceSignature signatureOf(const std::string& csv) {
+        SourceSignature signature;
+        REQUIRE(CandleCache::sourceSignature(csv, signature));
+        return signature;
+    }
+
+    std::vector<char> readBytes(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    void cleanup(const std::string& csv) {
+        std::remove(csv.c_str());
+        std::remove(CandleCache::cachePathFor(csv).c_str());
+    }
+}
+
+TEST_CASE("Candle cache round-trips every column", "[cache]") {
+    std::string csv = writeSource("candle_cache_roundtrip.csv", "header\n");
+    CandleSeries series = makeSeries(1001);  // Columns that are not a multiple of the alignment
+    REQUIRE(CandleCache::write(csv, LoaderMode::MemoryMapped, series, signatureOf(csv)));
+
+    // The temporary file was renamed away
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::temp_directory_path())) {
+        std::string name = entry.path().filename().string();
+        CHECK(name.rfind("candle_cache_roundtrip.csv.tcc.tmp", 0) != 0);
+    }
+
+    CandleSeries loaded;
+    LoaderStats stats;
+    REQUIRE(CandleCache::load(csv, LoaderMode::MemoryMapped, loaded, stats));
+    CHECK(stats.fromCache);
+    CHECK(stats.rows == series.size());
+    REQUIRE(loaded.size() == series.size());
+    CHECK(std::memcmp(loaded.timestamp(), series.timestamp(), series.size() * sizeof(std::int64_t)) == 0);
+    CHECK(std::memcmp(loaded.open(), series.open(), series.size() * sizeof(double)) == 0);
+    CHECK(std::memcmp(loaded.high(), series.high(), series.size() * sizeof(double)) == 0);
+    CHECK(std::memcmp(loaded.low(), series.low(), series.size() * sizeof(double)) == 0);
+    CHECK(std::memcmp(loaded.close(), series.close(), series.size() * sizeof(double)) == 0);
+    CHECK(std::memcmp(loaded.volume(), series.volume(), series.size() * sizeof(double)) == 0);
+
+    // A cache parsed with the other loader has different timestamps
+    CandleSeries other;
+    CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, other, stats));
+
+    cleanup(csv);
+}
+
+TEST_CASE("Candle cache is rebuilt when the CSV changes", "[cache]") {
+    std::string csv = writeSource("candle_cache_stale.csv", "header\n");
+    CandleSeries series = makeSeries(64);
+    CandleSeries loaded;
+    LoaderStats stats;
+
+    SECTION("Size") {
+        REQUIRE(CandleCache::write(csv, LoaderMode::Stream, series, signatureOf(csv)));
+        auto mtime = std::filesystem::last_write_time(csv);
+        writeSource("candle_cache_stale.csv", "header,with,more\n");
+        std::filesystem::last_write_time(csv, mtime);
+        CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+    }
+
+    SECTION("Modification time") {
+        REQUIRE(CandleCache::write(csv, LoaderMode::Stream, series, signatureOf(csv)));
+        std::filesystem::last_write_time(csv, std::filesystem::last_write_time(csv) + std::chrono::seconds(2));
+        CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+
+        // Writing again makes it current
+        REQUIRE(CandleCache::write(csv, LoaderMode::Stream, series, signatureOf(csv)));
+        CHECK(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+    }
+
+    SECTION("Changed while parsing") {
+        // The signature is taken before reading, so the cache is stale at once
+        SourceSignature beforeParse = signatureOf(csv);
+        writeSource("candle_cache_stale.csv", "header,written,during,the,parse\n");
+        REQUIRE(CandleCache::write(csv, LoaderMode::Stream, series, beforeParse));
+        CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+    }
+
+    cleanup(csv);
+}
+
+TEST_CASE("Candle cache rejects corrupt and foreign files", "[cache]") {
+    std::string csv = writeSource("candle_cache_corrupt.csv", "header\n");
+    CandleSeries series = makeSeries(200);
+    REQUIRE(CandleCache::write(csv, LoaderMode::Stream, series, signatureOf(csv)));
+    const std::string cachePath = CandleCache::cachePathFor(csv);
+    const std::vector<char> intact = readBytes(cachePath);
+    REQUIRE(intact.size() == CandleCache::fileSize(series.size()));
+
+    CandleSeries loaded;
+    LoaderStats stats;
+
+    SECTION("Checksum") {
+        std::vector<char> corrupt = intact;
+        corrupt[CandleCache::columnOffset(4, series.size()) + 17] ^= 0x01;  // One bit of a close price
+        writeBytes(cachePath, corrupt);
+        CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+        CHECK(loaded.empty());  // Left untouched
+    }
+
+    SECTION("Version") {
+        std::vector<char> foreign = intact;
+        std::uint32_t version = CandleCache::VERSION + 1;
+        std::memcpy(foreign.data() + offsetof(CandleCacheHeader, version), &version, sizeof(version));
+        writeBytes(cachePath, foreign);
+        CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+    }
+
+    SECTION("Truncated") {
+        writeBytes(cachePath, std::vector<char>(intact.begin(), intact.end() - 64));
+        CHECK_FALSE(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+    }
+
+    // The intact file is still accepted
+    writeBytes(cachePath, intact);
+    CHECK(CandleCache::load(csv, LoaderMode::Stream, loaded, stats));
+
+    cleanup(csv);
+}
+
+TEST_CASE("Temporary cache names are unique per call", "[cache]") {
+    std::string first = Utils::uniqueTempPath("prices.csv.tcc");
+    std::string second = Utils::uniqueTempPath("prices.csv.tcc");
+    CHECK(first != second);
+    CHECK(first.rfind("prices.csv.tcc.tmp", 0) == 0);
+}
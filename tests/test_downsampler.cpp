@@ -0,0 +1,49 @@
+#include <catch2/catch_all.hpp>
+#include "../Utils/Downsampler.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("Curve downsampling keeps endpoints, peaks and troughs", "[downsampler]") {
+    std::vector<double> curve(100000);
+    for (size_t i = 0; i < curve.size(); ++i) {
+        curve[i] = 10000.0 + 500.0 * std::sin(i / 1000.0);
+    }
+    curve[31337] = 20000.0; // Spike
+    curve[77777] = 1000.0;  // Crash
+    
+    SECTION("LTTB") {
+        auto points = Utils::downsampleLTTB(curve, 1200);
+        REQUIRE(points.x.size() == 1200);
+        REQUIRE(points.y.size() == 1200);
+        REQUIRE(points.x.front() == 0.0);
+        REQUIRE(points.x.back() == curve.size() - 1.0);
+        REQUIRE(std::is_sorted(points.x.begin(), points.x.end()));
+        REQUIRE(std::find(points.x.begin(), points.x.end(), 31337.0) != points.x.end());
+        REQUIRE(std::find(points.x.begin(), points.x.end(), 77777.0) != points.x.end());
+    }
+    
+    SECTION("Min/max") {
+        auto points = Utils::downsampleMinMax(curve, 600);
+        REQUIRE(points.x.size() <= 1200);
+        REQUIRE(*std::max_element(points.y.begin(), points.y.end()) == 20000.0);
+        REQUIRE(*std::min_element(points.y.begin(), points.y.end()) == 1000.0);
+        for (size_t i = 0; i < points.x.size(); ++i) {
+            REQUIRE(points.y[i] == curve[static_cast<size_t>(points.x[i])]);
+        }
+    }
+    
+    SECTION("Column envelope") {
+        auto columns = Utils::columnEnvelope(curve, 70);
+        REQUIRE(columns.high.size() == 70);
+        REQUIRE(*std::max_element(columns.high.begin(), columns.high.end()) == 20000.0);
+        REQUIRE(*std::min_element(columns.low.begin(), columns.low.end()) == 1000.0);
+    }
+    
+    SECTION("Short curves are kept whole") {
+        std::vector<double> shortCurve = {1.0, 3.0, 2.0};
+        REQUIRE(Utils::downsampleLTTB(shortCurve, 1200).y == shortCurve);
+        REQUIRE(Utils::downsampleMinMax(shortCurve, 600).y == shortCurve);
+        REQUIRE(Utils::columnEnvelope(shortCurve, 70).high == shortCurve);
+    }
+}
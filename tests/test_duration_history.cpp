@@ -0,0 +1,114 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/DurationHistory.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using Backtest::DurationHistory;
+using std::chrono::milliseconds;
+
+namespace {
+    std::string tempPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::string writeStrategy(const std::string& name, std::size_t bytes, char fill = 'x') {
+        std::string path = tempPath(name);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << std::string(bytes, fill);
+        return path;
+    }
+}
+
+TEST_CASE("DurationHistory survives a save and load", "[batch][history]") {
+    std::string historyFile = tempPath("duration_history_roundtrip.json");
+    std::string fast = writeStrategy("history_fast.csv", 1000);
+    std::string slow = writeStrategy("history_slow.csv", 70000);  // Past the 64 KB head sample
+
+    {
+        DurationHistory history(historyFile);
+        CHECK_FALSE(history.load());  // No file yet
+        history.record(fast, DurationHistory::fingerprint(fast), 1000, milliseconds(120));
+        history.record(slow, DurationHistory::fingerprint(slow), 70000, milliseconds(4500));
+        history.record(fast, "", 1000, milliseconds(1));  // No fingerprint: ignored
+        REQUIRE(history.save());
+    }
+
+    DurationHistory loaded(historyFile);
+    REQUIRE(loaded.load());
+    CHECK(loaded.size() == 2);
+
+    milliseconds duration{0};
+    REQUIRE(loaded.lookup(fast, DurationHistory::fingerprint(fast), duration));
+    CHECK(duration == milliseconds(120));
+    REQUIRE(loaded.lookup(slow, DurationHistory::fingerprint(slow), duration));
+    CHECK(duration == milliseconds(4500));
+
+    // Relative and absolute spellings of a path are the same entry
+    std::filesystem::path relative = std::filesystem::relative(fast);
+    CHECK(loaded.lookup(relative.string(), DurationHistory::fingerprint(fast), duration));
+
+    // A changed file no longer matches its recorded duration
+    writeStrategy("history_slow.csv", 70000, 'y');
+    CHECK_FALSE(loaded.lookup(slow, DurationHistory::fingerprint(slow), duration));
+
+    // A file from another version is ignored
+    {
+        std::ofstream file(historyFile, std::ios::trunc);
+        file << R"({"version": 99, "strategies": {}})";
+    }
+    CHECK_FALSE(loaded.load());
+    CHECK(loaded.size() == 0);
+
+    std::remove(historyFile.c_str());
+    std::remove(fast.c_str());
+    std::remove(slow.c_str());
+}
+
+TEST_CASE("DurationHistory estimates order strategies longest first", "[batch][history]") {
+    std::string historyFile = tempPath("duration_history_order.json");
+    std::string bigButFast = writeStrategy("history_big_fast.csv", 40000);
+    std::string smallButSlow = writeStrategy("history_small_slow.csv", 2000);
+    std::string unknown = writeStrategy("history_unknown.csv", 20000);
+
+    DurationHistory history(historyFile);
+    history.record(bigButFast, DurationHistory::fingerprint(bigButFast), 40000, milliseconds(100));
+    history.record(smallButSlow, DurationHistory::fingerprint(smallButSlow), 2000, milliseconds(900));
+
+    std::vector<std::string> files = {bigButFast, unknown, smallButSlow};
+    std::vector<double> estimates;
+    for (const auto& file : files) {
+        std::uintmax_t size = std::filesystem::file_size(file);
+        estimates.push_back(history.estimate(file, DurationHistory::fingerprint(file), size));
+    }
+
+    // Recorded durations are used as-is
+    CHECK(estimates[0] == 100.0);
+    CHECK(estimates[2] == 900.0);
+    // The unknown file is scaled by the average rate: 1000 ms / 42000 bytes
+    CHECK(estimates[1] == Catch::Approx(20000.0 * 1000.0 / 42000.0));
+
+    // The batch runner's stable longest-first sort
+    std::vector<std::size_t> order = {0, 1, 2};
+    std::stable_sort(order.begin(), order.end(), [&estimates](std::size_t a, std::size_t b) {
+        return estimates[a] > estimates[b];
+    });
+    CHECK(order == std::vector<std::size_t>{2, 1, 0});
+
+    std::remove(bigButFast.c_str());
+    std::remove(smallButSlow.c_str());
+    std::remove(unknown.c_str());
+}
+
+TEST_CASE("Without history the estimate is the file size", "[batch][history]") {
+    DurationHistory history(tempPath("duration_history_missing.json"));
+    std::string file = writeStrategy("history_no_entry.csv", 1234);
+
+    CHECK(history.estimate(file, DurationHistory::fingerprint(file), 1234) == 1234.0);
+    CHECK(history.estimate("missing.csv", DurationHistory::fingerprint("missing.csv"), 77) == 77.0);
+    CHECK(DurationHistory::fingerprint("missing.csv").empty());
+
+    std::remove(file.c_str());
+}
@@ -0,0 +1,48 @@
+#ifndef TESTS_TEST_HELPERS_H
+#define TESTS_TEST_HELPERS_H
+
+#include "../Backtest/CandleSeries.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+namespace TestHelpers {
+    // One-minute random walk around 1.1000. With specialBars, about one bar
+    // in 200 gets a NaN high, a NaN low or no range at all.
+    inline std::shared_ptr<Backtest::CandleSeries> makeRandomWalk(std::size_t count, std::uint32_t seed,
+                                                                  bool specialBars = false) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0.0, 0.0008);
+        std::uniform_real_distribution<double> wick(0.0, 0.0010);
+        std::uniform_int_distribution<int> special(0, 199);
+
+        auto series = std::make_shared<Backtest::CandleSeries>();
+        double price = 1.1000;
+        for (std::size_t i = 0; i < count; ++i) {
+            Backtest::CandleData candle;
+            candle.timestamp = static_cast<std::time_t>(i * 60);
+            candle.open = price;
+            price += step(rng);
+            candle.close = price;
+            candle.high = std::max(candle.open, candle.close) + wick(rng);
+            candle.low = std::min(candle.open, candle.close) - wick(rng);
+
+            if (specialBars) {
+                int kind = special(rng);
+                if (kind == 0) {
+                    candle.high = std::nan("");
+                } else if (kind == 1) {
+                    candle.low = std::nan("");
+                } else if (kind == 2) {
+                    candle.high = candle.low = candle.close = candle.open;
+                }
+            }
+            series->push_back(candle);
+        }
+        return series;
+    }
+}
+
+#endif // TESTS_TEST_HELPERS_H
@@ -0,0 +1,137 @@
+#include <catch2/catch_all.hpp>
+#include "../Utils/IdGenerator.h"
+#include "../Trade.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    // Packs the (thread, sequence) fields of a makeId() ID into one key. Within
+    // a process only these fields can tell two IDs apart, and unlike a hash,
+    // distinct keys always mean distinct IDs.
+    bool threadSequenceKey(const std::string& id, std::uint64_t& key) {
+        std::size_t sequenceStart = id.rfind('_') + 1;
+        std::size_t threadStart = id.rfind('_', sequenceStart - 2) + 1;
+        const char* threadLast = id.data() + sequenceStart - 1;
+        const char* sequenceLast = id.data() + id.size();
+        std::uint64_t thread = 0;
+        std::uint64_t sequence = 0;
+        if (std::from_chars(id.data() + threadStart, threadLast, thread, 16).ptr != threadLast ||
+            std::from_chars(id.data() + sequenceStart, sequenceLast, sequence, 16).ptr != sequenceLast ||
+            thread >= (1ULL << 32) || sequence >= (1ULL << 32)) {
+            return false;
+        }
+        key = (thread << 32) | sequence;
+        return true;
+    }
+
+    // What Trade::generateId did before Utils::makeId
+    std::string legacyTradeId() {
+        auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        std::uniform_int_distribution<> dis(0, 9999);
+        std::stringstream ss;
+        ss << "TRADE_" << now_ms.count() << "_" << std::setfill('0') << std::setw(4) << dis(gen);
+        return ss.str();
+    }
+}
+
+TEST_CASE("makeId formats prefix, epoch, thread and sequence", "[ids]") {
+    std::string first = Utils::makeId("TEST");
+    std::string second = Utils::makeId("TEST");
+
+    REQUIRE(first.rfind("TEST_", 0) == 0);
+    REQUIRE(std::count(first.begin(), first.end(), '_') == 3);
+    REQUIRE(first.size() <= 4 + Utils::kMaxIdSuffixLength);
+    REQUIRE(first.find_first_not_of("TEST_0123456789abcdef") == std::string::npos);
+
+    // Same thread: only the sequence differs
+    REQUIRE(first.substr(0, first.rfind('_')) == second.substr(0, second.rfind('_')));
+    REQUIRE(first != second);
+}
+
+TEST_CASE("makeId produces 10M unique IDs across threads", "[ids]") {
+    const unsigned int threadCount = 8;
+    const std::size_t perThread = 10000000 / threadCount;
+
+    // All IDs share the process epoch, so uniqueness rests on (thread, sequence)
+    const std::string first = Utils::makeId("TRADE");
+    const std::string epochPrefix = first.substr(0, first.find('_', 6) + 1);
+
+    std::vector<std::vector<std::uint64_t>> keys(threadCount);
+    std::vector<std::size_t> malformed(threadCount, 0);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            keys[t].reserve(perThread);
+            for (std::size_t i = 0; i < perThread; ++i) {
+                std::string id = Utils::makeId("TRADE");
+                std::uint64_t key = 0;
+                if (id.compare(0, epochPrefix.size(), epochPrefix) != 0 || !threadSequenceKey(id, key)) {
+                    malformed[t]++;
+                }
+                keys[t].push_back(key);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<std::uint64_t> all;
+    all.reserve(threadCount * perThread);
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        REQUIRE(malformed[t] == 0);
+        all.insert(all.end(), keys[t].begin(), keys[t].end());
+    }
+    std::sort(all.begin(), all.end());
+
+    REQUIRE(all.size() == threadCount * perThread);
+    REQUIRE(std::adjacent_find(all.begin(), all.end()) == all.end());
+}
+
+TEST_CASE("Trades created in a burst get distinct IDs", "[ids]") {
+    std::unordered_set<std::string> ids;
+    for (int i = 0; i < 20000; ++i) {
+        Trade trade;
+        REQUIRE(ids.insert(trade.getId()).second);
+    }
+}
+
+TEST_CASE("ID generation throughput", "[ids][!benchmark]") {
+    BENCHMARK("Utils::makeId") {
+        return Utils::makeId("TRADE");
+    };
+
+    BENCHMARK("random_device + mt19937 + stringstream") {
+        return legacyTradeId();
+    };
+
+    // IDs/second with every hardware thread generating
+    unsigned int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t perThread = 1000000;
+    std::vector<std::size_t> lengths(threadCount);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&lengths, t, perThread]() {
+            for (std::size_t i = 0; i < perThread; ++i) {
+                lengths[t] += Utils::makeId("TRADE").size();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    WARN(threadCount << " threads: " << static_cast<std::uint64_t>(threadCount * perThread / seconds) << " IDs/second");
+}
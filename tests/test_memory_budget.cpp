@@ -0,0 +1,102 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/MemoryBudget.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using Backtest::MemoryBudget;
+
+namespace {
+    // Runs acquire() on another thread so the test can see whether it blocks
+    class PendingAcquire {
+    public:
+        PendingAcquire(MemoryBudget& budget, size_t bytes)
+            : m_thread([this, &budget, bytes]() {
+                  m_waited = budget.acquire(bytes);
+                  m_done = true;
+              }) {
+        }
+
+        ~PendingAcquire() {
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+        }
+
+        // True if acquire() is still blocked after a short wait
+        bool blocked() const {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            return !m_done;
+        }
+
+        bool finish() {
+            m_thread.join();
+            return m_waited;
+        }
+
+    private:
+        std::atomic<bool> m_done{false};
+        bool m_waited = false;
+        std::thread m_thread;
+    };
+}
+
+TEST_CASE("MemoryBudget blocks reservations that do not fit", "[batch][memory]") {
+    MemoryBudget budget(100);
+    CHECK_FALSE(budget.acquire(60));
+    CHECK_FALSE(budget.acquire(40));  // Exactly fills the budget
+
+    PendingAcquire next(budget, 30);
+    CHECK(next.blocked());
+
+    budget.release(40);
+    CHECK(next.finish());
+    CHECK(budget.getThrottleCount() == 1);
+    CHECK(budget.getPeakReservedBytes() == 100);
+
+    budget.release(60);
+    budget.release(30);
+}
+
+TEST_CASE("MemoryBudget counts retained memory until it is released", "[batch][memory]") {
+    MemoryBudget budget(100);
+    CHECK_FALSE(budget.acquire(30));
+    budget.retain(60);
+    CHECK(budget.getPeakReservedBytes() == 90);
+
+    PendingAcquire next(budget, 20);
+    CHECK(next.blocked());
+
+    // Freeing the retained result makes room; the in-flight job is still running
+    budget.releaseRetained(60);
+    CHECK(next.finish());
+
+    budget.release(30);
+    budget.release(20);
+}
+
+TEST_CASE("MemoryBudget admits one job larger than the budget on its own", "[batch][memory]") {
+    MemoryBudget budget(100);
+    CHECK_FALSE(budget.acquire(500));  // Nothing in flight: admitted at once
+    CHECK(budget.getPeakReservedBytes() == 500);
+
+    PendingAcquire small(budget, 10);
+    CHECK(small.blocked());
+    budget.release(500);
+    CHECK(small.finish());
+
+    // Retained memory alone never holds a job back
+    budget.release(10);
+    budget.retain(1000);
+    CHECK_FALSE(budget.acquire(50));
+    budget.release(50);
+    budget.releaseRetained(1000);
+}
+
+TEST_CASE("An unlimited MemoryBudget never blocks", "[batch][memory]") {
+    MemoryBudget budget(0);
+    for (int i = 0; i < 10; ++i) {
+        CHECK_FALSE(budget.acquire(1ull << 40));
+    }
+    CHECK(budget.getThrottleCount() == 0);
+}
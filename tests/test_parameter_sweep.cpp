@@ -0,0 +1,107 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/ParameterSweep.h"
+#include "test_helpers.h"
+#include <algorithm>
+
+using Backtest::BacktestConfig;
+using Backtest::Backtester;
+using Backtest::ParameterRange;
+using Backtest::ParameterSweep;
+using Backtest::SweepMode;
+using Backtest::SweepParameter;
+using Backtest::SweepRanking;
+using Backtest::SweepResult;
+using Backtest::SweepSpec;
+using TestHelpers::makeRandomWalk;
+
+namespace {
+    SweepSpec makeGridSpec() {
+        SweepSpec spec;
+        spec.ranges = {
+            {SweepParameter::StopLossPips, 10.0, 30.0, 10.0},
+            {SweepParameter::TakeProfitPips, 10.0, 20.0, 10.0},
+            {SweepParameter::RiskPerTrade, 1.0, 2.0, 1.0}
+        };
+        return spec;
+    }
+
+    std::vector<SweepResult> byIndex(std::vector<SweepResult> results) {
+        std::sort(results.begin(), results.end(),
+                  [](const SweepResult& a, const SweepResult& b) { return a.index < b.index; });
+        return results;
+    }
+}
+
+TEST_CASE("ParameterSweep expands grids and random samples", "[sweep]") {
+    SweepSpec spec = makeGridSpec();
+    std::vector<BacktestConfig> grid = ParameterSweep::expand(spec);
+    REQUIRE(grid.size() == 12);
+
+    // Last range varies fastest
+    CHECK(grid[0].stopLossPips == 10.0);
+    CHECK(grid[0].takeProfitPips == 10.0);
+    CHECK(grid[0].riskPerTrade == 1.0);
+    CHECK(grid[1].riskPerTrade == 2.0);
+    CHECK(grid[2].takeProfitPips == 20.0);
+    CHECK(grid[11].stopLossPips == 30.0);
+
+    spec.mode = SweepMode::Random;
+    spec.samples = 50;
+    spec.ranges.push_back({SweepParameter::RiskRewardRatio, 1.0, 3.0, 0.0});
+    std::vector<BacktestConfig> first = ParameterSweep::expand(spec);
+    std::vector<BacktestConfig> second = ParameterSweep::expand(spec);
+    REQUIRE(first.size() == 50);
+    for (std::size_t i = 0; i < first.size(); ++i) {
+        CHECK(first[i].stopLossPips == second[i].stopLossPips);
+        CHECK(first[i].riskRewardRatio == second[i].riskRewardRatio);
+        CHECK(std::fmod(first[i].stopLossPips, 10.0) == 0.0);
+        CHECK(first[i].riskRewardRatio >= 1.0);
+        CHECK(first[i].riskRewardRatio < 3.0);
+    }
+}
+
+TEST_CASE("ParameterSweep matches separate backtests", "[sweep]") {
+    auto series = makeRandomWalk(20000, 7);
+    SweepSpec spec = makeGridSpec();
+
+    ParameterSweep sweep;
+    sweep.setPriceData(series);
+    spec.threadCount = 4;
+    std::vector<SweepResult> results = sweep.run(spec);
+    REQUIRE(results.size() == 12);
+    REQUIRE(results.front().totalTrades > 0);
+
+    // Ranked best first
+    for (std::size_t i = 1; i < results.size(); ++i) {
+        CHECK(results[i - 1].netProfit >= results[i].netProfit);
+    }
+
+    std::vector<BacktestConfig> configs = ParameterSweep::expand(spec);
+    std::vector<SweepResult> ordered = byIndex(results);
+    for (std::size_t i = 0; i < configs.size(); ++i) {
+        Backtester backtester;
+        backtester.setPriceData(series);
+        backtester.setConfig(configs[i]);
+        Backtest::BacktestResult expected = backtester.runBacktest();
+
+        REQUIRE(ordered[i].index == i);
+        CHECK(ordered[i].totalTrades == expected.totalTrades);
+        CHECK(ordered[i].netProfit == expected.netProfit);
+        CHECK(ordered[i].maxDrawdownPercent == expected.stats.maxDrawdownPercent);
+    }
+
+    SECTION("Thread count does not change results") {
+        spec.threadCount = 1;
+        std::vector<SweepResult> serial = sweep.run(spec);
+        REQUIRE(serial.size() == results.size());
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            CHECK(serial[i].index == results[i].index);
+            CHECK(serial[i].netProfit == results[i].netProfit);
+        }
+    }
+}
+
+TEST_CASE("ParameterSweep without data returns nothing", "[sweep]") {
+    ParameterSweep sweep;
+    CHECK(sweep.run(makeGridSpec()).empty());
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/PriceDataLoader.h"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+using Backtest::CandleSeries;
+using Backtest::LoaderStats;
+using Backtest::PriceDataLoader;
+
+namespace {
+    bool parse(const char* text, std::time_t& timestamp) {
+        return PriceDataLoader::parseTimestamp(text, text + std::strlen(text), timestamp);
+    }
+
+    std::string writeCsv(const std::string& name, const std::string& contents) {
+        std::string csv = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream file(csv, std::ios::binary);
+        file << contents;
+        return csv;
+    }
+}
+
+TEST_CASE("parseTimestamp reads fixed-format dates as UTC", "[loader]") {
+    std::time_t timestamp = 0;
+
+    REQUIRE(parse("2024-01-15 09:30:45", timestamp));
+    CHECK(timestamp == 1705311045);
+    REQUIRE(parse("2024-01-15T09:30:45", timestamp));
+    CHECK(timestamp == 1705311045);
+    REQUIRE(parse("2024-01-15 09:30", timestamp));
+    CHECK(timestamp == 1705311000);
+    REQUIRE(parse("2024-01-15", timestamp));
+    CHECK(timestamp == 1705276800);
+    REQUIRE(parse("1970-01-01 00:00:00", timestamp));
+    CHECK(timestamp == 0);
+    REQUIRE(parse("2024-02-29 00:00:00\r", timestamp));  // CRLF line ending
+    CHECK(timestamp == 1709164800);
+
+    for (const char* malformed : {"", "2024-1-15", "2024-13-01", "2024-01-32", "2024-01-15 24:00",
+                                  "2024-01-15 09:60", "2024-01-15 09:30:45x", "15/01/2024",
+                                  "2024-01-15 09", "2024/01/15"}) {
+        INFO(malformed);
+        CHECK_FALSE(parse(malformed, timestamp));
+    }
+}
+
+TEST_CASE("loadMapped skips malformed rows and handles CRLF", "[loader]") {
+    std::string csv = writeCsv("loader_malformed.csv",
+        "Date,Open,High,Low,Close,Volume\r\n"
+        "2024-01-15 09:00:00,1.1,1.2,1.0,1.15,100\r\n"
+        "not a date,1.1,1.2,1.0,1.15,100\r\n"
+        "2024-01-15 09:01:00,1.1,1.2\r\n"
+        "2024-01-15 09:02:00,1.1,abc,1.0,1.15,100\r\n"
+        "\r\n"
+        "2024-01-15 09:03:00, 1.15 ,1.25,1.05,1.2\r\n"
+        "2024-01-15 09:04:00,1.2,1.3,1.1,1.25,oops\r\n");
+
+    CandleSeries candles;
+    LoaderStats stats;
+    REQUIRE(PriceDataLoader::loadMapped(csv, candles, stats));
+    CHECK(stats.rows == 3);
+    CHECK(stats.rejectedRows == 3);
+    CHECK(stats.sortSkipped);
+    REQUIRE(candles.size() == 3);
+    CHECK(candles[0].close == 1.15);
+    CHECK(candles[0].volume == 100.0);
+    CHECK(candles[1].open == 1.15);    // Spaces around a field are accepted
+    CHECK(candles[1].volume == 0.0);   // No volume column
+    CHECK(candles[2].volume == 0.0);   // Unparseable volume
+    CHECK(candles[2].timestamp - candles[0].timestamp == 240);
+
+    std::remove(csv.c_str());
+}
+
+TEST_CASE("loadMapped sorts out-of-order input", "[loader]") {
+    std::string csv = writeCsv("loader_unsorted.csv",
+        "Date,Open,High,Low,Close\n"
+        "2024-01-15 09:02:00,3,3,3,3\n"
+        "2024-01-15 09:00:00,1,1,1,1\n"
+        "2024-01-15 09:01:00,2,2,2,2");  // No trailing newline
+
+    CandleSeries candles;
+    LoaderStats stats;
+    REQUIRE(PriceDataLoader::loadMapped(csv, candles, stats));
+    CHECK_FALSE(stats.sortSkipped);
+    REQUIRE(candles.size() == 3);
+    for (std::size_t i = 0; i < candles.size(); ++i) {
+        CHECK(candles[i].close == static_cast<double>(i + 1));
+    }
+    CHECK(candles.isSortedByTimestamp());
+
+    std::remove(csv.c_str());
+}
+
+TEST_CASE("loadMapped and loadStream read the same candles", "[loader]") {
+    // One week in January, so no daylight-saving change falls inside it
+    std::string contents = "Date,Open,High,Low,Close,Volume\n";
+    for (int i = 0; i < 7 * 24; ++i) {
+        char row[96];
+        std::snprintf(row, sizeof(row), "2024-01-%02d %02d:%02d:00,%.5f,%.5f,%.5f,%.5f,%d\n",
+                      8 + i / 24, i % 24, (i * 7) % 60,
+                      1.1 + i * 1e-4, 1.1 + i * 1e-4 + 5e-4, 1.1 + i * 1e-4 - 5e-4, 1.1 + i * 1e-4 + 2e-4, i);
+        contents += row;
+    }
+    std::string csv = writeCsv("loader_compare.csv", contents);
+
+    CandleSeries mapped;
+    CandleSeries streamed;
+    LoaderStats mappedStats;
+    LoaderStats streamStats;
+    REQUIRE(PriceDataLoader::loadMapped(csv, mapped, mappedStats));
+    REQUIRE(PriceDataLoader::loadStream(csv, streamed, streamStats));
+    REQUIRE(mapped.size() == streamed.size());
+    CHECK(mappedStats.rows == streamStats.rows);
+    CHECK(mappedStats.sortSkipped == streamStats.sortSkipped);
+
+    // Stream reads local (standard) time and the mapped loader UTC, so the two
+    // differ by the zone offset and by nothing else
+    const std::time_t offset = streamed[0].timestamp - mapped[0].timestamp;
+    CHECK(offset % 60 == 0);
+    for (std::size_t i = 0; i < mapped.size(); ++i) {
+        REQUIRE(streamed[i].timestamp - mapped[i].timestamp == offset);
+        REQUIRE(streamed[i].open == mapped[i].open);
+        REQUIRE(streamed[i].high == mapped[i].high);
+        REQUIRE(streamed[i].low == mapped[i].low);
+        REQUIRE(streamed[i].close == mapped[i].close);
+        REQUIRE(streamed[i].volume == mapped[i].volume);
+    }
+
+    std::remove(csv.c_str());
+}
@@ -0,0 +1,168 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/Resampler.h"
+#include "../Backtest/Backtester.h"
+#include "../Backtest/CandleCache.h"
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+
+using Backtest::CandleData;
+using Backtest::CandleSeries;
+using Backtest::MultiTimeframeSeries;
+using Backtest::Resampler;
+using Backtest::Timeframe;
+
+namespace {
+    // One-minute bars over a few days, starting mid-hour, with a weekend-style gap
+    std::shared_ptr<CandleSeries> makeMinuteBars(std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::normal_distribution<double> step(0.0, 0.0003);
+        std::uniform_real_distribution<double> wick(0.0, 0.0004);
+        std::uniform_real_distribution<double> volume(1.0, 100.0);
+
+        auto series = std::make_shared<CandleSeries>();
+        std::int64_t time = 1700000000 + 37 * 60;  // Not aligned to any bar
+        double price = 1.1000;
+        for (int i = 0; i < 3 * 1440; ++i) {
+            if (i == 1500) {
+                time += 2 * 86400 + 13 * 60;  // Gap
+            }
+            CandleData candle;
+            candle.timestamp = static_cast<std::time_t>(time);
+            candle.open = price;
+            price += step(rng);
+            candle.close = price;
+            candle.high = std::max(candle.open, candle.close) + wick(rng);
+            candle.low = std::min(candle.open, candle.close) - wick(rng);
+            candle.volume = volume(rng);
+            series->push_back(candle);
+            time += 60;
+        }
+        return series;
+    }
+
+    // Reference: group base bars by bucket with a map
+    std::vector<CandleData> naiveResample(const CandleSeries& base, Timeframe timeframe) {
+        std::map<std::int64_t, CandleData> buckets;
+        for (std::size_t i = 0; i < base.size(); ++i) {
+            CandleData candle = base[i];
+            std::int64_t start = Resampler::bucketStart(candle.timestamp, timeframe);
+            auto it = buckets.find(start);
+            if (it == buckets.end()) {
+                candle.timestamp = static_cast<std::time_t>(start);
+                buckets.emplace(start, candle);
+            } else {
+                it->second.high = std::max(it->second.high, candle.high);
+                it->second.low = std::min(it->second.low, candle.low);
+                it->second.close = candle.close;
+                it->second.volume += candle.volume;
+            }
+        }
+        std::vector<CandleData> bars;
+        for (const auto& entry : buckets) {
+            bars.push_back(entry.second);
+        }
+        return bars;
+    }
+
+    void requireSameBars(const CandleSeries& bars, const std::vector<CandleData>& expected) {
+        REQUIRE(bars.size() == expected.size());
+        for (std::size_t i = 0; i < bars.size(); ++i) {
+            CandleData bar = bars[i];
+            REQUIRE(bar.timestamp == expected[i].timestamp);
+            REQUIRE(bar.open == expected[i].open);
+            REQUIRE(bar.high == expected[i].high);
+            REQUIRE(bar.low == expected[i].low);
+            REQUIRE(bar.close == expected[i].close);
+            REQUIRE(bar.volume == Catch::Approx(expected[i].volume));
+        }
+    }
+}
+
+TEST_CASE("Resampler builds every timeframe in one pass", "[resampler]") {
+    auto base = makeMinuteBars(5);
+    auto series = Resampler::build(base);
+
+    for (Timeframe timeframe : Resampler::standardTimeframes()) {
+        INFO(Resampler::timeframeName(timeframe));
+        REQUIRE(series->has(timeframe));
+        const CandleSeries& bars = series->bars(timeframe);
+        requireSameBars(bars, naiveResample(*base, timeframe));
+
+        for (std::size_t i = 0; i < base->size(); ++i) {
+            std::size_t bar = series->barIndex(timeframe, i);
+            REQUIRE(bars.timestamp()[bar] == Resampler::bucketStart(base->timestamp()[i], timeframe));
+
+            // A closed bar never reaches past the current base bar
+            std::size_t closed = series->closedBarIndex(timeframe, i);
+            if (closed == MultiTimeframeSeries::NO_BAR) {
+                REQUIRE(bar == 0);
+            } else {
+                REQUIRE(closed <= bar);
+                REQUIRE((closed == bar) == (i + 1 == base->size() || series->barIndex(timeframe, i + 1) != bar));
+            }
+        }
+    }
+
+    CHECK(series->bars(Timeframe::H1).size() < series->bars(Timeframe::M15).size());
+    CHECK_THROWS_AS(Resampler::build(base, {Timeframe::H1})->bars(Timeframe::D1), std::out_of_range);
+}
+
+TEST_CASE("Resampled timeframes are cached next to the CSV", "[resampler]") {
+    auto base = makeMinuteBars(9);
+    auto path = std::filesystem::temp_directory_path() / "resampler_cache_test.csv";
+    std::string csv = path.string();
+    {
+        std::ofstream file(csv);
+        file << "Date,Open,High,Low,Close,Volume\n";
+        for (std::size_t i = 0; i < base->size(); ++i) {
+            CandleData candle = (*base)[i];
+            std::time_t time = candle.timestamp;
+            char stamp[32];
+            std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", std::gmtime(&time));
+            file.precision(17);
+            file << stamp << "," << candle.open << "," << candle.high << "," << candle.low << ","
+                 << candle.close << "," << candle.volume << "\n";
+        }
+    }
+
+    const std::vector<Timeframe> timeframes = {Timeframe::M15, Timeframe::H4};
+    auto cleanup = [&]() {
+        std::remove(csv.c_str());
+        std::remove(Backtest::CandleCache::cachePathFor(csv).c_str());
+        for (Timeframe timeframe : timeframes) {
+            std::remove(Backtest::CandleCache::cachePathFor(csv, Resampler::timeframeName(timeframe)).c_str());
+        }
+    };
+
+    Backtest::Backtester first;
+    first.setTimeframes(timeframes);
+    REQUIRE(first.loadPriceData(csv));
+    REQUIRE(first.getTimeframes());
+    for (Timeframe timeframe : timeframes) {
+        CHECK(std::filesystem::exists(Backtest::CandleCache::cachePathFor(csv, Resampler::timeframeName(timeframe))));
+    }
+
+    Backtest::Backtester second;
+    second.setTimeframes(timeframes);
+    REQUIRE(second.loadPriceData(csv));
+    REQUIRE(second.getLoaderStats().fromCache);
+
+    auto built = Resampler::build(second.getPriceData(), timeframes);
+    for (Timeframe timeframe : timeframes) {
+        const CandleSeries& cached = second.getTimeframes()->bars(timeframe);
+        std::vector<CandleData> expected;
+        for (std::size_t i = 0; i < built->bars(timeframe).size(); ++i) {
+            expected.push_back(built->bars(timeframe)[i]);
+        }
+        requireSameBars(cached, expected);
+        for (std::size_t i = 0; i < second.getPriceData()->size(); ++i) {
+            REQUIRE(second.getTimeframes()->barIndex(timeframe, i) == built->barIndex(timeframe, i));
+        }
+    }
+
+    cleanup();
+}
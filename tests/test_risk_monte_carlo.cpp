@@ -0,0 +1,222 @@
+#include <catch2/catch_all.hpp>
+#include "../Risk/RiskCurveGenerator.h"
+#include "../Risk/PathKernel.h"
+#include "../Utils/Philox.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using Risk::MonteCarloParams;
+using Risk::MonteCarloResult;
+using Risk::PathKernel;
+using Risk::PathKernelOutput;
+using Risk::PathKernelParams;
+using Risk::RiskCurveGenerator;
+using Risk::RiskSimulationParams;
+
+namespace {
+    RiskCurveGenerator makeGenerator(double winRate, int numTrades) {
+        RiskSimulationParams params;
+        params.initialBalance = 10000.0;
+        params.numTrades = numTrades;
+        params.winRate = winRate;
+        params.riskRewardRatio = 2.0;
+        params.maxRiskPerTrade = 2.0;
+
+        RiskCurveGenerator generator;
+        generator.setSimulationParams(params);
+        generator.setRiskProfile(Risk::RiskProfile::createAggressive());
+        return generator;
+    }
+
+    // Every output of PathKernel for a range of paths
+    struct KernelRun {
+        std::vector<double> finalBalance;
+        std::vector<double> maxDrawdown;
+        std::vector<double> maxDrawdownPercent;
+        std::vector<int> maxConsecutiveLosses;
+        std::vector<std::uint8_t> ruined;
+        std::vector<double> balances;
+
+        KernelRun(std::size_t paths, int numTrades)
+            : finalBalance(paths), maxDrawdown(paths), maxDrawdownPercent(paths),
+              maxConsecutiveLosses(paths), ruined(paths),
+              balances(paths * static_cast<std::size_t>(numTrades + 1)) {}
+
+        PathKernelOutput output(std::size_t firstPath) {
+            // Shift the arrays so absolute path numbers index them
+            PathKernelOutput out;
+            out.finalBalance = finalBalance.data() - firstPath;
+            out.maxDrawdown = maxDrawdown.data() - firstPath;
+            out.maxDrawdownPercent = maxDrawdownPercent.data() - firstPath;
+            out.maxConsecutiveLosses = maxConsecutiveLosses.data() - firstPath;
+            out.ruined = ruined.data() - firstPath;
+            out.balances = balances.data() - firstPath;
+            out.balanceStride = finalBalance.size();
+            return out;
+        }
+
+        bool operator==(const KernelRun& other) const {
+            return finalBalance == other.finalBalance && maxDrawdown == other.maxDrawdown &&
+                   maxDrawdownPercent == other.maxDrawdownPercent &&
+                   maxConsecutiveLosses == other.maxConsecutiveLosses &&
+                   ruined == other.ruined && balances == other.balances;
+        }
+    };
+}
+
+TEST_CASE("Philox4x32-10 matches the reference known-answer vectors", "[risk][rng]") {
+    using Utils::Philox4x32;
+    REQUIRE(Philox4x32::generate({0, 0, 0, 0}, {0, 0}) ==
+            Philox4x32::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+    REQUIRE(Philox4x32::generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}) ==
+            Philox4x32::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+    REQUIRE(Philox4x32::generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}) ==
+            Philox4x32::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1});
+}
+
+TEST_CASE("Monte Carlo results do not depend on the thread count", "[risk][montecarlo]") {
+    RiskCurveGenerator generator = makeGenerator(0.45, 120);
+
+    MonteCarloParams mc;
+    mc.numPaths = 20000;
+    mc.seed = 42;
+
+    mc.threadCount = 1;
+    MonteCarloResult single = generator.runMonteCarlo(mc);
+    mc.threadCount = 4;
+    MonteCarloResult parallel = generator.runMonteCarlo(mc);
+
+    REQUIRE(single.balanceP5 == parallel.balanceP5);
+    REQUIRE(single.balanceP50 == parallel.balanceP50);
+    REQUIRE(single.balanceP95 == parallel.balanceP95);
+    REQUIRE(single.maxDrawdownPercents == parallel.maxDrawdownPercents);
+    REQUIRE(single.ruinProbability == parallel.ruinProbability);
+    REQUIRE(single.meanFinalBalance == parallel.meanFinalBalance);
+
+    mc.seed = 43;
+    MonteCarloResult otherSeed = generator.runMonteCarlo(mc);
+    REQUIRE(otherSeed.balanceP50 != single.balanceP50);
+}
+
+TEST_CASE("Monte Carlo bands, drawdowns and ruin are consistent", "[risk][montecarlo]") {
+    MonteCarloParams mc;
+    mc.numPaths = 5000;
+    mc.threadCount = 2;
+
+    SECTION("Bands are ordered and start at the initial balance") {
+        MonteCarloResult result = makeGenerator(0.5, 80).runMonteCarlo(mc);
+        REQUIRE(result.numPaths == 5000);
+        REQUIRE(result.balanceP50.size() == 81);
+        REQUIRE(result.balanceP5.front() == 10000.0);
+        REQUIRE(result.balanceP95.front() == 10000.0);
+        for (std::size_t i = 0; i < result.balanceP50.size(); ++i) {
+            REQUIRE(result.balanceP5[i] <= result.balanceP25[i]);
+            REQUIRE(result.balanceP25[i] <= result.balanceP50[i]);
+            REQUIRE(result.balanceP50[i] <= result.balanceP75[i]);
+            REQUIRE(result.balanceP75[i] <= result.balanceP95[i]);
+        }
+        REQUIRE(std::is_sorted(result.maxDrawdownPercents.begin(), result.maxDrawdownPercents.end()));
+        REQUIRE(result.maxDrawdownPercentile(0.0) <= result.maxDrawdownPercentile(95.0));
+    }
+
+    SECTION("Always winning never draws down or ruins") {
+        MonteCarloResult result = makeGenerator(1.0, 50).runMonteCarlo(mc);
+        REQUIRE(result.ruinProbability == 0.0);
+        REQUIRE(result.maxDrawdownPercentile(100.0) == 0.0);
+        REQUIRE(result.balanceP5.back() == result.balanceP95.back());
+    }
+
+    SECTION("Always losing at 2% ruins at the 50% level within 50 trades") {
+        MonteCarloResult result = makeGenerator(0.0, 50).runMonteCarlo(mc);
+        // 0.98^35 < 0.5
+        REQUIRE(result.ruinProbability == 1.0);
+        REQUIRE(result.maxDrawdownPercentile(0.0) > 50.0);
+    }
+}
+
+TEST_CASE("PathKernel AVX2 and scalar kernels agree bit for bit", "[risk][kernel]") {
+    if (!PathKernel::usesAvx2()) {
+        SUCCEED("AVX2 not available");
+        return;
+    }
+
+    PathKernelParams params;
+    params.numTrades = 37;  // Not a multiple of the 4 words per Philox block
+    params.winRate = 0.4;
+    params.riskPercent = 3.0;
+    params.ruinBalance = 7000.0;
+    params.seed = 99;
+
+    // Unaligned start and a count with a scalar tail; the second range
+    // crosses 2^32 so the stream number carries into the high counter word
+    const std::size_t starts[] = {5, (std::size_t(1) << 32) - 4};
+    for (std::size_t first : starts) {
+        const std::size_t count = 1003;
+        KernelRun scalar(count, params.numTrades);
+        KernelRun avx2(count, params.numTrades);
+        PathKernel::runScalar(params, first, count, scalar.output(first));
+        PathKernel::runAvx2(params, first, count, avx2.output(first));
+        REQUIRE(scalar == avx2);
+    }
+}
+
+TEST_CASE("PathKernel tracks drawdown, streaks and ruin", "[risk][kernel]") {
+    PathKernelParams params;
+    params.numTrades = 10;
+    params.riskPercent = 10.0;
+    params.ruinBalance = 5000.0;
+
+    SECTION("Always losing") {
+        params.winRate = 0.0;
+        KernelRun run(16, params.numTrades);
+        PathKernel::run(params, 0, 16, run.output(0));
+        for (std::size_t i = 0; i < 16; ++i) {
+            CHECK(run.finalBalance[i] == Catch::Approx(10000.0 * std::pow(0.9, 10)));
+            CHECK(run.maxConsecutiveLosses[i] == 10);
+            CHECK(run.maxDrawdownPercent[i] == Catch::Approx(100.0 * (1.0 - std::pow(0.9, 10))));
+            CHECK(run.ruined[i] == 1);  // 10000 * 0.9^10 is below the 5000 ruin level
+        }
+    }
+
+    SECTION("Always winning") {
+        params.winRate = 1.0;
+        KernelRun run(16, params.numTrades);
+        PathKernel::run(params, 0, 16, run.output(0));
+        for (std::size_t i = 0; i < 16; ++i) {
+            CHECK(run.maxConsecutiveLosses[i] == 0);
+            CHECK(run.maxDrawdown[i] == 0.0);
+            CHECK(run.ruined[i] == 0);
+        }
+    }
+}
+
+TEST_CASE("Risk path throughput on one core", "[risk][kernel][!benchmark]") {
+    RiskCurveGenerator generator = makeGenerator(0.5, 100);
+
+    PathKernelParams params;
+    params.numTrades = 100;
+    params.riskPercent = 2.0;
+    KernelRun run(1024, params.numTrades);
+    PathKernelOutput output = run.output(0);
+    output.balances = nullptr;
+
+    BENCHMARK("generateCurve x 1024 paths") {
+        double total = 0.0;
+        for (int i = 0; i < 1024; ++i) {
+            total += generator.generateCurve().finalBalance;
+        }
+        return total;
+    };
+
+    BENCHMARK("PathKernel::runScalar x 1024 paths") {
+        PathKernel::runScalar(params, 0, 1024, output);
+        return run.finalBalance[0];
+    };
+
+    BENCHMARK("PathKernel::run x 1024 paths") {
+        PathKernel::run(params, 0, 1024, output);
+        return run.finalBalance[0];
+    };
+}
@@ -0,0 +1,272 @@
+#include <catch2/catch_all.hpp>
+#include "../SessionManager.h"
+#include "../SessionWal.h"
+#include "../TradeCalculator.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+    // Forex trade at the session balance with its own SL/TP distances
+    std::shared_ptr<Trade> makeTrade(SessionManager& session, double stopLossPips, double takeProfitPips) {
+        auto trade = session.createTrade();
+        trade->setRiskPercentage(1.0);
+        trade->setEntryPrice(1.1000);
+        trade->setStopLoss(stopLossPips, InputType::Pips);
+        trade->setTakeProfit(takeProfitPips, InputType::Pips);
+        trade->calculateWithMultipleTargets();
+        return trade;
+    }
+
+    // Statistics recomputed from scratch over the session's trades
+    SessionStats recompute(const SessionManager& session) {
+        SessionStats stats;
+        double totalWins = 0.0;
+        double totalLosses = 0.0;
+        double totalRR = 0.0;
+        for (const auto& trade : session.getTradesView()) {
+            if (trade->getOutcome() == TradeOutcome::Pending) {
+                continue;
+            }
+            double pnl = trade->getUpdatedAccountBalance() - trade->getParameters().accountBalance;
+            if (pnl > 0) {
+                stats.winningTrades++;
+                totalWins += pnl;
+                stats.largestWin = std::max(stats.largestWin, pnl);
+            } else if (pnl < 0) {
+                stats.losingTrades++;
+                totalLosses -= pnl;
+                stats.largestLoss = std::min(stats.largestLoss, pnl);
+            } else {
+                stats.breakEvenTrades++;
+            }
+            totalRR += trade->getResultsRef().riskRewardRatio;
+        }
+        int completed = stats.winningTrades + stats.losingTrades + stats.breakEvenTrades;
+        if (completed > 0) {
+            stats.winRate = static_cast<double>(stats.winningTrades) / completed;
+            stats.averageRR = totalRR / completed;
+        }
+        if (totalLosses > 0) {
+            stats.profitFactor = totalWins / totalLosses;
+        }
+        return stats;
+    }
+
+    void requireStatsMatch(const SessionManager& session) {
+        REQUIRE(session.checkStatsConsistency());
+
+        SessionStats running = session.getSessionStats();
+        SessionStats expected = recompute(session);
+        CHECK(running.totalTrades == static_cast<int>(session.getTradesView().size()));
+        CHECK(running.winningTrades == expected.winningTrades);
+        CHECK(running.losingTrades == expected.losingTrades);
+        CHECK(running.breakEvenTrades == expected.breakEvenTrades);
+        CHECK(running.largestWin == expected.largestWin);
+        CHECK(running.largestLoss == expected.largestLoss);
+        CHECK(running.winRate == Catch::Approx(expected.winRate));
+        CHECK(running.averageRR == Catch::Approx(expected.averageRR));
+        CHECK(running.profitFactor == Catch::Approx(expected.profitFactor));
+    }
+}
+
+TEST_CASE("Session statistics follow outcome changes", "[session][stats]") {
+    SessionManager session;
+    session.startNewSession(10000.0);
+
+    auto bigWin = makeTrade(session, 20.0, 60.0);
+    auto smallWin = makeTrade(session, 20.0, 30.0);
+    auto bigLoss = makeTrade(session, 30.0, 40.0);
+    auto smallLoss = makeTrade(session, 10.0, 40.0);
+    auto pending = makeTrade(session, 20.0, 50.0);
+
+    session.simulateTrade(bigWin, TradeOutcome::WinAtTP1);
+    session.simulateTrade(smallWin, TradeOutcome::WinAtTP1);
+    session.simulateTrade(bigLoss, TradeOutcome::LossAtSL);
+    session.simulateTrade(smallLoss, TradeOutcome::LossAtSL);
+    for (const auto& trade : {bigWin, smallWin, bigLoss, smallLoss, pending}) {
+        REQUIRE(session.addTrade(trade));
+    }
+    requireStatsMatch(session);
+
+    SessionStats stats = session.getSessionStats();
+    REQUIRE(stats.largestWin > 0.0);
+    REQUIRE(stats.largestLoss < 0.0);
+    CHECK(stats.largestWin == bigWin->getUpdatedAccountBalance() - bigWin->getParameters().accountBalance);
+    CHECK(stats.largestLoss == bigLoss->getUpdatedAccountBalance() - bigLoss->getParameters().accountBalance);
+
+    SECTION("Resolving a pending trade") {
+        session.simulateTrade(pending, TradeOutcome::WinAtTP2);
+        requireStatsMatch(session);
+        CHECK(session.getSessionStats().winningTrades == 3);
+    }
+
+    SECTION("Changing a completed trade") {
+        session.simulateTrade(smallWin, TradeOutcome::BreakEven);
+        requireStatsMatch(session);
+        CHECK(session.getSessionStats().breakEvenTrades == 1);
+        CHECK(session.getSessionStats().winningTrades == 1);
+    }
+
+    SECTION("Removing the largest win and the largest loss") {
+        session.simulateTrade(bigWin, TradeOutcome::LossAtSL);
+        requireStatsMatch(session);
+        CHECK(session.getSessionStats().largestWin ==
+              smallWin->getUpdatedAccountBalance() - smallWin->getParameters().accountBalance);
+
+        session.simulateTrade(bigLoss, TradeOutcome::WinAtTP1);
+        requireStatsMatch(session);
+        // bigWin's 20-pip stop is now the widest losing stop
+        CHECK(session.getSessionStats().largestLoss ==
+              bigWin->getUpdatedAccountBalance() - bigWin->getParameters().accountBalance);
+    }
+
+    SECTION("Resolving every trade to break-even empties the running totals") {
+        for (const auto& trade : {bigWin, smallWin, bigLoss, smallLoss, pending}) {
+            session.simulateTrade(trade, TradeOutcome::BreakEven);
+        }
+        requireStatsMatch(session);
+        CHECK(session.getSessionStats().largestWin == 0.0);
+        CHECK(session.getSessionStats().largestLoss == 0.0);
+        CHECK(session.getSessionStats().profitFactor == 0.0);
+    }
+}
+
+TEST_CASE("A trade added twice counts in both slots", "[session][stats]") {
+    SessionManager session;
+    session.startNewSession(10000.0);
+
+    auto trade = makeTrade(session, 20.0, 40.0);
+    session.simulateTrade(trade, TradeOutcome::LossAtSL);
+    REQUIRE(session.addTrade(trade));
+    REQUIRE(session.addTrade(trade));
+    REQUIRE(session.getTradesView().size() == 2);
+    requireStatsMatch(session);
+    CHECK(session.getSessionStats().losingTrades == 2);
+
+    // Both slots take the new outcome
+    session.simulateTrade(trade, TradeOutcome::WinAtTP1);
+    requireStatsMatch(session);
+    CHECK(session.getSessionStats().winningTrades == 2);
+    CHECK(session.getSessionStats().losingTrades == 0);
+}
+
+TEST_CASE("Re-simulating a trade replaces its outcome", "[session][stats]") {
+    SessionManager session;
+    session.startNewSession(10000.0);
+
+    auto trade = makeTrade(session, 20.0, 40.0);
+    double opening = trade->getParameters().accountBalance;
+    trade->simulateOutcome(TradeOutcome::LossAtSL);
+    double afterLoss = trade->getUpdatedAccountBalance();
+    trade->simulateOutcome(TradeOutcome::LossAtSL);
+    CHECK(trade->getUpdatedAccountBalance() == afterLoss);
+    CHECK(trade->getParameters().accountBalance == opening);
+    CHECK(afterLoss == Catch::Approx(opening - trade->getResultsRef().riskAmount));
+}
+
+TEST_CASE("Trades are found by ID after many adds", "[session][index]") {
+    SessionManager session;
+    session.startNewSession(10000.0);
+
+    std::vector<std::shared_ptr<Trade>> added;
+    for (int i = 0; i < 500; ++i) {
+        added.push_back(makeTrade(session, 20.0, 40.0));
+        REQUIRE(session.addTrade(added.back()));
+    }
+    REQUIRE(session.getTradesView().size() == added.size());
+    for (std::size_t i = 0; i < added.size(); ++i) {
+        REQUIRE(session.getTradesView()[i] == added[i]);
+        REQUIRE(session.getTrade(added[i]->getId()) == added[i]);
+    }
+    CHECK(session.getTrade("no-such-trade") == nullptr);
+}
+
+TEST_CASE("A reset trade is found under its new ID only", "[session][index]") {
+    SessionManager session;
+    session.startNewSession(10000.0);
+    auto kept = makeTrade(session, 20.0, 40.0);
+    auto reset = makeTrade(session, 20.0, 40.0);
+    REQUIRE(session.addTrade(kept));
+    REQUIRE(session.addTrade(reset));
+
+    // Another session holding the same trade keeps its own index current
+    SessionManager other;
+    other.startNewSession(10000.0);
+    REQUIRE(other.addTrade(reset));
+
+    std::string oldId = reset->getId();
+    reset->reset();
+    REQUIRE(reset->getId() != oldId);
+    CHECK(session.getTrade(reset->getId()) == reset);
+    CHECK(session.getTrade(oldId) == nullptr);
+    CHECK(session.getTrade(kept->getId()) == kept);
+    CHECK(other.getTrade(reset->getId()) == reset);
+
+    // A trade dropped by a new session no longer reports to it
+    other.startNewSession(10000.0);
+    reset->reset();
+    CHECK(session.getTrade(reset->getId()) == reset);
+    CHECK(other.getTrade(reset->getId()) == nullptr);
+}
+
+TEST_CASE("A repeated trade ID resolves to the first trade", "[session][index]") {
+    SessionManager session;
+    session.startNewSession(10000.0);
+
+    TradeRecord record = makeTrade(session, 20.0, 40.0)->toRecord();
+    auto first = Trade::fromRecord(record);
+    record.accountBalance = 5000.0;
+    auto second = Trade::fromRecord(record);
+    REQUIRE(first->getId() == second->getId());
+
+    REQUIRE(session.addTrade(first));
+    REQUIRE(session.addTrade(second));
+    CHECK(session.getTrade(first->getId()) == first);
+    CHECK(session.getTradesView().size() == 2);
+}
+
+TEST_CASE("Starting and recovering a session rebuild the index", "[session][index]") {
+    std::string path = (std::filesystem::temp_directory_path() / "index_recover.csv").string();
+    std::remove(path.c_str());
+    SessionWal::remove(path);
+
+    std::vector<std::string> ids;
+    {
+        SessionManager session;
+        session.setSessionFile(path);
+        session.setAutoSave(true);
+        session.startNewSession(10000.0);
+        for (int i = 0; i < 3; ++i) {
+            auto trade = makeTrade(session, 20.0, 40.0);
+            REQUIRE(session.addTrade(trade));
+            ids.push_back(trade->getId());
+        }
+
+        // A new session forgets the old trades
+        SessionManager fresh;
+        fresh.startNewSession(10000.0);
+        REQUIRE(fresh.addTrade(session.getTrade(ids[0])));
+        fresh.startNewSession(10000.0);
+        CHECK(fresh.getTrade(ids[0]) == nullptr);
+        CHECK(fresh.getTradesView().empty());
+
+        // Leave the log behind as a crashed process would
+        std::filesystem::copy_file(SessionWal(path).getLogPath(), path + ".crashed");
+    }
+    std::remove(path.c_str());
+    std::filesystem::rename(path + ".crashed", SessionWal(path).getLogPath());
+
+    SessionManager recovered;
+    REQUIRE(recovered.loadSession(path));
+    REQUIRE(recovered.getTradesView().size() == ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto trade = recovered.getTrade(ids[i]);
+        REQUIRE(trade != nullptr);
+        CHECK(trade == recovered.getTradesView()[i]);
+    }
+
+    recovered.endSession();
+    std::remove(path.c_str());
+    SessionWal::remove(path);
+}
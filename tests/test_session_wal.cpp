@@ -0,0 +1,261 @@
+#include <catch2/catch_all.hpp>
+#include "../SessionWal.h"
+#include "../SessionManager.h"
+#include "../TradeCalculator.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    std::string sessionPath(const std::string& name) {
+        std::string path = (std::filesystem::temp_directory_path() / name).string();
+        std::remove(path.c_str());
+        SessionWal::remove(path);
+        return path;
+    }
+
+    void cleanup(const std::string& path) {
+        std::remove(path.c_str());
+        SessionWal::remove(path);
+    }
+
+    TradeRecord makeRecord(const char* id, double balance, TradeOutcome outcome) {
+        TradeRecord record{};
+        std::strncpy(record.id, id, sizeof(record.id) - 1);
+        record.accountBalance = balance;
+        record.riskPercent = 1.0;
+        record.entryPrice = 1.1;
+        record.outcome = static_cast<std::uint8_t>(outcome);
+        return record;
+    }
+
+    std::string idOf(const TradeRecord& record) {
+        return std::string(record.id, strnlen(record.id, sizeof(record.id)));
+    }
+
+    std::vector<char> readBytes(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+}
+
+TEST_CASE("Session log round-trips adds, updates and compaction", "[session][wal]") {
+    std::string path = sessionPath("wal_roundtrip.csv");
+    {
+        SessionWal wal(path);
+        REQUIRE(wal.startSession("SESSION-1", 10000.0));
+        REQUIRE(wal.appendTrade(makeRecord("A", 10000.0, TradeOutcome::Pending), 10000.0));
+        REQUIRE(wal.appendTrade(makeRecord("B", 10000.0, TradeOutcome::LossAtSL), 9900.0));
+        REQUIRE(wal.appendUpdate(makeRecord("A", 10000.0, TradeOutcome::WinAtTP1), 10100.0));
+
+        SessionSnapshot before;
+        REQUIRE(SessionWal::replay(path, before));
+        REQUIRE(wal.compact(before));
+        CHECK(wal.getLogRecordCount() == 0);
+
+        REQUIRE(wal.appendTrade(makeRecord("C", 10100.0, TradeOutcome::Pending), 10100.0));
+        REQUIRE(wal.appendUpdate(makeRecord("B", 10000.0, TradeOutcome::BreakEven), 10200.0));
+    }
+
+    SessionSnapshot snapshot;
+    REQUIRE(SessionWal::replay(path, snapshot));
+    CHECK(snapshot.sessionId == "SESSION-1");
+    CHECK(snapshot.initialBalance == 10000.0);
+    CHECK(snapshot.currentBalance == 10200.0);
+    REQUIRE(snapshot.trades.size() == 3);
+    CHECK(idOf(snapshot.trades[0]) == "A");
+    CHECK(snapshot.trades[0].outcome == static_cast<std::uint8_t>(TradeOutcome::WinAtTP1));
+    CHECK(idOf(snapshot.trades[1]) == "B");
+    CHECK(snapshot.trades[1].outcome == static_cast<std::uint8_t>(TradeOutcome::BreakEven));
+    CHECK(idOf(snapshot.trades[2]) == "C");
+
+    // An update for a trade that was never added is ignored
+    {
+        SessionWal wal(path);
+        REQUIRE(wal.open());
+        REQUIRE(wal.appendUpdate(makeRecord("Z", 1.0, TradeOutcome::WinAtTP1), 10200.0));
+    }
+    REQUIRE(SessionWal::replay(path, snapshot));
+    CHECK(snapshot.trades.size() == 3);
+
+    cleanup(path);
+}
+
+TEST_CASE("A take profit entered as a price survives the log", "[session][wal]") {
+    Trade trade;
+    trade.setAccountBalance(10000.0);
+    trade.setRiskPercentage(1.0);
+    trade.setEntryPrice(1.1000);
+    trade.setStopLoss(20.0, InputType::Pips);
+    trade.setTakeProfit(1.1050, InputType::Price);
+    trade.calculate();
+
+    auto restored = Trade::fromRecord(trade.toRecord());
+    CHECK(restored->getParameters().takeProfitPrice == 1.1050);
+
+    // Recalculating the replayed trade gives the same target
+    restored->calculate();
+    CHECK(restored->getResults().takeProfitPrice == Catch::Approx(trade.getResults().takeProfitPrice));
+}
+
+TEST_CASE("Replay stops at the last intact log record", "[session][wal]") {
+    std::string path = sessionPath("wal_torn.csv");
+    std::string logPath;
+    {
+        SessionWal wal(path);
+        logPath = wal.getLogPath();
+        REQUIRE(wal.startSession("SESSION-2", 5000.0));
+        REQUIRE(wal.appendTrade(makeRecord("A", 5000.0, TradeOutcome::LossAtSL), 4950.0));
+        REQUIRE(wal.appendTrade(makeRecord("B", 4950.0, TradeOutcome::LossAtSL), 4900.0));
+        REQUIRE(wal.appendTrade(makeRecord("C", 4900.0, TradeOutcome::LossAtSL), 4850.0));
+    }
+    const std::vector<char> intact = readBytes(logPath);
+
+    SECTION("A torn tail is dropped, and open() truncates it before appending") {
+        std::vector<char> torn(intact.begin(), intact.end() - 10);
+        writeBytes(logPath, torn);
+
+        SessionSnapshot snapshot;
+        REQUIRE(SessionWal::replay(path, snapshot));
+        REQUIRE(snapshot.trades.size() == 2);
+        CHECK(idOf(snapshot.trades[1]) == "B");
+        CHECK(snapshot.currentBalance == 4900.0);
+
+        {
+            SessionWal wal(path);
+            REQUIRE(wal.open());
+            CHECK(wal.getLogRecordCount() == 3);  // Start record and two trades
+            REQUIRE(wal.appendTrade(makeRecord("D", 4900.0, TradeOutcome::Pending), 4900.0));
+        }
+        REQUIRE(SessionWal::replay(path, snapshot));
+        REQUIRE(snapshot.trades.size() == 3);
+        CHECK(idOf(snapshot.trades[2]) == "D");
+    }
+
+    SECTION("A corrupt byte ends the replay at the record before it") {
+        // Each trade record is 288 bytes, so 300 bytes from the end is inside trade B
+        std::vector<char> corrupt = intact;
+        corrupt[corrupt.size() - 300] ^= 0x5A;
+        writeBytes(logPath, corrupt);
+
+        SessionSnapshot snapshot;
+        REQUIRE(SessionWal::replay(path, snapshot));
+        REQUIRE(snapshot.trades.size() == 1);
+        CHECK(idOf(snapshot.trades[0]) == "A");
+        CHECK(snapshot.currentBalance == 4950.0);
+    }
+
+    cleanup(path);
+}
+
+TEST_CASE("A crash between snapshot rename and log truncation applies nothing twice", "[session][wal]") {
+    std::string path = sessionPath("wal_crash.csv");
+    std::string logPath;
+    std::vector<char> logBeforeCompaction;
+    {
+        SessionWal wal(path);
+        logPath = wal.getLogPath();
+        REQUIRE(wal.startSession("SESSION-3", 10000.0));
+        REQUIRE(wal.appendTrade(makeRecord("A", 10000.0, TradeOutcome::Pending), 10000.0));
+        REQUIRE(wal.appendTrade(makeRecord("B", 10000.0, TradeOutcome::Pending), 10000.0));
+        REQUIRE(wal.sync());
+        logBeforeCompaction = readBytes(logPath);
+
+        // The session resolved A before compacting; the log still holds A as pending
+        SessionSnapshot snapshot;
+        snapshot.sessionId = "SESSION-3";
+        snapshot.initialBalance = 10000.0;
+        snapshot.currentBalance = 10300.0;
+        snapshot.trades = {makeRecord("A", 10000.0, TradeOutcome::WinAtTP1),
+                           makeRecord("B", 10000.0, TradeOutcome::Pending)};
+        REQUIRE(wal.compact(snapshot));
+    }
+
+    // Put the pre-compaction log back, as if the process died right after the rename
+    writeBytes(logPath, logBeforeCompaction);
+
+    SessionSnapshot recovered;
+    REQUIRE(SessionWal::replay(path, recovered));
+    REQUIRE(recovered.trades.size() == 2);
+    CHECK(recovered.trades[0].outcome == static_cast<std::uint8_t>(TradeOutcome::WinAtTP1));
+    CHECK(recovered.currentBalance == 10300.0);
+
+    // New records continue after the snapshot's sequence number, so they are replayed
+    {
+        SessionWal wal(path);
+        REQUIRE(wal.open());
+        REQUIRE(wal.appendTrade(makeRecord("C", 10300.0, TradeOutcome::Pending), 10300.0));
+    }
+    REQUIRE(SessionWal::replay(path, recovered));
+    REQUIRE(recovered.trades.size() == 3);
+    CHECK(idOf(recovered.trades[2]) == "C");
+    CHECK(recovered.trades[0].outcome == static_cast<std::uint8_t>(TradeOutcome::WinAtTP1));
+
+    cleanup(path);
+}
+
+TEST_CASE("SessionManager recovers from the log only while it is current", "[session][wal]") {
+    std::string path = sessionPath("wal_recover.csv");
+    {
+        // A session that died without ending: only the log is on disk
+        SessionWal wal(path);
+        REQUIRE(wal.startSession("SESSION-4", 8000.0));
+        REQUIRE(wal.appendTrade(makeRecord("A", 8000.0, TradeOutcome::Pending), 8000.0));
+        REQUIRE(wal.appendTrade(makeRecord("B", 8000.0, TradeOutcome::Pending), 8000.0));
+    }
+
+    SECTION("Recovered from the log") {
+        SessionManager session;
+        REQUIRE(session.loadSession(path));
+        CHECK(session.isSessionActive());
+        CHECK(session.getCurrentBalance() == 8000.0);
+        REQUIRE(session.getAllTrades().size() == 2);
+        CHECK(session.getTrade("B") != nullptr);
+        CHECK(session.checkStatsConsistency());
+    }
+
+    SECTION("A CSV saved after the log wins") {
+        {
+            std::ofstream csv(path);
+            csv << "header\n";
+        }
+        auto logTime = std::filesystem::last_write_time(SessionWal(path).getLogPath());
+        std::filesystem::last_write_time(path, logTime + std::chrono::seconds(5));
+        CHECK_FALSE(SessionWal::isCurrent(path));
+
+        SessionManager session;
+        CHECK_FALSE(session.loadSession(path));  // The (empty) CSV was read, not the log
+        CHECK(session.getAllTrades().empty());
+    }
+
+    cleanup(path);
+}
+
+TEST_CASE("Ending an autosaved session writes the CSV and removes the log", "[session][wal]") {
+    std::string path = sessionPath("wal_end.csv");
+    SessionManager session;
+    session.setSessionFile(path);
+    session.setAutoSave(true);
+    session.startNewSession(10000.0);
+
+    auto trade = session.createTrade();
+    trade->setRiskPercentage(1.0);
+    trade->setEntryPrice(1.1);
+    trade->setStopLoss(20.0, InputType::Pips);
+    trade->setTakeProfit(40.0, InputType::Pips);
+    trade->calculate();
+    REQUIRE(session.addTrade(trade));
+    CHECK(SessionWal::exists(path));
+
+    session.endSession();
+    CHECK(std::filesystem::exists(path));
+    CHECK_FALSE(SessionWal::exists(path));
+
+    cleanup(path);
+}
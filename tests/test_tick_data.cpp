@@ -0,0 +1,236 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/TickData.h"
+#include "../Backtest/Backtester.h"
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using Backtest::CandleData;
+using Backtest::CandleSeries;
+using Backtest::TickData;
+using Backtest::TickTouch;
+
+namespace {
+    struct Tick {
+        std::int64_t timestampMs;
+        double bid;
+        double ask;
+    };
+
+    std::string formatTime(std::int64_t timestampMs) {
+        std::time_t seconds = static_cast<std::time_t>(timestampMs / 1000);
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", std::gmtime(&seconds));
+        char millis[8];
+        std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>(timestampMs % 1000));
+        return std::string(stamp) + millis;
+    }
+
+    std::string writeTicks(const std::string& name, const std::vector<Tick>& ticks,
+                           const std::vector<std::string>& extraRows = {}) {
+        std::string csv = (std::filesystem::temp_directory_path() / name).string();
+        std::ofstream file(csv);
+        file << "Timestamp,Bid,Ask\n";
+        file.precision(17);
+        for (const auto& tick : ticks) {
+            file << formatTime(tick.timestampMs) << "," << tick.bid << "," << tick.ask << "\n";
+        }
+        for (const auto& row : extraRows) {
+            file << row << "\n";
+        }
+        return csv;
+    }
+
+    void cleanup(const std::string& csv) {
+        std::remove(csv.c_str());
+        std::remove(TickData::binaryPathFor(csv).c_str());
+    }
+
+    // A long entry at the close of bar 1 (SL 1.1000, TP 1.1030 with the default
+    // 10/20 pip config) whose next bar touches both levels
+    std::shared_ptr<CandleSeries> makeAmbiguousBars(std::int64_t start) {
+        auto series = std::make_shared<CandleSeries>();
+        auto add = [&](double open, double high, double low, double close) {
+            CandleData candle;
+            candle.timestamp = static_cast<std::time_t>(start + 60 * static_cast<std::int64_t>(series->size()));
+            candle.open = open;
+            candle.high = high;
+            candle.low = low;
+            candle.close = close;
+            series->push_back(candle);
+        };
+        add(1.1000, 1.1001, 1.0999, 1.1000);
+        add(1.1000, 1.1011, 1.0999, 1.1010);  // Long signal
+        add(1.1010, 1.1035, 1.0995, 1.1010);  // Touches SL and TP
+        for (int i = 0; i < 8; ++i) {
+            add(1.1010, 1.1011, 1.1009, 1.1010);
+        }
+        return series;
+    }
+}
+
+TEST_CASE("Tick CSVs are streamed into a mapped binary file", "[ticks]") {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> gap(0, 900);
+    std::normal_distribution<double> step(0.0, 0.00005);
+
+    std::vector<Tick> ticks;
+    std::int64_t time = 1700000000000LL + 123;
+    double bid = 1.1000;
+    for (int i = 0; i < 1000; ++i) {
+        time += gap(rng);  // Zero gaps give equal timestamps, which are kept
+        bid += step(rng);
+        ticks.push_back({time, bid, bid + 0.00012});
+    }
+    std::string csv = writeTicks("tick_data_test.csv", ticks,
+                                 {"not a tick", formatTime(ticks.front().timestampMs) + ",1.1,1.1001", ""});
+
+    Backtest::LoaderStats stats;
+    REQUIRE(TickData::convert(csv, Backtest::LoaderMode::MemoryMapped, stats, 7));  // Chunks that do not divide the row count
+    CHECK(stats.rows == ticks.size());
+    CHECK(stats.rejectedRows == 2);  // Malformed and out of order
+
+    TickData data;
+    REQUIRE(data.open(csv, Backtest::LoaderMode::MemoryMapped));
+    CHECK(data.getLoaderStats().fromCache);
+    REQUIRE(data.size() == ticks.size());
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        REQUIRE(data.timestamp()[i] == ticks[i].timestampMs);
+        REQUIRE(data.bid()[i] == ticks[i].bid);
+        REQUIRE(data.ask()[i] == ticks[i].ask);
+    }
+
+    CHECK(data.lowerBound(0) == 0);
+    CHECK(data.lowerBound(ticks[500].timestampMs) <= 500);
+    CHECK(data.timestamp()[data.lowerBound(ticks[500].timestampMs)] == ticks[500].timestampMs);
+    CHECK(data.lowerBound(ticks.back().timestampMs + 1) == ticks.size());
+
+    // A changed CSV is converted again instead of served stale
+    ticks.resize(10);
+    writeTicks("tick_data_test.csv", ticks);
+    TickData changed;
+    REQUIRE(changed.open(csv, Backtest::LoaderMode::MemoryMapped));
+    CHECK_FALSE(changed.getLoaderStats().fromCache);
+    CHECK(changed.size() == 10);
+
+    cleanup(csv);
+}
+
+TEST_CASE("Ticks replay the order of an ambiguous bar", "[ticks]") {
+    TickData data;
+    std::string csv = writeTicks("tick_touch_test.csv", {
+        {1000, 1.1010, 1.1011},
+        {2000, 1.1031, 1.1032},
+        {3000, 1.0995, 1.0996},
+    });
+    REQUIRE(data.open(csv, Backtest::LoaderMode::MemoryMapped));
+
+    CHECK(data.firstTouch(0, 4000, true, 1.1000, 1.1030) == TickTouch::TakeProfit);
+    CHECK(data.firstTouch(2500, 4000, true, 1.1000, 1.1030) == TickTouch::StopLoss);
+    CHECK(data.firstTouch(0, 2000, true, 1.1000, 1.1030) == TickTouch::None);
+    // Shorts use the ask: 1.1032 reaches a 1.1032 stop before 1.0996 reaches the target
+    CHECK(data.firstTouch(0, 4000, false, 1.1032, 1.0996) == TickTouch::StopLoss);
+    CHECK(data.firstTouch(0, 4000, false, 1.1040, 1.0996) == TickTouch::TakeProfit);
+
+    cleanup(csv);
+}
+
+TEST_CASE("Backtester settles bars touching SL and TP from ticks", "[ticks][backtest]") {
+    const std::int64_t start = 1700000040;
+    const std::int64_t exitBar = (start + 120) * 1000;
+
+    // The bars are built in UTC, as the memory-mapped loader reads them
+    Backtest::Backtester backtester;
+    backtester.setLoaderMode(Backtest::LoaderMode::MemoryMapped);
+    backtester.setPriceData(makeAmbiguousBars(start));
+
+    // Bars alone assume the stop came first
+    Backtest::BacktestResult barsOnly = backtester.runBacktest();
+    REQUIRE(barsOnly.totalTrades == 1);
+    CHECK(barsOnly.trades[0].outcome == TradeOutcome::LossAtSL);
+    CHECK(barsOnly.tickResolvedExits == 0);
+
+    // The stop-level tick before the exit bar belongs to the entry bar and is ignored
+    std::string targetFirst = writeTicks("tick_target_first.csv", {
+        {exitBar - 30000, 1.0990, 1.0991},
+        {exitBar, 1.1010, 1.1011},
+        {exitBar + 10250, 1.1031, 1.1032},
+        {exitBar + 30500, 1.0995, 1.0996},
+    });
+    REQUIRE(backtester.loadTickData(targetFirst));
+    Backtest::BacktestResult withTicks = backtester.runBacktest();
+    REQUIRE(withTicks.totalTrades == 1);
+    CHECK(withTicks.trades[0].outcome == TradeOutcome::WinAtTP1);
+    CHECK(withTicks.trades[0].exitIndex == 2);
+    CHECK(withTicks.tickResolvedExits == 1);
+    CHECK(withTicks.trades[0].pnl > 0.0);
+
+    // Backtesters sharing the data share its ticks
+    Backtest::Backtester shared;
+    shared.sharePriceData(backtester);
+    CHECK(shared.runBacktest().trades[0].outcome == TradeOutcome::WinAtTP1);
+
+    std::string stopFirst = writeTicks("tick_stop_first.csv", {
+        {exitBar + 10250, 1.0995, 1.0996},
+        {exitBar + 30500, 1.1031, 1.1032},
+    });
+    REQUIRE(backtester.loadTickData(stopFirst));
+    Backtest::BacktestResult stopResult = backtester.runBacktest();
+    CHECK(stopResult.trades[0].outcome == TradeOutcome::LossAtSL);
+    CHECK(stopResult.tickResolvedExits == 1);
+
+    // No ticks inside the bar: keep the bar rule
+    std::string outside = writeTicks("tick_outside.csv", {{exitBar + 120000, 1.1031, 1.1032}});
+    REQUIRE(backtester.loadTickData(outside));
+    Backtest::BacktestResult outsideResult = backtester.runBacktest();
+    CHECK(outsideResult.trades[0].outcome == TradeOutcome::LossAtSL);
+    CHECK(outsideResult.tickResolvedExits == 0);
+
+    CHECK_FALSE(backtester.loadTickData("missing_ticks.csv"));
+
+    cleanup(targetFirst);
+    cleanup(stopFirst);
+    cleanup(outside);
+}
+
+TEST_CASE("Ticks are read in the candle loader's time base", "[ticks]") {
+    // Winter and summer rows, so a DST offset would show up on hosts that have one
+    std::string candles = (std::filesystem::temp_directory_path() / "tick_time_base_candles.csv").string();
+    {
+        std::ofstream file(candles);
+        file << "Date,Open,High,Low,Close,Volume\n";
+        file << "2023-01-16 09:30:00,1.1,1.1,1.1,1.1,1\n";
+        file << "2023-07-17 14:00:00,1.2,1.2,1.2,1.2,1\n";
+    }
+    std::string csv = (std::filesystem::temp_directory_path() / "tick_time_base.csv").string();
+    {
+        std::ofstream file(csv);
+        file << "Timestamp,Bid,Ask\n";
+        file << "2023-01-16 09:30:00.250,1.1,1.1001\n";
+        file << "2023-07-17 14:00:00,1.2,1.2001\n";
+    }
+
+    for (auto mode : {Backtest::LoaderMode::Stream, Backtest::LoaderMode::MemoryMapped}) {
+        Backtest::Backtester backtester;
+        backtester.setUseCandleCache(false);
+        backtester.setLoaderMode(mode);
+        REQUIRE(backtester.loadPriceData(candles));
+        REQUIRE(backtester.loadTickData(csv));
+
+        const CandleSeries& series = *backtester.getPriceData();
+        const TickData& ticks = *backtester.getTickData();
+        REQUIRE(ticks.size() == 2);
+        CHECK(ticks.timestamp()[0] == series.timestamp()[0] * 1000 + 250);
+        CHECK(ticks.timestamp()[1] == series.timestamp()[1] * 1000);
+    }
+
+    // Switching modes converts the binary file again
+    TickData reopened;
+    REQUIRE(reopened.open(csv, Backtest::LoaderMode::Stream));
+    CHECK_FALSE(reopened.getLoaderStats().fromCache);
+
+    std::remove(candles.c_str());
+    cleanup(csv);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_all.hpp>
+#include "../TradeCalculator.h"
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+    // Random orders around 1.1000 with stops and targets of 5-80 pips
+    struct OrderColumns {
+        std::vector<double> entry;
+        std::vector<double> stopLoss;
+        std::vector<double> takeProfitPips;
+        std::vector<double> takeProfit;
+    };
+
+    OrderColumns makeOrders(std::size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> price(1.05, 1.15);
+        std::uniform_int_distribution<int> pips(5, 80);
+
+        OrderColumns orders;
+        for (std::size_t i = 0; i < count; ++i) {
+            double entry = price(rng);
+            double tpPips = pips(rng);
+            orders.entry.push_back(entry);
+            orders.stopLoss.push_back(entry - pips(rng) * 0.0001);
+            orders.takeProfitPips.push_back(tpPips);
+            // Same expression calculateTrade uses, so both paths see identical prices
+            orders.takeProfit.push_back(entry + (tpPips * 0.0001));
+        }
+        return orders;
+    }
+
+    TradeParameters scalarParameters(const TradeParameters& common, const OrderColumns& orders, std::size_t i) {
+        TradeParameters params = common;
+        params.entryPrice = orders.entry[i];
+        params.stopLossPrice = orders.stopLoss[i];
+        params.isStopLossPriceOverride = true;
+        params.takeProfitInPips = orders.takeProfitPips[i];
+        return params;
+    }
+}
+
+TEST_CASE("calculateBatch matches calculateTrade row by row", "[calculator]") {
+    TradeCalculator calculator;
+    TradeParameters common;
+    common.accountBalance = 25000.0;
+    common.riskPercent = 1.5;
+
+    SECTION("Default settings") {}
+    SECTION("Fees and spread") {
+        calculator.setFeePercentage(0.1);
+        calculator.setFixedSpreadPips(1.2);
+    }
+    SECTION("Gold with a custom contract size") {
+        common.instrumentType = InstrumentType::Gold;
+        common.lotSizeType = LotSizeType::Mini;
+        common.contractSize = 5000.0;
+    }
+
+    OrderColumns orders = makeOrders(1003, 17);
+    BatchResults batch;
+    calculator.calculateBatch(common, orders.entry.data(), orders.stopLoss.data(),
+                              orders.takeProfit.data(), orders.entry.size(), batch);
+
+    REQUIRE(batch.size() == orders.entry.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        TradeResults scalar = calculator.calculateTrade(scalarParameters(common, orders, i));
+        REQUIRE(batch.status[i] == BatchStatus::Ok);
+        REQUIRE(batch.riskAmount[i] == scalar.riskAmount);
+        REQUIRE(batch.rewardAmount[i] == scalar.rewardAmount);
+        REQUIRE(batch.positionSize[i] == scalar.positionSize);
+        REQUIRE(batch.riskRewardRatio[i] == scalar.riskRewardRatio);
+    }
+}
+
+TEST_CASE("calculateBatch reports bad rows instead of throwing", "[calculator]") {
+    TradeCalculator calculator;
+    TradeParameters common;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::vector<double> entry = {1.1000, 1.1000, nan, 1.1000, 1.1000};
+    std::vector<double> stopLoss = {1.0980, 1.1000, 1.0980, inf, 1.0980};
+    std::vector<double> takeProfit = {1.1040, 1.1040, 1.1040, 1.1040, nan};
+
+    BatchResults batch;
+    calculator.calculateBatch(common, entry.data(), stopLoss.data(), takeProfit.data(), entry.size(), batch);
+
+    CHECK(batch.status[0] == BatchStatus::Ok);
+    CHECK(batch.status[1] == BatchStatus::ZeroRisk);
+    CHECK(batch.status[2] == BatchStatus::NonFiniteInput);
+    CHECK(batch.status[3] == BatchStatus::NonFiniteInput);
+    CHECK(batch.status[4] == BatchStatus::NonFiniteInput);
+    CHECK(batch.riskRewardRatio[0] == Catch::Approx(2.0));
+    for (std::size_t i = 1; i < batch.size(); ++i) {
+        CHECK(batch.riskAmount[i] == 0.0);
+        CHECK(batch.positionSize[i] == 0.0);
+        CHECK(batch.riskRewardRatio[i] == 0.0);
+    }
+
+    common.lotSizeType = static_cast<LotSizeType>(42);
+    REQUIRE_NOTHROW(calculator.calculateBatch(common, entry.data(), stopLoss.data(), takeProfit.data(),
+                                              entry.size(), batch));
+    for (BatchStatus status : batch.status) {
+        CHECK(status == BatchStatus::InvalidParameters);
+    }
+}
+
+TEST_CASE("Batch vs scalar position sizing", "[calculator][!benchmark]") {
+    TradeCalculator calculator;
+    TradeParameters common;
+    OrderColumns orders = makeOrders(10000, 5);
+    BatchResults batch;
+
+    BENCHMARK("calculateTrade x 10000") {
+        double total = 0.0;
+        for (std::size_t i = 0; i < orders.entry.size(); ++i) {
+            total += calculator.calculateTrade(scalarParameters(common, orders, i)).positionSize;
+        }
+        return total;
+    };
+
+    BENCHMARK("calculateBatch x 10000") {
+        calculator.calculateBatch(common, orders.entry.data(), orders.stopLoss.data(),
+                                  orders.takeProfit.data(), orders.entry.size(), batch);
+        return batch.positionSize.back();
+    };
+}
@@ -0,0 +1,139 @@
+#include <catch2/catch_all.hpp>
+#include "../Analytics/TradeResampler.h"
+#include "../Analytics/EquityStats.h"
+#include "../Backtest/BacktestTrade.h"
+#include <random>
+
+using Analytics::ResampleMethod;
+using Analytics::ResampleParams;
+using Analytics::ResampleResult;
+using Analytics::ResampleStatistic;
+using Analytics::TradeResampler;
+
+namespace {
+    // Closed trades risking 1% of the balance at 2R, booked like Backtester
+    std::vector<Backtest::BacktestTrade> makeTrades(std::size_t count, double initialBalance, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::bernoulli_distribution win(0.4);
+
+        std::vector<Backtest::BacktestTrade> trades;
+        double balance = initialBalance;
+        for (std::size_t i = 0; i < count; ++i) {
+            Backtest::BacktestTrade trade;
+            trade.balanceBefore = balance;
+            trade.riskAmount = balance * 0.01;
+            trade.rewardAmount = trade.riskAmount * 2.0;
+            trade.riskRewardRatio = 2.0;
+            trade.outcome = win(rng) ? TradeOutcome::WinAtTP1 : TradeOutcome::LossAtSL;
+            trade.pnl = trade.isWin() ? trade.rewardAmount : -trade.riskAmount;
+            trade.balanceAfter = balance + trade.pnl;
+            balance = trade.balanceAfter;
+            trades.push_back(trade);
+        }
+        return trades;
+    }
+
+    void requireSameResult(const ResampleResult& a, const ResampleResult& b) {
+        REQUIRE(a.percentiles.size() == b.percentiles.size());
+        for (std::size_t i = 0; i < a.percentiles.size(); ++i) {
+            CHECK(a.percentiles[i].finalBalance == b.percentiles[i].finalBalance);
+            CHECK(a.percentiles[i].maxDrawdownPercent == b.percentiles[i].maxDrawdownPercent);
+            CHECK(a.percentiles[i].sharpeRatio == b.percentiles[i].sharpeRatio);
+        }
+        CHECK(a.meanFinalBalance == b.meanFinalBalance);
+    }
+}
+
+TEST_CASE("Resampling without skips replays the original trades", "[resample]") {
+    auto trades = makeTrades(300, 10000.0, 1);
+    Analytics::EquityAnalyzer analyzer;
+    Analytics::EquityStats stats = analyzer.calculateStats(trades, 10000.0);
+
+    TradeResampler resampler = TradeResampler::fromTrades(trades, 10000.0);
+    REQUIRE(resampler.getReturns().size() == trades.size());
+
+    ResampleParams params;
+    params.method = ResampleMethod::SkipTrades;
+    params.skipProbability = 0.0;
+    params.numSamples = 50;
+    ResampleResult result = resampler.run(params);
+
+    for (const auto& row : result.percentiles) {
+        CHECK(row.finalBalance == Catch::Approx(stats.finalBalance));
+        CHECK(row.maxDrawdownPercent == Catch::Approx(stats.maxDrawdownPercent));
+        CHECK(row.sharpeRatio == Catch::Approx(stats.sharpeRatio));
+    }
+}
+
+TEST_CASE("Resampling methods", "[resample]") {
+    auto trades = makeTrades(400, 10000.0, 2);
+    TradeResampler resampler = TradeResampler::fromTrades(trades, 10000.0);
+
+    ResampleParams params;
+    params.numSamples = 2000;
+    params.seed = 42;
+
+    SECTION("Shuffling keeps the final balance and spreads drawdowns") {
+        params.method = ResampleMethod::Shuffle;
+        ResampleResult result = resampler.run(params);
+        REQUIRE(result.percentiles.size() == 5);
+        double finalBalance = trades.back().balanceAfter;
+        for (const auto& row : result.percentiles) {
+            CHECK(row.finalBalance == Catch::Approx(finalBalance));
+        }
+        CHECK(result.percentiles.front().maxDrawdownPercent < result.percentiles.back().maxDrawdownPercent);
+    }
+
+    SECTION("Bootstrap and skipping give ordered bands") {
+        for (ResampleMethod method : {ResampleMethod::BlockBootstrap, ResampleMethod::SkipTrades}) {
+            params.method = method;
+            ResampleResult result = resampler.run(params);
+            REQUIRE(result.numSamples == params.numSamples);
+            for (std::size_t i = 1; i < result.percentiles.size(); ++i) {
+                CHECK(result.percentiles[i - 1].finalBalance <= result.percentiles[i].finalBalance);
+                CHECK(result.percentiles[i - 1].sharpeRatio <= result.percentiles[i].sharpeRatio);
+            }
+            CHECK(result.percentiles.front().finalBalance < result.percentiles.back().finalBalance);
+        }
+    }
+
+    SECTION("Same seed, same result on any thread count") {
+        for (ResampleMethod method : {ResampleMethod::Shuffle, ResampleMethod::BlockBootstrap,
+                                      ResampleMethod::SkipTrades}) {
+            params.method = method;
+            params.threadCount = 1;
+            ResampleResult serial = resampler.run(params);
+            params.threadCount = 4;
+            ResampleResult parallel = resampler.run(params);
+            requireSameResult(serial, parallel);
+        }
+    }
+}
+
+TEST_CASE("Resampling reports", "[resample]") {
+    TradeResampler resampler = TradeResampler::fromTrades(makeTrades(50, 10000.0, 3), 10000.0);
+    ResampleParams params;
+    params.numSamples = 100;
+    params.method = ResampleMethod::BlockBootstrap;
+    std::string table = TradeResampler::toMarkdown(resampler.run(params));
+    CHECK(table.find("| Percentile | Final Balance | Max Drawdown (%) | Sharpe Ratio |\n") == 0);
+    CHECK(table.find("| 50th |") != std::string::npos);
+    CHECK(table.find("| Mean |") != std::string::npos);
+
+    // Every shuffled sample has the original final balance and Sharpe ratio
+    params.method = ResampleMethod::Shuffle;
+    std::string shuffled = TradeResampler::toMarkdown(resampler.run(params));
+    CHECK(shuffled.find("| Percentile | Max Drawdown (%) |\n|-----------:|-----------------:|\n") == 0);
+    CHECK(shuffled.find("| Mean |") != std::string::npos);
+    CHECK_FALSE(TradeResampler::statisticVaries(ResampleMethod::Shuffle, ResampleStatistic::FinalBalance));
+    CHECK_FALSE(TradeResampler::statisticVaries(ResampleMethod::Shuffle, ResampleStatistic::SharpeRatio));
+    CHECK(TradeResampler::statisticVaries(ResampleMethod::Shuffle, ResampleStatistic::MaxDrawdownPercent));
+    CHECK(TradeResampler::statisticVaries(ResampleMethod::SkipTrades, ResampleStatistic::FinalBalance));
+
+    ResampleMethod method;
+    CHECK(TradeResampler::parseMethod("bootstrap", method));
+    CHECK(method == ResampleMethod::BlockBootstrap);
+    CHECK_FALSE(TradeResampler::parseMethod("jackknife", method));
+
+    CHECK(TradeResampler(10000.0, {}).run(params).percentiles.empty());
+}
@@ -0,0 +1,125 @@
+#include <catch2/catch_all.hpp>
+#include "../Backtest/WalkForward.h"
+#include "test_helpers.h"
+#include <algorithm>
+
+using Backtest::BacktestResult;
+using Backtest::Backtester;
+using Backtest::BarRange;
+using Backtest::SweepParameter;
+using Backtest::WalkForward;
+using Backtest::WalkForwardMode;
+using Backtest::WalkForwardResult;
+using Backtest::WalkForwardSpec;
+using TestHelpers::makeRandomWalk;
+
+namespace {
+    WalkForwardSpec makeSpec() {
+        WalkForwardSpec spec;
+        spec.sweep.ranges = {
+            {SweepParameter::StopLossPips, 10.0, 30.0, 10.0},
+            {SweepParameter::TakeProfitPips, 10.0, 30.0, 10.0}
+        };
+        spec.inSampleBars = 4000;
+        spec.outOfSampleBars = 1500;
+        return spec;
+    }
+}
+
+TEST_CASE("Walk-forward windows tile the series", "[walkforward]") {
+    WalkForwardSpec spec = makeSpec();
+
+    SECTION("Rolling") {
+        auto windows = WalkForward::makeWindows(9700, spec);
+        REQUIRE(windows.size() == 4);
+        CHECK(windows[0].first.begin == 0);
+        CHECK(windows[0].first.end == 4000);
+        CHECK(windows[1].first.begin == 1500);
+        CHECK(windows[1].first.size() == 4000);
+        for (std::size_t w = 0; w < windows.size(); ++w) {
+            CHECK(windows[w].second.begin == windows[w].first.end);
+            if (w > 0) {
+                CHECK(windows[w].second.begin == windows[w - 1].second.end);
+            }
+        }
+        CHECK(windows.back().second.end == 9700);  // Shorter final slice
+        CHECK(windows.back().second.size() == 1200);
+    }
+
+    SECTION("Anchored") {
+        spec.mode = WalkForwardMode::Anchored;
+        auto windows = WalkForward::makeWindows(10000, spec);
+        REQUIRE(windows.size() == 4);
+        for (const auto& window : windows) {
+            CHECK(window.first.begin == 0);
+            CHECK(window.first.end == window.second.begin);
+        }
+    }
+
+    SECTION("Too short for one window") {
+        CHECK(WalkForward::makeWindows(4000, spec).empty());
+    }
+}
+
+TEST_CASE("Backtester ranges keep trades inside the slice", "[walkforward]") {
+    auto series = makeRandomWalk(12000, 3);
+    Backtester backtester;
+    backtester.setPriceData(series);
+
+    BacktestResult full = backtester.runBacktest();
+    backtester.setRange({0, series->size()});
+    BacktestResult explicitFull = backtester.runBacktest();
+    CHECK(explicitFull.totalTrades == full.totalTrades);
+    CHECK(explicitFull.netProfit == full.netProfit);
+
+    BarRange slice{3000, 7000};
+    backtester.setRange(slice);
+    BacktestResult sliced = backtester.runBacktest();
+    REQUIRE(sliced.totalTrades > 0);
+    CHECK(sliced.totalTrades < full.totalTrades);
+    for (const auto& trade : sliced.trades) {
+        CHECK(trade.entryIndex >= slice.begin);
+        CHECK(trade.exitIndex < slice.end);
+    }
+}
+
+TEST_CASE("Walk-forward stitches out-of-sample results", "[walkforward]") {
+    auto series = makeRandomWalk(16000, 11);
+    WalkForward walkForward;
+    walkForward.setPriceData(series);
+
+    WalkForwardSpec spec = makeSpec();
+    spec.sweep.threadCount = 4;
+    WalkForwardResult result = walkForward.run(spec);
+    REQUIRE(result.windows.size() == 8);
+    REQUIRE(result.totalTrades > 0);
+
+    // Each window's out-of-sample result is the in-sample winner on the next slice
+    double expectedBalance = spec.sweep.base.initialBalance;
+    std::size_t points = 1;
+    for (const auto& window : result.windows) {
+        Backtester backtester;
+        backtester.setPriceData(series);
+        backtester.setRange(window.outOfSample);
+        backtester.setConfig(window.inSampleBest.config);
+        BacktestResult expected = backtester.runBacktest();
+
+        CHECK(window.outOfSampleResult.totalTrades == expected.totalTrades);
+        CHECK(window.outOfSampleResult.netProfit == expected.netProfit);
+        CHECK(window.equityCurve == expected.equityCurve);
+
+        expectedBalance *= expected.equityCurve.back() / expected.equityCurve.front();
+        points += expected.equityCurve.size() - 1;
+    }
+    CHECK(result.equityCurve.size() == points);
+    CHECK(result.finalBalance == Catch::Approx(expectedBalance));
+
+    SECTION("Thread count does not change results") {
+        spec.sweep.threadCount = 1;
+        WalkForwardResult serial = walkForward.run(spec);
+        CHECK(serial.equityCurve == result.equityCurve);
+        for (std::size_t w = 0; w < serial.windows.size(); ++w) {
+            CHECK(serial.windows[w].inSampleBest.index == result.windows[w].inSampleBest.index);
+        }
+    }
+}
@@ -0,0 +1,202 @@
+#include <catch2/catch_all.hpp>
+#include "../Utils/WorkStealingPool.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Utils::CompletionChannel;
+using Utils::WorkStealingPool;
+
+namespace {
+    // Holds a worker inside a task until released
+    struct Gate {
+        std::atomic<bool> entered{false};
+        std::atomic<bool> open{false};
+
+        void block() {
+            entered = true;
+            while (!open) {
+                std::this_thread::yield();
+            }
+        }
+
+        void waitEntered() const {
+            while (!entered) {
+                std::this_thread::yield();
+            }
+        }
+    };
+}
+
+TEST_CASE("submit blocks while the queue is at capacity", "[pool]") {
+    WorkStealingPool pool(1, 2);
+    Gate gate;
+    pool.submit([&gate]() { gate.block(); });
+    gate.waitEntered();
+
+    // The running task no longer counts; two queued ones fill the queue
+    std::atomic<int> ran{0};
+    pool.submit([&ran]() { ++ran; });
+    pool.submit([&ran]() { ++ran; });
+
+    std::atomic<bool> submitted{false};
+    std::thread producer([&]() {
+        pool.submit([&ran]() { ++ran; });
+        submitted = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK_FALSE(submitted);
+
+    gate.open = true;
+    producer.join();
+    CHECK(submitted);
+    pool.waitIdle();
+    CHECK(ran == 3);
+}
+
+TEST_CASE("Workers take their own newest task and steal the oldest", "[pool]") {
+    SECTION("Outside submissions start in order") {
+        WorkStealingPool pool(1);
+        Gate gate;
+        pool.submit([&gate]() { gate.block(); });
+        gate.waitEntered();
+
+        std::vector<int> order;
+        for (int i = 0; i < 4; ++i) {
+            pool.submit([&order, i]() { order.push_back(i); });
+        }
+        gate.open = true;
+        pool.waitIdle();
+        CHECK(order == std::vector<int>{0, 1, 2, 3});
+    }
+
+    SECTION("The owner runs its own submissions newest first") {
+        WorkStealingPool pool(1);
+        std::vector<int> order;
+        pool.submit([&pool, &order]() {
+            for (int i = 0; i < 4; ++i) {
+                pool.submit([&order, i]() { order.push_back(i); });
+            }
+        });
+        pool.waitIdle();
+        CHECK(order == std::vector<int>{3, 2, 1, 0});
+    }
+
+    SECTION("A thief takes the oldest task") {
+        WorkStealingPool pool(2);
+        std::mutex mutex;
+        std::vector<int> order;
+        std::atomic<int> stolen{0};
+        pool.submit([&]() {
+            for (int i = 0; i < 4; ++i) {
+                pool.submit([&, i]() {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    order.push_back(i);
+                    ++stolen;
+                });
+            }
+            // Keep this worker busy so only the other one runs them
+            while (stolen < 4) {
+                std::this_thread::yield();
+            }
+        });
+        pool.waitIdle();
+        CHECK(order == std::vector<int>{0, 1, 2, 3});
+    }
+}
+
+TEST_CASE("parallelFor nests inside itself and inside tasks", "[pool]") {
+    WorkStealingPool pool(3);
+
+    std::vector<std::atomic<int>> hits(64 * 50);
+    pool.parallelFor(64, [&](std::size_t outer) {
+        pool.parallelFor(50, [&](std::size_t inner) {
+            ++hits[outer * 50 + inner];
+        }, 7);
+    });
+    for (const auto& hit : hits) {
+        REQUIRE(hit == 1);
+    }
+
+    // Every worker busy in a task that itself runs a parallelFor
+    std::atomic<std::size_t> total{0};
+    for (int task = 0; task < 6; ++task) {
+        pool.submit([&]() {
+            pool.parallelFor(1000, [&](std::size_t i) { total += i; }, 16);
+        });
+    }
+    pool.waitIdle();
+    CHECK(total == 6u * 999u * 1000u / 2u);
+}
+
+TEST_CASE("Exceptions reach the caller", "[pool]") {
+    WorkStealingPool pool(4);
+
+    SECTION("From parallelFor") {
+        std::atomic<int> calls{0};
+        CHECK_THROWS_AS(pool.parallelFor(10000, [&](std::size_t i) {
+            ++calls;
+            if (i == 37) {
+                throw std::runtime_error("body failed");
+            }
+        }), std::runtime_error);
+        CHECK(calls < 10000);  // Remaining chunks are abandoned
+
+        // The pool is still usable afterwards
+        std::atomic<int> after{0};
+        pool.parallelFor(100, [&](std::size_t) { ++after; });
+        CHECK(after == 100);
+    }
+
+    SECTION("From submitted tasks, reported once") {
+        for (int i = 0; i < 8; ++i) {
+            pool.submit([i]() {
+                if (i % 2 == 1) {
+                    throw std::runtime_error("task " + std::to_string(i));
+                }
+            });
+        }
+        CHECK_THROWS_AS(pool.waitIdle(), std::runtime_error);
+        CHECK_NOTHROW(pool.waitIdle());
+    }
+
+    SECTION("waitIdle from a worker") {
+        std::atomic<bool> rejected{false};
+        pool.submit([&]() {
+            try {
+                pool.waitIdle();
+            } catch (const std::logic_error&) {
+                rejected = true;
+            }
+        });
+        pool.waitIdle();
+        CHECK(rejected);
+    }
+}
+
+TEST_CASE("CompletionChannel hands results over by slot", "[pool]") {
+    WorkStealingPool pool(4);
+    const std::size_t count = 500;
+    CompletionChannel<std::size_t> channel(count);
+    std::atomic<int> lastPublisher{0};
+
+    CHECK(channel.slots() == count);
+    CHECK_FALSE(channel.ready(0));
+
+    pool.parallelFor(count, [&](std::size_t i) {
+        if (channel.publish(i, i * i) == count) {
+            ++lastPublisher;
+        }
+    });
+
+    CHECK(channel.published() == count);
+    CHECK(lastPublisher == 1);  // Exactly one publisher sees the channel complete
+    for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(channel.ready(i));
+        REQUIRE(channel.get(i) == i * i);
+    }
+}